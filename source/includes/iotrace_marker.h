@@ -0,0 +1,37 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_INCLUDES_IOTRACE_MARKER_H
+#define SOURCE_INCLUDES_IOTRACE_MARKER_H
+
+#ifdef __KERNEL__
+#include "iotrace_event.h"
+#else
+#include <octf/trace/iotrace_event.h>
+#endif
+
+/**
+ * Type of marker events, kept clear of event types defined by OCTF
+ */
+#define IOTRACE_EVENT_TYPE_MARKER 64
+
+/** Maximum length of marker text, including terminating NULL */
+#define IOTRACE_MARKER_MAX_LEN 128
+
+/**
+ * @brief User annotation written to the marker procfs file
+ *
+ * Marker shares the sequence of trace events, so it splits the trace
+ * exactly at the point it was written.
+ */
+struct iotrace_event_marker {
+    /** Trace Event Header */
+    struct iotrace_event_hdr hdr;
+
+    /** Null terminated text of the marker */
+    char text[IOTRACE_MARKER_MAX_LEN];
+} __attribute__((packed, aligned(8)));
+
+#endif  // SOURCE_INCLUDES_IOTRACE_MARKER_H
@@ -17,6 +17,8 @@
 
 #define IOTRACE_PROCFS_REMOVE_DEVICE_FILE_NAME "remove_device"
 
+#define IOTRACE_PROCFS_DESCRIBE_DEVICES_FILE_NAME "describe_devices"
+
 #define IOTRACE_PROCFS_TRACE_FILE_PREFIX "trace_ring."
 
 #define IOTRACE_PROCFS_CONSUMER_HDR_FILE_PREFIX "consumer_hdr."
@@ -27,6 +29,8 @@
 
 #define IOTRACE_PROCFS_SIZE_FILE_NAME "size"
 
+#define IOTRACE_PROCFS_MARKER_FILE_NAME "marker"
+
 static const uint64_t iotrace_procfs_max_buffer_size_mb =
         4096; /** 4GiB max for all cpus */
 
@@ -13,6 +13,7 @@
 #include "config.h"
 #include "context.h"
 #include "iotrace_event.h"
+#include "iotrace_marker.h"
 #include "procfs.h"
 #include "procfs_files.h"
 #include "trace.h"
@@ -89,6 +90,57 @@ int iotrace_trace_desc(struct iotrace_context *iotrace,
     return result;
 }
 
+/**
+ * @brief Write user annotation marker to trace buffer of current CPU
+ *
+ * @param iotrace iotrace main context
+ * @param text Null terminated text of the marker
+ *
+ * @retval 0 Marker stored successfully in trace buffer
+ * @retval -ENODEV Tracing is not running
+ * @retval non-zero Error code
+ */
+int iotrace_trace_marker(struct iotrace_context *iotrace, const char *text) {
+    int result = 0;
+    struct iotrace_state *state = &iotrace->trace_state;
+    struct iotrace_event_marker *ev = NULL;
+    octf_trace_event_handle_t ev_hndl;
+    octf_trace_t trace;
+    uint64_t sid;
+    unsigned cpu;
+
+    if (strnlen(text, sizeof(ev->text)) >= sizeof(ev->text))
+        return -ENOSPC;
+
+    /* Trace buffers exist only while there is a client */
+    mutex_lock(&iotrace->mutex);
+    if (!state->clients) {
+        result = -ENODEV;
+        goto exit;
+    }
+
+    cpu = get_cpu();
+    trace = *per_cpu_ptr(state->traces, cpu);
+    sid = atomic64_inc_return(&state->sid);
+
+    result = octf_trace_get_wr_buffer(trace, &ev_hndl, (void **) &ev,
+                                      sizeof(*ev));
+    if (!result) {
+        iotrace_event_init_hdr(&ev->hdr, IOTRACE_EVENT_TYPE_MARKER, sid,
+                               ktime_to_ns(ktime_get()), sizeof(*ev));
+        strlcpy(ev->text, text, sizeof(ev->text));
+
+        result = octf_trace_commit_wr_buffer(trace, ev_hndl);
+        iotrace_notify_of_new_events(iotrace, cpu);
+    }
+
+    put_cpu();
+
+exit:
+    mutex_unlock(&iotrace->mutex);
+    return result;
+}
+
 /**
  * @brief Function registered to be called each time BIO is queued
  *
@@ -45,6 +45,8 @@ int iotrace_trace_desc(struct iotrace_context *iotrace,
                        const char *dev_model,
                        uint64_t dev_size);
 
+int iotrace_trace_marker(struct iotrace_context *iotrace, const char *text);
+
 int iotrace_attach_client(struct iotrace_context *iotrace);
 
 void iotrace_detach_client(struct iotrace_context *iotrace);
@@ -0,0 +1 @@
+../includes/iotrace_marker.h
\ No newline at end of file
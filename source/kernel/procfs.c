@@ -19,6 +19,7 @@
 #include "config.h"
 #include "context.h"
 #include "iotrace_event.h"
+#include "iotrace_marker.h"
 #include "procfs_files.h"
 #include "trace.h"
 #include "trace_bdev.h"
@@ -404,6 +405,28 @@ static ssize_t del_dev_write(struct file *file,
     return iotrace_mngt_write(file, ubuf, count, ppos, _del_dev_scanf);
 }
 
+static int _describe_dev_scanf(const char *buf) {
+    return iotrace_bdev_describe(&iotrace_get_context()->bdev);
+}
+
+/**
+ * @brief Write handler for file used to write descriptions of traced
+ * devices to trace buffers, written text is ignored
+ *
+ * @param[in] file file object associated with this procfs entry
+ * @param[out] ubuf user pointer to input buffer
+ * @param[in] count ubuf size
+ * @param[out] ppos position in file after write operation is completed
+ *
+ * @retval number of bytes read from @ubuf
+ */
+static ssize_t describe_dev_write(struct file *file,
+                                  const char __user *ubuf,
+                                  size_t count,
+                                  loff_t *ppos) {
+    return iotrace_mngt_write(file, ubuf, count, ppos, _describe_dev_scanf);
+}
+
 static int _list_dev_snprintf(char *buf, size_t size) {
     char **devices;
     unsigned dev_count;
@@ -526,11 +549,56 @@ static ssize_t size_write(struct file *file,
     return iotrace_mngt_write(file, ubuf, count, ppos, _buffer_size_sscanf);
 }
 
+/**
+ * @brief Write handler for file used to inject user markers into the trace
+ *
+ * Every write emits one marker, so the file can be kept open and written
+ * repeatedly. Unlike other management files no buffer is allocated.
+ *
+ * @param[in] file file object associated with this procfs entry
+ * @param[out] ubuf user pointer to input buffer
+ * @param[in] count ubuf size
+ * @param[out] ppos position in file after write operation is completed
+ *
+ * @retval number of bytes read from @ubuf
+ */
+static ssize_t marker_write(struct file *file,
+                            const char __user *ubuf,
+                            size_t count,
+                            loff_t *ppos) {
+    char text[IOTRACE_MARKER_MAX_LEN];
+    size_t len = count;
+    int result;
+
+    if (count == 0 || count > sizeof(text))
+        return -EINVAL;
+
+    if (copy_from_user(text, ubuf, count))
+        return -EFAULT;
+
+    if (text[len - 1] == '\n')
+        len--;
+
+    if (len >= sizeof(text))
+        return -ENOSPC;
+    text[len] = '\0';
+
+    result = iotrace_trace_marker(iotrace_get_context(), text);
+    if (result)
+        return result;
+
+    return count;
+}
+
 /* device management files ops */
 static struct file_operations add_dev_ops = {.owner = THIS_MODULE,
                                              .write = add_dev_write};
 static struct file_operations del_dev_ops = {.owner = THIS_MODULE,
                                              .write = del_dev_write};
+static struct file_operations describe_dev_ops = {
+        .owner = THIS_MODULE,
+        .write = describe_dev_write,
+};
 static struct file_operations list_dev_ops = {
         .owner = THIS_MODULE,
         .read = list_dev_read,
@@ -544,6 +612,10 @@ static struct file_operations size_ops = {
         .write = size_write,
         .read = size_read,
 };
+static struct file_operations marker_ops = {
+        .owner = THIS_MODULE,
+        .write = marker_write,
+};
 
 /**
  * @brief Initialize iotrace directory in /proc
@@ -575,6 +647,11 @@ static int iotrace_procfs_mngt_init(struct proc_dir_entry *dir) {
                     .ops = &del_dev_ops,
                     .mode = S_IWUSR,
             },
+            {
+                    .name = IOTRACE_PROCFS_DESCRIBE_DEVICES_FILE_NAME,
+                    .ops = &describe_dev_ops,
+                    .mode = S_IWUSR,
+            },
             {
                     .name = IOTRACE_PROCFS_VERSION_FILE_NAME,
                     .ops = &get_version_ops,
@@ -585,6 +662,11 @@ static int iotrace_procfs_mngt_init(struct proc_dir_entry *dir) {
                     .ops = &size_ops,
                     .mode = S_IRUSR | S_IWUSR,
             },
+            {
+                    .name = IOTRACE_PROCFS_MARKER_FILE_NAME,
+                    .ops = &marker_ops,
+                    .mode = S_IWUSR,
+            },
     };
     size_t num_entries = sizeof(entries) / sizeof(entries[0]);
 
@@ -35,6 +35,25 @@ struct iotrace_bdev_data {
     char bdev_model[128];
 };
 
+/**
+ * @brief Write description of block device to trace buffer of given CPU
+ *
+ * @param data Input data structure (block device and its model)
+ * @param cpu CPU of trace buffer
+ */
+static void iotrace_bdev_trace_desc(struct iotrace_bdev_data *data,
+                                    unsigned cpu) {
+    struct gendisk *gd = data->bdev->bd_disk;
+    uint64_t bdev_size = 0;
+
+    bdev_size = (data->bdev->bd_contains == data->bdev)
+                        ? get_capacity(data->bdev->bd_disk)
+                        : data->bdev->bd_part->nr_sects;
+
+    iotrace_trace_desc(iotrace_get_context(), cpu, disk_devt(gd),
+                       gd->disk_name, data->bdev_model, bdev_size);
+}
+
 /**
  * @brief Add block device pointer to per-cpu @trace_bdev array
  *
@@ -49,19 +68,24 @@ void static iotrace_bdev_add_oncpu(void *info) {
     struct iotrace_bdev_data *data = info;
     struct iotrace_bdev *trace_bdev = data->trace_bdev;
     unsigned cpu = smp_processor_id();
-    struct gendisk *gd = data->bdev->bd_disk;
-    struct iotrace_context *iotrace = iotrace_get_context();
-    uint64_t bdev_size = 0;
-
-    bdev_size = (data->bdev->bd_contains == data->bdev)
-                        ? get_capacity(data->bdev->bd_disk)
-                        : data->bdev->bd_part->nr_sects;
 
     BUG_ON(trace_bdev->num >= IOTRACE_MAX_DEVICES);
     per_cpu_ptr(trace_bdev->list, cpu)[trace_bdev->num] = data->bdev;
 
-    iotrace_trace_desc(iotrace, cpu, disk_devt(gd), gd->disk_name,
-                       data->bdev_model, bdev_size);
+    iotrace_bdev_trace_desc(data, cpu);
+}
+
+/**
+ * @brief Write description of traced block device to trace buffer of
+ *     running CPU
+ *
+ * @usage This function is designed to be called using on_each_cpu macro.
+ *     Management lock should be held by the caller.
+ *
+ * @param info Input data structure (block device and its model)
+ */
+void static iotrace_bdev_describe_oncpu(void *info) {
+    iotrace_bdev_trace_desc(info, smp_processor_id());
 }
 
 static void iotrace_bdev_get_model(struct iotrace_bdev_data *data) {
@@ -183,6 +207,44 @@ exit:
     return result;
 }
 
+/**
+ * @brief Write descriptions of all traced devices to trace buffers
+ *
+ * Used when a new trace is started while devices remain traced, so that
+ * the trace begins with descriptions of its devices.
+ *
+ * @param trace_bdev iotrace block device list
+ *
+ * @retval 0 descriptions written successfully
+ * @retval non-zero Error code
+ */
+int iotrace_bdev_describe(struct iotrace_bdev *trace_bdev) {
+    struct iotrace_bdev_data data = {.trace_bdev = trace_bdev};
+    struct block_device **bdev_list;
+    struct iotrace_context *context = iotrace_get_context();
+    unsigned i;
+
+    mutex_lock(&context->mutex);
+
+    if (!context->trace_state.clients) {
+        mutex_unlock(&context->mutex);
+        return -EINVAL;
+    }
+
+    bdev_list = per_cpu_ptr(trace_bdev->list, smp_processor_id());
+    for (i = 0; i < trace_bdev->num; i++) {
+        data.bdev = bdev_list[i];
+        memset(data.bdev_model, 0, sizeof(data.bdev_model));
+        iotrace_bdev_get_model(&data);
+
+        on_each_cpu(iotrace_bdev_describe_oncpu, &data, true);
+    }
+
+    mutex_unlock(&context->mutex);
+
+    return 0;
+}
+
 /**
  * @brief Remove block device pointer from per-cpu @trace_bdev array
  *
@@ -63,6 +63,8 @@ int iotrace_bdev_remove(struct iotrace_bdev *trace_bdev, const char *path);
 
 int iotrace_bdev_add(struct iotrace_bdev *trace_bdev, const char *path);
 
+int iotrace_bdev_describe(struct iotrace_bdev *trace_bdev);
+
 void iotrace_bdev_remove_all_locked(struct iotrace_bdev *trace_bdev);
 
 int iotrace_bdev_init(struct iotrace_bdev *trace_bdev);
@@ -5,8 +5,11 @@
 
 #include "InterfaceKernelTraceCreatingImpl.h"
 #include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <fstream>
 #include <string>
 #include <thread>
 #include <octf/interface/TraceManager.h>
@@ -14,11 +17,17 @@
 #include <octf/proto/trace.pb.h>
 #include <octf/trace/iotrace_event.h>
 #include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
 #include <octf/utils/Log.h>
 #include "KernelTraceExecutor.h"
+#include "analytics/CaptureAnalysis.h"
+#include "analytics/TimeSeriesRollup.h"
+#include "analytics/TraceMarkerLog.h"
 
 namespace octf {
 
+static constexpr uint64_t NS_IN_MS = 1000000ULL;
+
 InterfaceKernelTraceCreatingImpl::InterfaceKernelTraceCreatingImpl()
         : m_nodePath{NodeId("kernel")} {}
 
@@ -59,6 +68,22 @@ void InterfaceKernelTraceCreatingImpl::StartTracing(
                                     descriptor)) {
             throw Exception("Invalid circular buffer size");
         }
+        if (!checkIntegerParameters(request->segmentduration(),
+                                    "segmentduration", descriptor)) {
+            throw Exception("Invalid trace segment duration");
+        }
+        if (!checkIntegerParameters(request->segmentsize(), "segmentsize",
+                                    descriptor)) {
+            throw Exception("Invalid trace segment size");
+        }
+        if (!checkIntegerParameters(request->rollupinterval(),
+                                    "rollupinterval", descriptor)) {
+            throw Exception("Invalid time series rollup interval");
+        }
+        for (const auto &name : request->analyzers()) {
+            // Fail early on unknown analyzers
+            CaptureAnalysis::createAnalyzer(name);
+        }
 
         probeModule();
 
@@ -70,22 +95,134 @@ void InterfaceKernelTraceCreatingImpl::StartTracing(
 
         KernelTraceExecutor kernelExecutor(devices, circBufferSize);
 
-        TraceManager manager(m_nodePath, &kernelExecutor);
+        uint32_t segmentDuration = request->segmentduration();
+        uint32_t segmentSize = request->segmentsize();
+        bool rotate = segmentDuration || segmentSize;
+
+        // No IO is lost between segments
+        kernelExecutor.setKeepDevices(rotate);
+
+        auto start = std::chrono::steady_clock::now();
+        auto segmentStart = start - std::chrono::seconds(1);
+        uint64_t usedSize = 0;
+
+        for (uint32_t segment = 0;; segment++) {
+            // Budget left for this segment within overall trace limits
+            auto now = std::chrono::steady_clock::now();
+            uint64_t elapsed =
+                    std::chrono::duration_cast<std::chrono::seconds>(now -
+                                                                     start)
+                            .count();
+            uint32_t duration = maxDuration - std::min<uint64_t>(elapsed,
+                                                                maxDuration);
+            uint32_t size = maxSize - std::min<uint64_t>(usedSize, maxSize);
+            if (segment && (!duration || !size)) {
+                break;
+            }
+
+            if (segmentDuration) {
+                duration = std::min(duration, segmentDuration);
+            }
+            if (segmentSize) {
+                size = std::min(size, segmentSize);
+            }
+
+            std::string label = request->label();
+            if (rotate) {
+                label += "#" + std::to_string(segment);
+
+                // Trace paths have resolution of one second, make sure
+                // segments do not collide
+                std::this_thread::sleep_until(segmentStart +
+                                              std::chrono::seconds(1));
+                segmentStart = std::chrono::steady_clock::now();
+            }
 
-        manager.startJobs(maxDuration, maxSize, circBufferSize,
-                          request->label(), SerializerType::FileSerializer);
+            // Trace path is known once the segment is finished, so its time
+            // series is written aside and moved into the trace afterwards
+            std::shared_ptr<TimeSeriesRollup> rollup;
+            if (request->rollupinterval()) {
+                rollup = std::make_shared<TimeSeriesRollup>(
+                        getTimeSeriesStagingPath(),
+                        request->rollupinterval() * NS_IN_MS);
+            }
+            kernelExecutor.setTimeSeriesRollup(rollup);
 
-        kernelExecutor.waitUntilStopTrace();
+            std::shared_ptr<CaptureAnalysis> analysis;
+            if (request->analyzers_size()) {
+                analysis = std::make_shared<CaptureAnalysis>();
+                for (const auto &name : request->analyzers()) {
+                    analysis->addAnalyzer(
+                            CaptureAnalysis::createAnalyzer(name));
+                }
+            }
+            kernelExecutor.setCaptureAnalysis(analysis);
 
-        manager.stopJobs();
+            auto markers = std::make_shared<TraceMarkerLog>();
+            kernelExecutor.setTraceMarkerLog(markers);
 
-        TracingState state = manager.getState();
-        manager.fillTraceSummary(response, state);
+            bool sealed;
+            TracingState state;
+            {
+                TraceManager manager(m_nodePath, &kernelExecutor);
 
-        if (state != TracingState::COMPLETE) {
-            controller->SetFailed("Tracing not completed, trace path " +
+                manager.startJobs(duration, size, circBufferSize, label,
+                                  SerializerType::FileSerializer);
+
+                kernelExecutor.waitUntilStopTrace();
+
+                // Limits of the segment reached, otherwise interrupted by
+                // user
+                sealed = kernelExecutor.isTraceStopped();
+
+                manager.stopJobs();
+
+                state = manager.getState();
+                manager.fillTraceSummary(response, state);
+            }
+
+            // Converters of all queues are gone, their events are recorded
+            kernelExecutor.setTimeSeriesRollup(nullptr);
+            if (rollup) {
+                rollup->close();
+                if (state == TracingState::COMPLETE) {
+                    moveTimeSeries(response->tracepath());
+                } else {
+                    std::remove(getTimeSeriesStagingPath().c_str());
+                }
+            }
+
+            kernelExecutor.setCaptureAnalysis(nullptr);
+            if (analysis && state == TracingState::COMPLETE) {
+                writeCaptureAnalysis(*analysis, response->tracepath());
+            }
+
+            kernelExecutor.setTraceMarkerLog(nullptr);
+            if (markers->getCount() && state == TracingState::COMPLETE) {
+                writeTraceMarkers(*markers, response->tracepath());
+            }
+
+            if (state != TracingState::COMPLETE) {
+                controller->SetFailed("Tracing not completed, trace path " +
+                                      response->tracepath());
+                break;
+            }
+
+            if (!request->segmentlist().empty()) {
+                appendSegmentList(request->segmentlist(),
                                   response->tracepath());
+            }
+
+            if (!rotate || !sealed) {
+                break;
+            }
+
+            log::verbose << "Trace segment sealed, trace path "
+                         << response->tracepath() << std::endl;
+            usedSize += response->tracesize();
         }
+
+        kernelExecutor.stopDevices();
     } catch (Exception &e) {
         controller->SetFailed(e.what());
     } catch (std::exception &e) {
@@ -139,6 +276,62 @@ void InterfaceKernelTraceCreatingImpl::probeModule() {
     }
 }
 
+void InterfaceKernelTraceCreatingImpl::appendSegmentList(
+        const std::string &listPath,
+        const std::string &tracePath) {
+    std::ofstream file(listPath, std::ios_base::out | std::ios_base::app);
+
+    // Whole line is written at once, so followers never see partial path
+    file << tracePath + "\n";
+    file.flush();
+
+    if (file.fail()) {
+        log::cerr << "Cannot append trace segment to list " << listPath
+                  << std::endl;
+    }
+}
+
+std::string InterfaceKernelTraceCreatingImpl::getTimeSeriesStagingPath() {
+    return getFrameworkConfiguration().getTraceRepositoryPath() +
+           "/.iotrace-timeseries." + std::to_string(getpid());
+}
+
+void InterfaceKernelTraceCreatingImpl::moveTimeSeries(
+        const std::string &tracePath) {
+    std::string target = TimeSeriesRollup::getFilePath(tracePath);
+
+    if (std::rename(getTimeSeriesStagingPath().c_str(), target.c_str())) {
+        log::cerr << "Cannot move time series to trace " << tracePath
+                  << std::endl;
+    }
+}
+
+void InterfaceKernelTraceCreatingImpl::writeCaptureAnalysis(
+        CaptureAnalysis &analysis,
+        const std::string &tracePath) {
+    try {
+        proto::CaptureAnalysis result;
+        analysis.merge(result);
+        CaptureAnalysis::write(tracePath, result);
+    } catch (Exception &e) {
+        log::cerr << "Cannot store capture analysis of trace " << tracePath
+                  << ": " << e.what() << std::endl;
+    }
+}
+
+void InterfaceKernelTraceCreatingImpl::writeTraceMarkers(
+        const TraceMarkerLog &markers,
+        const std::string &tracePath) {
+    try {
+        proto::TraceMarkers result;
+        markers.getMarkers(result);
+        TraceMarkerLog::write(tracePath, result);
+    } catch (Exception &e) {
+        log::cerr << "Cannot store markers of trace " << tracePath << ": "
+                  << e.what() << std::endl;
+    }
+}
+
 void InterfaceKernelTraceCreatingImpl::removeModule() {
     int result = std::system(REMOVE_MODULE_COMMAND);
     if (result) {
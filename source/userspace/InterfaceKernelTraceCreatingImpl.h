@@ -6,9 +6,12 @@
 #ifndef SOURCE_USERSPACE_INTERFACEKERNELTRACECREATINGIMPL_H
 #define SOURCE_USERSPACE_INTERFACEKERNELTRACECREATINGIMPL_H
 
+#include <string>
 #include <octf/interface/ITraceExecutor.h>
 #include <octf/node/INode.h>
 #include "InterfaceKernelTraceCreating.pb.h"
+#include "analytics/CaptureAnalysis.h"
+#include "analytics/TraceMarkerLog.h"
 
 namespace octf {
 
@@ -39,6 +42,35 @@ private:
 
     void removeModule();
 
+    /**
+     * @brief Appends path of sealed trace segment to segment list file
+     */
+    void appendSegmentList(const std::string &listPath,
+                           const std::string &tracePath);
+
+    /**
+     * @return Path of time series written while the trace is captured
+     */
+    static std::string getTimeSeriesStagingPath();
+
+    /**
+     * @brief Moves time series of finished capture into its trace directory
+     */
+    void moveTimeSeries(const std::string &tracePath);
+
+    /**
+     * @brief Merges results of capture analyzers and stores them in trace
+     * directory
+     */
+    void writeCaptureAnalysis(CaptureAnalysis &analysis,
+                              const std::string &tracePath);
+
+    /**
+     * @brief Stores texts of user markers in trace directory
+     */
+    void writeTraceMarkers(const TraceMarkerLog &markers,
+                           const std::string &tracePath);
+
     const NodePath m_nodePath;
 };
 
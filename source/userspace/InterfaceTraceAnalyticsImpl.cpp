@@ -0,0 +1,1691 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "InterfaceTraceAnalyticsImpl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <google/protobuf/util/json_util.h>
+#include <octf/utils/Exception.h>
+#include <octf/utils/Log.h>
+#include "analytics/CachePolicy.h"
+#include "analytics/CacheSimulationHandler.h"
+#include "analytics/CacheSimulator.h"
+#include "analytics/CaptureAnalysis.h"
+#include "analytics/ColumnarExportHandler.h"
+#include "analytics/ColumnarTraceWriter.h"
+#include "analytics/EventCountingHandler.h"
+#include "analytics/FileSystemStatisticsBuilder.h"
+#include "analytics/FollowTraceHandler.h"
+#include "analytics/HeatmapBuilder.h"
+#include "analytics/HeatmapHandler.h"
+#include "analytics/IoEventColumns.h"
+#include "analytics/IoEventFilter.h"
+#include "analytics/IoMatchingHandler.h"
+#include "analytics/LatencyStatisticsHandler.h"
+#include "analytics/MappedTraceReader.h"
+#include "analytics/MarkerStatisticsHandler.h"
+#include "analytics/MissRatioCurveHandler.h"
+#include "analytics/RollingStatistics.h"
+#include "analytics/SegmentListFollower.h"
+#include "analytics/SequentialityHandler.h"
+#include "analytics/StatisticsCache.h"
+#include "analytics/TimeSeriesRollup.h"
+#include "analytics/TraceCompactor.h"
+#include "analytics/TraceMarkerLog.h"
+#include "analytics/TraceMerger.h"
+#include "analytics/TraceProfileHandler.h"
+#include "analytics/TraceReplayer.h"
+#include "analytics/TraceSegmentHandler.h"
+#include "analytics/TraceWriter.h"
+#include "analytics/WorkerPool.h"
+#include "analytics/WorkingSetHandler.h"
+
+namespace octf {
+
+template <typename Request>
+static std::vector<std::string> getSegments(const Request &request) {
+    return std::vector<std::string>(request.segments().begin(),
+                                    request.segments().end());
+}
+
+void InterfaceTraceAnalyticsImpl::ExportColumnar(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::ExportColumnarRequest *request,
+        ::octf::proto::ColumnarExportSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        ColumnarTraceWriter writer(request->outputpath(),
+                                   request->rowgroupsize(), request->threads());
+        ColumnarExportHandler handler(request->tracepath(), writer);
+
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+        writer.close();
+
+        response->set_outputpath(request->outputpath());
+        response->set_rowcount(writer.getRowCount());
+        response->set_rowgroupcount(writer.getRowGroupCount());
+        response->set_filesize(writer.getFileSize());
+
+        for (size_t i = 0; i < static_cast<size_t>(TraceColumn::Count); i++) {
+            auto column = static_cast<TraceColumn>(i);
+            const auto &summary = writer.getColumnSummary(column);
+            auto pbColumn = response->add_column();
+
+            pbColumn->set_name(getTraceColumnName(column));
+            pbColumn->set_rawsize(summary.rawSize);
+            pbColumn->set_encodedsize(summary.encodedSize);
+
+            for (size_t e = 0; e < summary.encodingUsage.size(); e++) {
+                if (summary.encodingUsage[e]) {
+                    auto name = getColumnEncodingName(
+                            static_cast<ColumnEncoding>(e));
+                    (*pbColumn->mutable_encodings())[name] =
+                            summary.encodingUsage[e];
+                }
+            }
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static double getHitPercent(uint64_t hits, uint64_t accesses) {
+    return accesses ? 100.0 * hits / accesses : 0.0;
+}
+
+static CacheMode getCacheMode(const std::string &name) {
+    if (name == getCacheModeName(CacheMode::WriteBack)) {
+        return CacheMode::WriteBack;
+    } else if (name == getCacheModeName(CacheMode::WriteThrough)) {
+        return CacheMode::WriteThrough;
+    }
+
+    throw Exception("Unknown cache mode: " + name);
+}
+
+void InterfaceTraceAnalyticsImpl::SimulateCache(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::SimulateCacheRequest *request,
+        ::octf::proto::CacheSimulationSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        uint64_t lineSize = request->cachelinesize();
+        if (lineSize & (lineSize - 1)) {
+            throw Exception("Cache line size has to be power of 2");
+        }
+        lineSize *= 1024;
+
+        std::vector<std::string> policies(request->policies().begin(),
+                                          request->policies().end());
+        if (policies.empty()) {
+            policies = getCachePolicyNames();
+        }
+
+        std::vector<CacheMode> modes;
+        for (const auto &mode : request->modes()) {
+            modes.push_back(getCacheMode(mode));
+        }
+        if (modes.empty()) {
+            modes = {CacheMode::WriteBack, CacheMode::WriteThrough};
+        }
+
+        CacheSimulator simulator(lineSize, request->threads());
+
+        uint64_t maxSize = request->maxcachesize();
+        uint64_t steps = request->sizesteps();
+        for (const auto &policy : policies) {
+            for (auto mode : modes) {
+                for (uint64_t step = 1; step <= steps; step++) {
+                    uint64_t size = maxSize * step / steps;
+                    uint64_t lines = (size << 20) / lineSize;
+                    if (!lines) {
+                        continue;
+                    }
+
+                    simulator.addCache(createCachePolicy(policy, lines, mode));
+                }
+            }
+        }
+
+        CacheSimulationHandler handler(request->tracepath(), simulator);
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+        simulator.finish();
+
+        response->set_cachelinesize(request->cachelinesize());
+        response->set_accesses(simulator.getAccessCount());
+
+        for (const auto &cache : simulator.getCaches()) {
+            const auto &stats = cache->getStatistics();
+            auto result = response->add_result();
+
+            result->set_policy(cache->getName());
+            result->set_mode(getCacheModeName(cache->getMode()));
+            result->set_cachesize((cache->getCapacity() * lineSize) >> 20);
+            result->set_cachelines(cache->getCapacity());
+            result->set_hitpercent(getHitPercent(
+                    stats.readHits + stats.writeHits,
+                    stats.readAccesses + stats.writeAccesses));
+            result->set_readhitpercent(
+                    getHitPercent(stats.readHits, stats.readAccesses));
+            result->set_writehitpercent(
+                    getHitPercent(stats.writeHits, stats.writeAccesses));
+            result->set_corewrites(stats.coreWrites);
+            result->set_evictions(stats.evictions);
+            result->set_memoryusage(cache->getMemoryUsage());
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillMissRatioCurve(const MissRatioCurveEstimator &estimator,
+                               uint64_t lineSize,
+                               proto::MissRatioCurve *curve) {
+    curve->set_accesses(estimator.getAccessCount());
+    curve->set_sampledaccesses(estimator.getSampledAccessCount());
+    curve->set_samplingrate(estimator.getSamplingRate());
+    curve->set_memoryusage(estimator.getMemoryUsage());
+
+    for (const auto &point : estimator.getCurve()) {
+        auto pbPoint = curve->add_point();
+        pbPoint->set_cachesize(static_cast<double>(point.cacheLines) *
+                               lineSize / (1 << 20));
+        pbPoint->set_missratio(point.missRatio);
+    }
+}
+
+void InterfaceTraceAnalyticsImpl::GetMissRatioCurves(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::MissRatioCurveRequest *request,
+        ::octf::proto::MissRatioCurves *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        uint64_t lineSize = request->cachelinesize();
+        if (lineSize & (lineSize - 1)) {
+            throw Exception("Cache line size has to be power of 2");
+        }
+        lineSize *= 1024;
+
+        uint64_t maxSize = request->maxcachesize();
+        uint64_t maxLines = (maxSize << 20) / lineSize;
+        uint64_t binLines = maxLines / request->points();
+        if (!binLines) {
+            throw Exception("Too many points for given max cache size");
+        }
+
+        MissRatioCurveHandler handler(request->tracepath(), lineSize,
+                                      request->samplelimit(), binLines,
+                                      request->points());
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+
+        response->set_cachelinesize(request->cachelinesize());
+
+        const auto &names = handler.getDeviceNames();
+        for (const auto &device : handler.getDeviceCurves()) {
+            auto curve = response->add_device();
+
+            curve->set_id(device.first);
+            curve->set_name(names.at(device.first));
+            fillMissRatioCurve(*device.second, lineSize, curve);
+        }
+
+        for (const auto &ioClass : handler.getIoClassCurves()) {
+            auto curve = response->add_ioclass();
+
+            curve->set_id(ioClass.first);
+            fillMissRatioCurve(*ioClass.second, lineSize, curve);
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static uint64_t parseWindowDuration(const std::string &window) {
+    static constexpr uint64_t NS_IN_SEC = 1000ULL * 1000ULL * 1000ULL;
+
+    size_t end = 0;
+    uint64_t value = 0;
+    try {
+        value = std::stoull(window, &end);
+    } catch (std::exception &) {
+        end = 0;
+    }
+
+    std::string unit = window.substr(end);
+    if (!end || !value || unit.size() != 1) {
+        throw Exception("Invalid window duration: " + window);
+    }
+
+    switch (unit[0]) {
+    case 's':
+        return value * NS_IN_SEC;
+    case 'm':
+        return value * 60 * NS_IN_SEC;
+    case 'h':
+        return value * 3600 * NS_IN_SEC;
+    default:
+        throw Exception("Invalid window duration: " + window);
+    }
+}
+
+static void fillWorkingSetSize(const WorkingSetSize &size,
+                               uint64_t lineSize,
+                               proto::WorkingSetSize *pbSize) {
+    double mib = static_cast<double>(lineSize) / (1 << 20);
+
+    pbSize->set_read(size.read * mib);
+    pbSize->set_write(size.write * mib);
+    pbSize->set_total(size.total * mib);
+}
+
+/** Files tracked by working set estimation for every reported one */
+static constexpr uint32_t WORKING_SET_TRACKED_FILES_FACTOR = 4;
+
+void InterfaceTraceAnalyticsImpl::GetWorkingSet(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::WorkingSetRequest *request,
+        ::octf::proto::WorkingSetSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        uint64_t lineSize = request->cachelinesize();
+        if (lineSize & (lineSize - 1)) {
+            throw Exception("Cache line size has to be power of 2");
+        }
+        lineSize *= 1024;
+
+        std::vector<std::string> windows(request->windows().begin(),
+                                         request->windows().end());
+        if (windows.empty()) {
+            windows = {"1m", "10m", "1h"};
+        }
+
+        std::vector<uint64_t> durations;
+        for (const auto &window : windows) {
+            durations.push_back(parseWindowDuration(window));
+        }
+
+        // Track more files than reported, late hot files are ranked better
+        WorkingSetHandler handler(
+                request->tracepath(), lineSize, durations,
+                request->precision(), request->fileprecision(),
+                request->topfiles() * WORKING_SET_TRACKED_FILES_FACTOR);
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+        handler.finish();
+
+        response->set_cachelinesize(request->cachelinesize());
+
+        const auto &names = handler.getDeviceNames();
+        for (const auto &footprint : handler.getFootprints()) {
+            auto pbFootprint = response->add_footprint();
+
+            pbFootprint->set_id(footprint.first);
+            pbFootprint->set_name(names.at(footprint.first));
+            fillWorkingSetSize(footprint.second, lineSize,
+                               pbFootprint->mutable_size());
+        }
+
+        for (size_t i = 0; i < windows.size(); i++) {
+            const auto &window = handler.getWindows()[i];
+            auto pbWindow = response->add_window();
+
+            pbWindow->set_window(windows[i]);
+
+            for (const auto &device : window.getDevices()) {
+                auto pbDevice = pbWindow->add_device();
+
+                pbDevice->set_id(device.first);
+                pbDevice->set_name(names.at(device.first));
+                fillWorkingSetSize(device.second.peak, lineSize,
+                                   pbDevice->mutable_peak());
+
+                for (const auto &interval : device.second.intervals) {
+                    auto pbInterval = pbDevice->add_interval();
+
+                    pbInterval->set_starttime(interval.start);
+                    fillWorkingSetSize(interval.size, lineSize,
+                                       pbInterval->mutable_size());
+                }
+            }
+
+            // Report files with the biggest peak working set
+            typedef std::map<WorkingSetWindow::FileKey,
+                             FileWorkingSet>::const_iterator FileIter;
+            std::vector<FileIter> files;
+            for (auto iter = window.getFiles().begin();
+                 iter != window.getFiles().end(); iter++) {
+                files.push_back(iter);
+            }
+
+            size_t count = std::min<size_t>(files.size(), request->topfiles());
+            std::partial_sort(files.begin(), files.begin() + count,
+                              files.end(), [](FileIter a, FileIter b) {
+                                  return a->second.peak.total >
+                                         b->second.peak.total;
+                              });
+
+            for (size_t f = 0; f < count; f++) {
+                const auto &file = *files[f];
+                auto pbFile = pbWindow->add_file();
+
+                pbFile->set_deviceid(file.first.first);
+                pbFile->set_id(file.first.second);
+                pbFile->set_path(file.second.path);
+                fillWorkingSetSize(file.second.peak, lineSize,
+                                   pbFile->mutable_peak());
+                pbFile->set_activeintervals(file.second.activeIntervals);
+            }
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::BuildHeatmap(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::HeatmapRequest *request,
+        ::octf::proto::HeatmapSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        // KiB to sectors
+        uint64_t hotRangeSize = uint64_t(request->hotrangesize()) * 2;
+
+        HeatmapBuilder builder(request->timebuckets(), request->lbabuckets(),
+                               hotRangeSize, request->topranges(),
+                               request->threads());
+        HeatmapHandler handler(request->tracepath(), builder);
+
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+        builder.finish();
+
+        response->set_outputpath(request->outputpath());
+        response->set_filesize(builder.write(request->outputpath()));
+
+        for (uint32_t i = 0; i < builder.getDeviceCount(); i++) {
+            const auto &grid = builder.getGrid(i);
+            auto device = response->add_device();
+
+            device->set_id(builder.getDeviceId(i));
+            device->set_name(builder.getDeviceName(i));
+            device->set_timebuckets(grid.getUsedRows());
+            device->set_lbabuckets(grid.getUsedCols());
+            device->set_timebucketsize(grid.getTimeBucket());
+            device->set_lbabucketsize(grid.getLbaBucket());
+        }
+
+        for (const auto &range : builder.getHotRanges()) {
+            auto hotRange = response->add_hotrange();
+
+            hotRange->set_deviceid(range.deviceId);
+            hotRange->set_lba(range.lba);
+            hotRange->set_len(range.len);
+            hotRange->set_sectors(range.sectors);
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillOperationLatency(const std::string &name,
+                                 const LatencyHistogram &histogram,
+                                 proto::OperationLatency *latency) {
+    static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+
+    latency->set_operation(name);
+    latency->set_count(histogram.getCount());
+    latency->set_min(histogram.getMin());
+    latency->set_max(histogram.getMax());
+    latency->set_mean(histogram.getMean());
+
+    for (auto percentile : PERCENTILES) {
+        auto pbPercentile = latency->add_percentile();
+
+        pbPercentile->set_percentile(percentile);
+        pbPercentile->set_latency(histogram.getValueAtPercentile(percentile));
+    }
+}
+
+void InterfaceTraceAnalyticsImpl::GetLatencyStatistics(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::LatencyStatisticsRequest *request,
+        ::octf::proto::LatencyStatistics *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        std::vector<std::string> paths(1, request->tracepath());
+        paths.insert(paths.end(), request->segments().begin(),
+                     request->segments().end());
+
+        StatisticsCache::DeviceHistograms histograms;
+        std::map<uint64_t, std::string> names;
+        uint32_t cachedSegments = 0;
+
+        // Each segment is cached separately, only new ones are parsed
+        for (const auto &path : paths) {
+            StatisticsCache cache(path);
+            StatisticsCache::DeviceHistograms segmentHistograms;
+            std::map<uint64_t, std::string> segmentNames;
+
+            if (!request->nocache() &&
+                cache.getLatency(request->precision(), segmentHistograms,
+                                 segmentNames)) {
+                cachedSegments++;
+            } else {
+                LatencyStatisticsHandler handler(path, request->precision());
+                handler.processEvents();
+
+                segmentHistograms = handler.getHistograms();
+                segmentNames = handler.getDeviceNames();
+                cache.putLatency(request->precision(), segmentHistograms,
+                                 segmentNames);
+            }
+
+            for (const auto &device : segmentHistograms) {
+                auto iter = histograms.find(device.first);
+                if (iter == histograms.end()) {
+                    histograms.insert(device);
+                    names[device.first] = segmentNames.at(device.first);
+                    continue;
+                }
+
+                for (size_t i = 0; i < device.second.size(); i++) {
+                    iter->second[i].merge(device.second[i]);
+                }
+            }
+        }
+
+        response->set_precision(request->precision());
+        response->set_cachedsegments(cachedSegments);
+
+        for (const auto &device : histograms) {
+            auto pbDevice = response->add_device();
+            LatencyHistogram total(request->precision());
+
+            pbDevice->set_id(device.first);
+            pbDevice->set_name(names.at(device.first));
+
+            for (size_t i = 0; i < device.second.size(); i++) {
+                auto operation = static_cast<LatencyOperation>(i);
+
+                fillOperationLatency(getLatencyOperationName(operation),
+                                     device.second[i],
+                                     pbDevice->add_operation());
+                total.merge(device.second[i]);
+            }
+
+            fillOperationLatency("total", total, pbDevice->add_operation());
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::MatchIo(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::MatchIoRequest *request,
+        ::octf::proto::IoMatchingSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        // Milliseconds to nanoseconds
+        uint64_t timeout = uint64_t(request->timeout()) * 1000000ULL;
+
+        IoMatchingHandler handler(request->tracepath(), request->capacity(),
+                                  timeout);
+
+        if (request->mmap()) {
+            MappedTraceReader reader(request->tracepath());
+            std::shared_ptr<proto::trace::Event> event;
+
+            while (reader.read(event)) {
+                handler.handleEvent(event);
+            }
+        } else {
+            handler.processEvents();
+        }
+
+        const auto &matcher = handler.getMatcher();
+        const auto &stats = matcher.getStatistics();
+
+        response->set_events(handler.getEventCount());
+        response->set_queued(stats.queued);
+        response->set_matched(stats.matched);
+        response->set_orphancompletions(stats.orphanCompletions);
+        response->set_timeoutevictions(stats.timeoutEvictions);
+        response->set_capacityevictions(stats.capacityEvictions);
+        response->set_replaced(stats.replaced);
+        response->set_peakinflight(stats.peakInFlight);
+        response->set_inflight(matcher.getInFlightCount());
+        response->set_memoryusage(matcher.getMemoryUsage());
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillRollingSnapshot(const RollingStatistics &statistics,
+                                const std::map<uint64_t, std::string> &names,
+                                const std::string &segment,
+                                ::octf::proto::RollingSnapshot *snapshot) {
+    snapshot->Clear();
+    snapshot->set_segment(segment);
+    snapshot->set_windowstart(statistics.getWindowStart());
+    snapshot->set_windowend(statistics.getWindowEnd());
+
+    // Window is empty until the first event arrives
+    double seconds = std::max<uint64_t>(statistics.getWindowEnd() -
+                                                statistics.getWindowStart(),
+                                        1) /
+                     1000000000.0;
+
+    for (const auto &device : statistics.getStatistics()) {
+        const auto &stats = device.second;
+        auto pbDevice = snapshot->add_device();
+
+        pbDevice->set_id(device.first);
+        pbDevice->set_name(names.at(device.first));
+
+        for (size_t i = 0; i < static_cast<size_t>(LatencyOperation::Count);
+             i++) {
+            auto pbOperation = pbDevice->add_operation();
+
+            pbOperation->set_operation(
+                    getLatencyOperationName(static_cast<LatencyOperation>(i)));
+            pbOperation->set_count(stats.count[i]);
+            pbOperation->set_iops(stats.count[i] / seconds);
+            pbOperation->set_bandwidth(stats.bytes[i] / seconds / (1 << 20));
+        }
+
+        pbDevice->set_latencymedian(stats.latency.getValueAtPercentile(50.0));
+        pbDevice->set_latencyp99(stats.latency.getValueAtPercentile(99.0));
+        pbDevice->set_latencymax(stats.latency.getMax());
+    }
+}
+
+void InterfaceTraceAnalyticsImpl::FollowTrace(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::FollowTraceRequest *request,
+        ::octf::proto::FollowTraceSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        constexpr uint64_t NS_PER_SECOND = 1000000000ULL;
+        constexpr uint32_t PRECISION = 2;
+        const std::chrono::milliseconds pollInterval(200);
+        const std::chrono::seconds idleTimeout(request->idletimeout());
+
+        RollingStatistics statistics(request->window() * NS_PER_SECOND,
+                                     NS_PER_SECOND, PRECISION);
+        SegmentListFollower follower(request->segmentlist());
+        std::unique_ptr<FollowTraceHandler> handler;
+        std::unique_ptr<TraceSegmentTimeline> timeline;
+
+        auto lastSegment = std::chrono::steady_clock::now();
+
+        while (true) {
+            auto segments = follower.poll();
+
+            if (segments.empty()) {
+                auto idle = std::chrono::steady_clock::now() - lastSegment;
+                if (idleTimeout.count() && idle >= idleTimeout) {
+                    break;
+                }
+
+                std::this_thread::sleep_for(pollInterval);
+                continue;
+            }
+
+            for (const auto &path : segments) {
+                if (!handler) {
+                    handler.reset(new FollowTraceHandler(
+                            path, statistics, request->events()));
+                    timeline.reset(new TraceSegmentTimeline(path));
+                }
+
+                TraceSegmentHandler segment(path, *handler,
+                                            timeline->getOffset(path));
+                segment.processEvents();
+                timeline->setEnd(segment.getEndTimestamp());
+
+                response->set_segments(response->segments() + 1);
+                fillRollingSnapshot(statistics, handler->getDeviceNames(),
+                                    path, response->mutable_statistics());
+
+                std::string json;
+                google::protobuf::util::MessageToJsonString(
+                        response->statistics(), &json);
+                log::cout << json << std::endl;
+            }
+
+            lastSegment = std::chrono::steady_clock::now();
+        }
+
+        if (handler) {
+            response->set_events(handler->getEventCount());
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillReaderBenchmark(const std::string &name,
+                                const EventCountingHandler &counter,
+                                uint64_t duration,
+                                uint64_t size,
+                                ::octf::proto::ReaderBenchmark *benchmark) {
+    double seconds = std::max<uint64_t>(duration, 1) / 1000000000.0;
+
+    benchmark->set_reader(name);
+    benchmark->set_events(counter.getEventCount());
+    benchmark->set_ioevents(counter.getIoEventCount());
+    benchmark->set_duration(duration);
+    benchmark->set_eventspersecond(counter.getEventCount() / seconds);
+    benchmark->set_mibpersecond(size / seconds / (1 << 20));
+}
+
+void InterfaceTraceAnalyticsImpl::BenchmarkReaders(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::BenchmarkReadersRequest *request,
+        ::octf::proto::ReaderBenchmarkSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        typedef std::chrono::steady_clock Clock;
+        uint64_t bufferedTime = ~0ULL;
+        uint64_t mappedTime = ~0ULL;
+        uint64_t size = 0;
+        uint64_t mappedAllocations = 0;
+        std::unique_ptr<EventCountingHandler> buffered;
+        std::unique_ptr<EventCountingHandler> mapped;
+
+        // Readers take turns, so both see similarly warm page cache
+        for (uint32_t i = 0; i < request->iterations(); i++) {
+            buffered.reset(new EventCountingHandler(request->tracepath()));
+
+            auto start = Clock::now();
+            buffered->processEvents();
+            uint64_t duration =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start)
+                            .count();
+            bufferedTime = std::min(bufferedTime, duration);
+
+            mapped.reset(new EventCountingHandler(request->tracepath()));
+            std::shared_ptr<proto::trace::Event> event;
+
+            start = Clock::now();
+            MappedTraceReader reader(request->tracepath());
+            while (reader.read(event)) {
+                mapped->count(*event);
+            }
+            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               Clock::now() - start)
+                               .count();
+            mappedTime = std::min(mappedTime, duration);
+
+            size = reader.getSize();
+            mappedAllocations = reader.getAllocationCount();
+            response->set_queuecount(reader.getQueueCount());
+        }
+
+        if (buffered->getEventCount() != mapped->getEventCount()) {
+            throw Exception("Trace readers returned different events");
+        }
+
+        response->set_tracesize(static_cast<double>(size) / (1 << 20));
+        fillReaderBenchmark("buffered", *buffered, bufferedTime, size,
+                            response->add_reader());
+        auto benchmark = response->add_reader();
+        fillReaderBenchmark("mmap", *mapped, mappedTime, size, benchmark);
+        benchmark->set_messageallocations(mappedAllocations);
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+/** Events decoded into columns before filtering them in bulk */
+static constexpr uint64_t FILTER_BATCH_SIZE = 65536;
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+static uint64_t getFilterOperation(const std::string &name) {
+    if (name == "read") {
+        return IoEventColumns::Read;
+    } else if (name == "write") {
+        return IoEventColumns::Write;
+    } else if (name == "discard") {
+        return IoEventColumns::Discard;
+    } else if (name == "completion") {
+        return IoEventColumns::Completion;
+    }
+
+    throw Exception("Unknown operation: " + name);
+}
+
+static IoFilterCriteria getFilterCriteria(
+        const ::octf::proto::FilterIoRequest &request,
+        uint64_t traceStart) {
+    IoFilterCriteria criteria;
+
+    if (request.device()) {
+        criteria.deviceMask = ~0ULL;
+        criteria.deviceId = request.device();
+    }
+
+    if (request.operations_size()) {
+        criteria.operations = 0;
+        for (const auto &operation : request.operations()) {
+            criteria.operations |= getFilterOperation(operation);
+        }
+    }
+
+    criteria.lbaBegin = request.lbabegin();
+    criteria.lbaEnd = request.lbaend();
+
+    // Milliseconds to nanoseconds
+    criteria.timeBegin = traceStart + request.timebegin() * 1000000ULL;
+    if (request.timeend() != std::numeric_limits<uint32_t>::max()) {
+        criteria.timeEnd = traceStart + request.timeend() * 1000000ULL;
+    }
+
+    return criteria;
+}
+
+void InterfaceTraceAnalyticsImpl::FilterIo(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::FilterIoRequest *request,
+        ::octf::proto::IoFilterSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        typedef std::chrono::steady_clock Clock;
+        std::vector<IoFilterImplementation> implementations;
+
+        if (request->benchmark()) {
+            implementations = IoEventFilter::getSupportedImplementations();
+        } else if (!request->implementation().empty()) {
+            implementations.push_back(IoEventFilter::getImplementation(
+                    request->implementation()));
+        } else {
+            implementations.push_back(
+                    IoEventFilter::getSupportedImplementations().back());
+        }
+
+        std::vector<IoFilterResult> results(implementations.size());
+        std::vector<uint64_t> durations(implementations.size());
+        uint64_t decodeDuration = 0;
+        uint64_t events = 0;
+
+        MappedTraceReader reader(request->tracepath());
+        std::shared_ptr<proto::trace::Event> event;
+        std::unique_ptr<IoEventFilter> filter;
+        IoEventColumns columns;
+        columns.reserve(FILTER_BATCH_SIZE);
+
+        bool more = true;
+        while (more) {
+            // Decode a batch of events into columns
+            auto start = Clock::now();
+            columns.clear();
+            while (columns.size() < FILTER_BATCH_SIZE) {
+                more = reader.read(event);
+                if (!more) {
+                    break;
+                }
+
+                if (!filter) {
+                    // Time window is relative to the first event
+                    filter.reset(new IoEventFilter(getFilterCriteria(
+                            *request, event->header().timestamp())));
+                }
+                columns.append(*event);
+            }
+            decodeDuration +=
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start)
+                            .count();
+            events += columns.size();
+
+            if (!columns.size()) {
+                continue;
+            }
+
+            // Filter the batch in bulk with each implementation
+            for (uint32_t i = 0; i < implementations.size(); i++) {
+                start = Clock::now();
+                filter->filter(columns, implementations[i], results[i]);
+                durations[i] +=
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                Clock::now() - start)
+                                .count();
+            }
+        }
+
+        for (const auto &result : results) {
+            if (!(result == results.front())) {
+                throw Exception("Filter implementations returned different "
+                                "results");
+            }
+        }
+
+        response->set_events(events);
+        response->set_matched(results.front().matched);
+        response->set_matchedbytes(results.front().sectors * SECTOR_SIZE);
+        response->set_decodeduration(decodeDuration);
+
+        for (uint32_t i = 0; i < implementations.size(); i++) {
+            double seconds = std::max<uint64_t>(durations[i], 1) / 1e9;
+            auto benchmark = response->add_implementation();
+
+            benchmark->set_implementation(
+                    IoEventFilter::getImplementationName(implementations[i]));
+            benchmark->set_duration(durations[i]);
+            benchmark->set_eventspersecond(events / seconds);
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillFsOperationStatistics(uint64_t count,
+                                      uint64_t sectors,
+                                      proto::FsOperationStatistics *stats) {
+    stats->set_count(count);
+    stats->set_bytes(sectors * SECTOR_SIZE);
+}
+
+template <typename Statistics>
+static void fillFsStatistics(const FileIoCounters &counters,
+                             Statistics *statistics) {
+    statistics->set_files(counters.files);
+    fillFsOperationStatistics(counters.readCount, counters.readSectors,
+                              statistics->mutable_read());
+    fillFsOperationStatistics(counters.writeCount, counters.writeSectors,
+                              statistics->mutable_write());
+}
+
+static void fillFsSubtrees(
+        const std::vector<FileSystemRollups::Subtree> &subtrees,
+        google::protobuf::RepeatedPtrField<proto::FsDirectoryStatistics>
+                *directories) {
+    for (const auto &subtree : subtrees) {
+        auto directory = directories->Add();
+        directory->set_partitionid(subtree.first.first);
+        directory->set_directory(subtree.first.second);
+        fillFsStatistics(subtree.second, directory);
+    }
+}
+
+static std::unique_ptr<FileSystemStatisticsBuilder> buildFsStatistics(
+        const std::string &tracePath) {
+    std::unique_ptr<FileSystemStatisticsBuilder> builder(
+            new FileSystemStatisticsBuilder());
+    MappedTraceReader reader(tracePath);
+    std::shared_ptr<proto::trace::Event> event;
+
+    while (reader.read(event)) {
+        builder->handleEvent(*event);
+    }
+
+    return builder;
+}
+
+void InterfaceTraceAnalyticsImpl::GetDirectoryStatistics(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::DirectoryStatisticsRequest *request,
+        ::octf::proto::DirectoryStatisticsSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        auto builder = buildFsStatistics(request->tracepath());
+
+        auto directories = builder->getDirectoryStatistics(request->depth());
+        for (const auto &entry : directories) {
+            auto directory = response->add_directory();
+            directory->set_partitionid(entry.first.first);
+            directory->set_directory(entry.first.second);
+            fillFsStatistics(entry.second, directory);
+        }
+
+        response->set_nodes(builder->getPathTree().getNodeCount());
+        response->set_names(builder->getPathTree().getNameCount());
+        response->set_unmatchedmeta(builder->getUnmatchedCount());
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::GetFileSystemRollups(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::FileSystemRollupsRequest *request,
+        ::octf::proto::FileSystemRollupsSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        std::vector<std::string> paths = getSegments(*request);
+        paths.insert(paths.begin(), request->tracepath());
+
+        // Each segment is processed by its own worker in one pass
+        WorkerPool pool(std::min<uint32_t>(
+                WorkerPool::resolveThreadCount(request->threads()),
+                paths.size()));
+        std::vector<std::future<std::unique_ptr<FileSystemStatisticsBuilder>>>
+                results;
+        for (const auto &path : paths) {
+            results.push_back(
+                    pool.submit([path]() { return buildFsStatistics(path); }));
+        }
+
+        std::vector<std::unique_ptr<FileSystemStatisticsBuilder>> builders;
+        for (auto &result : results) {
+            builders.push_back(result.get());
+        }
+
+        // Merge neighbouring results pairwise in parallel, keeping the order
+        // of segments, so that later names override earlier ones
+        while (builders.size() > 1) {
+            std::vector<std::future<void>> merges;
+            for (size_t i = 0; i + 1 < builders.size(); i += 2) {
+                FileSystemStatisticsBuilder *target = builders[i].get();
+                FileSystemStatisticsBuilder *source = builders[i + 1].get();
+                merges.push_back(pool.submit(
+                        [target, source]() { target->merge(*source); }));
+            }
+            for (auto &merge : merges) {
+                merge.get();
+            }
+
+            for (size_t i = 2; i < builders.size(); i += 2) {
+                builders[i / 2] = std::move(builders[i]);
+            }
+            builders.resize((builders.size() + 1) / 2);
+        }
+
+        FileSystemStatisticsBuilder &builder = *builders.front();
+        auto rollups = builder.getRollups(request->top());
+
+        for (const auto &partition : rollups.partitions) {
+            auto directory = response->add_partition();
+            directory->set_partitionid(partition.first);
+            directory->set_directory("/");
+            fillFsStatistics(partition.second, directory);
+        }
+
+        fillFsSubtrees(rollups.topByBytes, response->mutable_topbybytes());
+        fillFsSubtrees(rollups.topByIos, response->mutable_topbyios());
+
+        for (const auto &extension : rollups.extensions) {
+            auto statistics = response->add_extension();
+            statistics->set_extension(extension.first);
+            fillFsStatistics(extension.second, statistics);
+        }
+
+        for (const auto &sizeClass : rollups.sizeClasses) {
+            auto statistics = response->add_sizeclass();
+            statistics->set_ioclass(sizeClass.first);
+            statistics->set_name(FileSystemStatisticsBuilder::getSizeClassName(
+                    sizeClass.first));
+            fillFsStatistics(sizeClass.second, statistics);
+        }
+
+        response->set_nodes(builder.getPathTree().getNodeCount());
+        response->set_names(builder.getPathTree().getNameCount());
+        response->set_unmatchedmeta(builder.getUnmatchedCount());
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillOperationSequentiality(
+        const StreamStatistics &statistics,
+        proto::OperationSequentiality *sequentiality) {
+    sequentiality->set_ios(statistics.ios);
+    sequentiality->set_sequentialios(statistics.sequentialIos);
+    sequentiality->set_bytes(statistics.sectors * SECTOR_SIZE);
+    sequentiality->set_sequentialbytes(statistics.sequentialSectors *
+                                       SECTOR_SIZE);
+    sequentiality->set_sequentialpercent(
+            getHitPercent(statistics.sequentialIos, statistics.ios));
+    sequentiality->set_streams(statistics.streams);
+
+    for (uint32_t i = 0; i < StreamStatistics::RUN_LENGTH_BUCKETS; i++) {
+        if (statistics.runLengths[i]) {
+            auto bucket = sequentiality->add_runlength();
+            bucket->set_minios(StreamDetector::getRunLengthBucketStart(i));
+            bucket->set_runs(statistics.runLengths[i]);
+        }
+    }
+}
+
+void InterfaceTraceAnalyticsImpl::GetSequentiality(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::SequentialityRequest *request,
+        ::octf::proto::SequentialitySummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        // ms to ns
+        uint64_t idleTimeout = request->idletimeout() * 1000000ULL;
+
+        SequentialityHandler handler(request->tracepath(),
+                                     request->tablesize(), idleTimeout,
+                                     request->files());
+        processTraceSegments(handler, request->tracepath(),
+                             getSegments(*request));
+        handler.finish();
+
+        const auto &names = handler.getDeviceNames();
+        for (const auto &entry : handler.getDevices()) {
+            const StreamDetector &detector = *entry.second;
+            auto device = response->add_device();
+
+            device->set_id(entry.first);
+            device->set_name(names.at(entry.first));
+            device->set_peakstreams(detector.getPeakStreams());
+            fillOperationSequentiality(
+                    detector.getStatistics(StreamDetector::Read),
+                    device->mutable_read());
+            fillOperationSequentiality(
+                    detector.getStatistics(StreamDetector::Write),
+                    device->mutable_write());
+        }
+
+        for (const auto &entry : handler.getFiles()) {
+            auto file = response->add_file();
+
+            file->set_deviceid(entry.key.first);
+            file->set_id(entry.key.second);
+            file->set_path(entry.path);
+            file->set_rank(entry.rank);
+            fillOperationSequentiality(
+                    entry.detector->getStatistics(StreamDetector::Read),
+                    file->mutable_read());
+            fillOperationSequentiality(
+                    entry.detector->getStatistics(StreamDetector::Write),
+                    file->mutable_write());
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static int64_t parseClockOffset(const std::string &offset) {
+    try {
+        size_t end;
+        int64_t value = std::stoll(offset, &end);
+        if (end == offset.size()) {
+            return value;
+        }
+    } catch (std::exception &e) {
+    }
+
+    throw Exception("Invalid clock offset " + offset);
+}
+
+void InterfaceTraceAnalyticsImpl::MergeTraces(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::MergeTracesRequest *request,
+        ::octf::proto::TraceMergeSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        std::vector<std::string> paths(request->tracepaths().begin(),
+                                       request->tracepaths().end());
+        TraceMerger merger(paths);
+
+        if (request->offsets_size()) {
+            std::vector<int64_t> offsets;
+            for (const auto &offset : request->offsets()) {
+                offsets.push_back(parseClockOffset(offset));
+            }
+            merger.setOffsets(offsets);
+        } else {
+            merger.estimateOffsets();
+        }
+
+        TraceWriter writer(request->outputpath());
+        merger.merge(writer);
+
+        // Merged trace continues the reference trace
+        proto::TraceSummary summary;
+        TraceWriter::readSummary(paths.front(), summary);
+        summary.set_label(request->label().empty() ? "merged"
+                                                   : request->label());
+        summary.clear_tags();
+
+        // Merged trace is as lossy as all its inputs together
+        uint64_t droppedEvents = 0;
+        for (const auto &path : paths) {
+            proto::TraceSummary source;
+            if (TraceWriter::readSummary(path, source)) {
+                droppedEvents += source.droppedevents();
+            }
+            summary.add_tags("merged:" + path);
+        }
+        summary.set_droppedevents(droppedEvents);
+        writer.close(summary);
+
+        response->set_outputpath(request->outputpath());
+        response->set_events(writer.getEventCount());
+        response->set_tracesize(writer.getSize());
+
+        for (uint32_t i = 0; i < paths.size(); i++) {
+            auto trace = response->add_trace();
+            trace->set_tracepath(paths[i]);
+            trace->set_offset(merger.getOffsets()[i]);
+            trace->set_deviceidbase(TraceMerger::getDeviceId(0, i));
+            trace->set_events(merger.getEventCounts()[i]);
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::CompactTrace(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::CompactTraceRequest *request,
+        ::octf::proto::TraceCompactionSummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        CompactionCriteria criteria;
+        criteria.deviceId = request->device();
+        criteria.lbaBegin = request->lbabegin();
+        criteria.lbaEnd = request->lbaend();
+        criteria.timeBegin = request->timebegin() * 1000000ULL;
+        if (request->timeend() != std::numeric_limits<uint32_t>::max()) {
+            criteria.timeEnd = request->timeend() * 1000000ULL;
+        }
+        criteria.samplingRate = request->samplingrate();
+        // KiB to sectors
+        criteria.samplingUnit = uint64_t(request->samplingunit()) * 2;
+
+        TraceCompactor compactor(criteria, request->threads(),
+                                 request->maxinflight());
+        MappedTraceReader reader(request->tracepath());
+        TraceWriter writer(request->outputpath());
+        compactor.compact(reader, writer);
+
+        // Compacted trace keeps the origin and dropped events of the source
+        proto::TraceSummary summary;
+        TraceWriter::readSummary(request->tracepath(), summary);
+        summary.set_label(request->label().empty() ? "compacted"
+                                                   : request->label());
+        summary.clear_tags();
+        summary.add_tags("compacted:" + request->tracepath());
+        for (const auto &description : criteria.describe()) {
+            summary.add_tags(description);
+            response->add_criteria(description);
+        }
+        writer.close(summary);
+
+        response->set_outputpath(request->outputpath());
+        response->set_events(compactor.getEventCount());
+        response->set_keptevents(writer.getEventCount());
+        response->set_ios(compactor.getIoCount());
+        response->set_keptios(compactor.getKeptIoCount());
+        response->set_evictedios(compactor.getEvictedCount());
+        response->set_tracesize(writer.getSize());
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static std::unique_ptr<TraceProfile> profileTrace(const std::string &path,
+                                                  uint32_t precision) {
+    std::unique_ptr<TraceProfile> profile(new TraceProfile(precision));
+    TraceProfileHandler handler(path, *profile);
+
+    handler.processEvents();
+    return profile;
+}
+
+static double getRelativeChange(double before, double after) {
+    return before ? (after - before) / before * 100.0 : 0.0;
+}
+
+static bool fillDistributionComparison(
+        const std::string &metric,
+        const std::string &operation,
+        const LatencyHistogram &before,
+        const LatencyHistogram &after,
+        double minEffect,
+        proto::DistributionComparison *comparison) {
+    static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+
+    comparison->set_metric(metric);
+    comparison->set_operation(operation);
+    comparison->set_beforecount(before.getCount());
+    comparison->set_aftercount(after.getCount());
+    comparison->set_beforemean(before.getMean());
+    comparison->set_aftermean(after.getMean());
+
+    for (auto percentile : PERCENTILES) {
+        auto pbPercentile = comparison->add_percentile();
+        uint64_t beforeValue = before.getValueAtPercentile(percentile);
+        uint64_t afterValue = after.getValueAtPercentile(percentile);
+
+        pbPercentile->set_percentile(percentile);
+        pbPercentile->set_before(beforeValue);
+        pbPercentile->set_after(afterValue);
+        pbPercentile->set_change(getRelativeChange(beforeValue, afterValue));
+    }
+
+    double distance = before.getDistance(after) * 100.0;
+    double critical = LatencyHistogram::getCriticalDistance(
+                              before.getCount(), after.getCount()) *
+                      100.0;
+    bool significant = before.getCount() && after.getCount() &&
+                       distance > critical && distance >= minEffect;
+
+    comparison->set_distance(distance);
+    comparison->set_criticaldistance(critical);
+    comparison->set_significant(significant);
+    return significant;
+}
+
+/**
+ * @brief Two-proportion z-test of share of IOs at 1% significance level
+ */
+static bool isShareChangeSignificant(uint64_t beforeIos,
+                                     uint64_t beforeTotal,
+                                     uint64_t afterIos,
+                                     uint64_t afterTotal) {
+    static constexpr double CRITICAL_Z = 2.576;
+
+    if (!beforeTotal || !afterTotal) {
+        return false;
+    }
+
+    double beforeShare = static_cast<double>(beforeIos) / beforeTotal;
+    double afterShare = static_cast<double>(afterIos) / afterTotal;
+    double pooled = static_cast<double>(beforeIos + afterIos) /
+                    (beforeTotal + afterTotal);
+    double error = std::sqrt(pooled * (1.0 - pooled) *
+                             (1.0 / beforeTotal + 1.0 / afterTotal));
+
+    return error > 0.0 &&
+           std::fabs(afterShare - beforeShare) / error > CRITICAL_Z;
+}
+
+static const FileHotness &getFileHotness(
+        const std::unordered_map<std::string, FileHotness> &files,
+        const std::string &key) {
+    static const FileHotness NONE = {0, 0};
+
+    auto iter = files.find(key);
+    return iter == files.end() ? NONE : iter->second;
+}
+
+static uint32_t fillFileHotnessComparison(const TraceProfile &before,
+                                          const TraceProfile &after,
+                                          uint32_t top,
+                                          double minEffect,
+                                          proto::TraceComparison *response) {
+    typedef std::pair<double, const std::string *> Candidate;
+    const auto &beforeFiles = before.getFiles();
+    const auto &afterFiles = after.getFiles();
+
+    auto getShare = [](uint64_t ios, uint64_t total) {
+        return total ? static_cast<double>(ios) / total * 100.0 : 0.0;
+    };
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(beforeFiles.size() + afterFiles.size());
+    for (const auto &file : beforeFiles) {
+        double change =
+                getShare(getFileHotness(afterFiles, file.first).ios,
+                         after.getIoCount()) -
+                getShare(file.second.ios, before.getIoCount());
+        candidates.emplace_back(std::fabs(change), &file.first);
+    }
+    for (const auto &file : afterFiles) {
+        if (!beforeFiles.count(file.first)) {
+            double change = getShare(file.second.ios, after.getIoCount());
+            candidates.emplace_back(change, &file.first);
+        }
+    }
+
+    // Biggest change first, ties broken by path for stable output
+    auto order = [](const Candidate &a, const Candidate &b) {
+        return a.first != b.first ? a.first > b.first
+                                  : *a.second < *b.second;
+    };
+    size_t count = std::min<size_t>(top, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count,
+                      candidates.end(), order);
+
+    uint32_t significantCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        const std::string &key = *candidates[i].second;
+        const FileHotness &beforeFile = getFileHotness(beforeFiles, key);
+        const FileHotness &afterFile = getFileHotness(afterFiles, key);
+        auto file = response->add_file();
+
+        bool significant =
+                candidates[i].first >= minEffect &&
+                isShareChangeSignificant(beforeFile.ios, before.getIoCount(),
+                                         afterFile.ios, after.getIoCount());
+        significantCount += significant;
+
+        file->set_file(key);
+        file->set_beforeios(beforeFile.ios);
+        file->set_afterios(afterFile.ios);
+        file->set_beforebytes(beforeFile.bytes);
+        file->set_afterbytes(afterFile.bytes);
+        file->set_beforeshare(getShare(beforeFile.ios, before.getIoCount()));
+        file->set_aftershare(getShare(afterFile.ios, after.getIoCount()));
+        file->set_significant(significant);
+    }
+
+    return significantCount;
+}
+
+void InterfaceTraceAnalyticsImpl::CompareTraces(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::CompareTracesRequest *request,
+        ::octf::proto::TraceComparison *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        std::vector<std::string> paths(1, request->beforepath());
+        paths.insert(paths.end(), request->beforesegments().begin(),
+                     request->beforesegments().end());
+        size_t beforeCount = paths.size();
+        paths.push_back(request->afterpath());
+        paths.insert(paths.end(), request->aftersegments().begin(),
+                     request->aftersegments().end());
+
+        // Both traces and all their segments are profiled concurrently
+        uint32_t precision = request->precision();
+        WorkerPool pool(std::min<uint32_t>(
+                WorkerPool::resolveThreadCount(request->threads()),
+                paths.size()));
+        std::vector<std::future<std::unique_ptr<TraceProfile>>> results;
+        for (const auto &path : paths) {
+            results.push_back(pool.submit([path, precision]() {
+                return profileTrace(path, precision);
+            }));
+        }
+
+        std::vector<std::unique_ptr<TraceProfile>> profiles;
+        for (auto &result : results) {
+            profiles.push_back(result.get());
+        }
+        for (size_t i = 1; i < profiles.size(); i++) {
+            if (i != beforeCount) {
+                profiles[i < beforeCount ? 0 : beforeCount]->merge(
+                        *profiles[i]);
+            }
+        }
+        const TraceProfile &before = *profiles[0];
+        const TraceProfile &after = *profiles[beforeCount];
+
+        double minEffect = request->mineffect();
+        uint32_t significant = 0;
+
+        for (size_t m = 0; m < static_cast<size_t>(ProfileMetric::Count);
+             m++) {
+            auto metric = static_cast<ProfileMetric>(m);
+            LatencyHistogram beforeTotal(precision);
+            LatencyHistogram afterTotal(precision);
+
+            for (size_t o = 0;
+                 o < static_cast<size_t>(LatencyOperation::Count); o++) {
+                auto operation = static_cast<LatencyOperation>(o);
+                const auto &beforeHistogram =
+                        before.getHistogram(metric, operation);
+                const auto &afterHistogram =
+                        after.getHistogram(metric, operation);
+
+                beforeTotal.merge(beforeHistogram);
+                afterTotal.merge(afterHistogram);
+                if (!beforeHistogram.getCount() &&
+                    !afterHistogram.getCount()) {
+                    continue;
+                }
+
+                significant += fillDistributionComparison(
+                        getProfileMetricName(metric),
+                        getLatencyOperationName(operation), beforeHistogram,
+                        afterHistogram, minEffect,
+                        response->add_distribution());
+            }
+
+            significant += fillDistributionComparison(
+                    getProfileMetricName(metric), "total", beforeTotal,
+                    afterTotal, minEffect, response->add_distribution());
+        }
+
+        significant += fillFileHotnessComparison(
+                before, after, request->files(), minEffect, response);
+
+        response->set_beforepath(request->beforepath());
+        response->set_afterpath(request->afterpath());
+        response->set_beforeios(before.getIoCount());
+        response->set_afterios(after.getIoCount());
+        response->set_significantdifferences(significant);
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::GetTimeSeries(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::TimeSeriesRequest *request,
+        ::octf::proto::TimeSeries *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        TimeSeriesRollup::read(request->tracepath(), request->device(),
+                               *response);
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+static void fillReplayLatencies(
+        const std::vector<LatencyHistogram> &histograms,
+        ::google::protobuf::RepeatedPtrField<proto::OperationLatency>
+                *latencies) {
+    for (size_t i = 0; i < histograms.size(); i++) {
+        if (histograms[i].getCount()) {
+            fillOperationLatency(
+                    getLatencyOperationName(static_cast<LatencyOperation>(i)),
+                    histograms[i], latencies->Add());
+        }
+    }
+}
+
+void InterfaceTraceAnalyticsImpl::ReplayTrace(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::ReplayTraceRequest *request,
+        ::octf::proto::TraceReplaySummary *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        ReplayOptions options;
+        options.targetPath = request->target();
+        options.speed = request->speed();
+        options.lbaOffset = request->lbaoffset();
+        options.deviceId = request->device();
+        options.threadCount = request->threads();
+        options.queueDepth = request->queuedepth();
+        options.writes = request->writes();
+
+        TraceReplayer replayer(options);
+        replayer.replay(request->tracepath());
+
+        response->set_ios(replayer.getIoCount());
+        response->set_replayedios(replayer.getReplayedCount());
+        response->set_skippedios(replayer.getSkippedCount());
+        response->set_errors(replayer.getErrorCount());
+        response->set_recordedduration(replayer.getRecordedDuration());
+        response->set_replayduration(replayer.getReplayDuration());
+
+        fillReplayLatencies(replayer.getRecordedLatencies(),
+                            response->mutable_recordedlatency());
+        fillReplayLatencies(replayer.getAchievedLatencies(),
+                            response->mutable_achievedlatency());
+        fillOperationLatency("total", replayer.getSubmissionDelays(),
+                             response->mutable_submissiondelay());
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::GetCaptureAnalysis(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::CaptureAnalysisRequest *request,
+        ::octf::proto::CaptureAnalysis *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        CaptureAnalysis::read(request->tracepath(), *response);
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+void InterfaceTraceAnalyticsImpl::GetMarkerStatistics(
+        ::google::protobuf::RpcController *controller,
+        const ::octf::proto::MarkerStatisticsRequest *request,
+        ::octf::proto::MarkerStatistics *response,
+        ::google::protobuf::Closure *done) {
+    try {
+        proto::TraceMarkers markers;
+        TraceMarkerLog::read(request->tracepath(), markers);
+
+        MarkerStatisticsHandler handler(request->tracepath(), markers,
+                                        request->precision());
+        handler.processEvents();
+
+        const auto &intervals = handler.getIntervals();
+        const auto &names = handler.getDeviceNames();
+        response->set_precision(request->precision());
+
+        for (size_t i = 0; i < intervals.size(); i++) {
+            // Nothing precedes the first marker in a trace of whole capture
+            if (!i && intervals[i].empty() && markers.marker_size()) {
+                continue;
+            }
+
+            auto pbInterval = response->add_interval();
+            if (i) {
+                const auto &marker = markers.marker(i - 1);
+                pbInterval->mutable_marker()->CopyFrom(marker);
+
+                if (i < intervals.size() - 1) {
+                    pbInterval->set_duration(markers.marker(i).timestamp() -
+                                             marker.timestamp());
+                }
+            }
+
+            for (const auto &device : intervals[i]) {
+                const auto &statistics = device.second;
+                auto pbDevice = pbInterval->add_device();
+
+                pbDevice->set_id(device.first);
+                pbDevice->set_name(names.at(device.first));
+
+                for (size_t j = 0; j < statistics.histograms.size(); j++) {
+                    auto operation = static_cast<LatencyOperation>(j);
+                    uint64_t bytes = statistics.bytes[j];
+
+                    if (operation == LatencyOperation::Read) {
+                        pbDevice->set_readbytes(bytes);
+                    } else if (operation == LatencyOperation::Write) {
+                        pbDevice->set_writtenbytes(bytes);
+                    } else if (operation == LatencyOperation::Discard) {
+                        pbDevice->set_discardedbytes(bytes);
+                    }
+
+                    if (statistics.histograms[j].getCount()) {
+                        fillOperationLatency(getLatencyOperationName(operation),
+                                             statistics.histograms[j],
+                                             pbDevice->add_operation());
+                    }
+                }
+            }
+        }
+    } catch (Exception &e) {
+        controller->SetFailed(e.what());
+    } catch (std::exception &e) {
+        controller->SetFailed(e.what());
+    }
+
+    done->Run();
+}
+
+}  // namespace octf
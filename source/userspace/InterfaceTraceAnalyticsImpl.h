@@ -0,0 +1,137 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_INTERFACETRACEANALYTICSIMPL_H
+#define SOURCE_USERSPACE_INTERFACETRACEANALYTICSIMPL_H
+
+#include "InterfaceTraceAnalytics.pb.h"
+
+namespace octf {
+
+/**
+ * @brief Interface providing iotrace specific trace analytics
+ */
+class InterfaceTraceAnalyticsImpl : public proto::InterfaceTraceAnalytics {
+public:
+    InterfaceTraceAnalyticsImpl() = default;
+    virtual ~InterfaceTraceAnalyticsImpl() = default;
+
+    virtual void ExportColumnar(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::ExportColumnarRequest *request,
+            ::octf::proto::ColumnarExportSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void SimulateCache(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::SimulateCacheRequest *request,
+            ::octf::proto::CacheSimulationSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetMissRatioCurves(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::MissRatioCurveRequest *request,
+            ::octf::proto::MissRatioCurves *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetWorkingSet(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::WorkingSetRequest *request,
+            ::octf::proto::WorkingSetSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void BuildHeatmap(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::HeatmapRequest *request,
+            ::octf::proto::HeatmapSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetLatencyStatistics(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::LatencyStatisticsRequest *request,
+            ::octf::proto::LatencyStatistics *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void MatchIo(::google::protobuf::RpcController *controller,
+                         const ::octf::proto::MatchIoRequest *request,
+                         ::octf::proto::IoMatchingSummary *response,
+                         ::google::protobuf::Closure *done);
+
+    virtual void FollowTrace(::google::protobuf::RpcController *controller,
+                             const ::octf::proto::FollowTraceRequest *request,
+                             ::octf::proto::FollowTraceSummary *response,
+                             ::google::protobuf::Closure *done);
+
+    virtual void BenchmarkReaders(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::BenchmarkReadersRequest *request,
+            ::octf::proto::ReaderBenchmarkSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void FilterIo(::google::protobuf::RpcController *controller,
+                          const ::octf::proto::FilterIoRequest *request,
+                          ::octf::proto::IoFilterSummary *response,
+                          ::google::protobuf::Closure *done);
+
+    virtual void GetDirectoryStatistics(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::DirectoryStatisticsRequest *request,
+            ::octf::proto::DirectoryStatisticsSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetFileSystemRollups(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::FileSystemRollupsRequest *request,
+            ::octf::proto::FileSystemRollupsSummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetSequentiality(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::SequentialityRequest *request,
+            ::octf::proto::SequentialitySummary *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void MergeTraces(::google::protobuf::RpcController *controller,
+                             const ::octf::proto::MergeTracesRequest *request,
+                             ::octf::proto::TraceMergeSummary *response,
+                             ::google::protobuf::Closure *done);
+
+    virtual void CompactTrace(::google::protobuf::RpcController *controller,
+                              const ::octf::proto::CompactTraceRequest *request,
+                              ::octf::proto::TraceCompactionSummary *response,
+                              ::google::protobuf::Closure *done);
+
+    virtual void CompareTraces(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::CompareTracesRequest *request,
+            ::octf::proto::TraceComparison *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetTimeSeries(::google::protobuf::RpcController *controller,
+                               const ::octf::proto::TimeSeriesRequest *request,
+                               ::octf::proto::TimeSeries *response,
+                               ::google::protobuf::Closure *done);
+
+    virtual void ReplayTrace(::google::protobuf::RpcController *controller,
+                             const ::octf::proto::ReplayTraceRequest *request,
+                             ::octf::proto::TraceReplaySummary *response,
+                             ::google::protobuf::Closure *done);
+
+    virtual void GetCaptureAnalysis(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::CaptureAnalysisRequest *request,
+            ::octf::proto::CaptureAnalysis *response,
+            ::google::protobuf::Closure *done);
+
+    virtual void GetMarkerStatistics(
+            ::google::protobuf::RpcController *controller,
+            const ::octf::proto::MarkerStatisticsRequest *request,
+            ::octf::proto::MarkerStatistics *response,
+            ::google::protobuf::Closure *done);
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_INTERFACETRACEANALYTICSIMPL_H
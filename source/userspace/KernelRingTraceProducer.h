@@ -9,6 +9,7 @@
 #include <atomic>
 #include <memory>
 #include <octf/interface/IRingTraceProducer.h>
+#include "consumer/KernelTraceRing.h"
 
 namespace octf {
 
@@ -17,7 +18,8 @@ namespace octf {
  *
  * This producer allows reading traces produced in kernel,
  * and utilizes procfs files. Because of this, pushTrace method
- * is not used.
+ * is not used. Rings are mapped by KernelTraceRing, which is shared with
+ * the embeddable trace consumer.
  */
 class KernelRingTraceProducer : public IRingTraceProducer {
 public:
@@ -50,20 +52,7 @@ public:
     int pushTrace(const void *trace, const uint32_t traceSize) override;
 
 private:
-    struct MappedFile {
-        MappedFile(std::string path,
-                   int open_flags,
-                   int map_prot,
-                   uint64_t max_size);
-        ~MappedFile();
-
-        char *buffer;
-        int fd;
-        size_t length;
-    };
-
-    std::unique_ptr<struct MappedFile> m_ring, m_consumer_hdr;
-
+    std::unique_ptr<KernelTraceRing> m_ring;
     std::atomic<bool> m_stopped;
     int m_cpuId;
 };
@@ -0,0 +1,276 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "KernelTraceConverter.h"
+
+#include <cstring>
+#include <iotrace_marker.h>
+#include <octf/trace/iotrace_event.h>
+#include <octf/utils/Exception.h>
+#include <octf/utils/Log.h>
+
+namespace octf {
+
+static constexpr uint64_t NS_IN_SEC = 1000000000ULL;
+
+template <typename T>
+static const T *getKernelEvent(const char *trace, uint32_t size) {
+    if (size < sizeof(T)) {
+        throw Exception("Invalid trace event size");
+    }
+
+    return reinterpret_cast<const T *>(trace);
+}
+
+static proto::trace::IoType getIoType(uint32_t operation) {
+    switch (operation) {
+    case iotrace_event_operation_rd:
+        return proto::trace::IoType::Read;
+    case iotrace_event_operation_wr:
+        return proto::trace::IoType::Write;
+    case iotrace_event_operation_discard:
+        return proto::trace::IoType::Discard;
+    default:
+        return proto::trace::IoType::UnknownIoType;
+    }
+}
+
+static void setFileId(proto::trace::FileId *fileId,
+                      const struct iotrace_event_file_id &kernelId) {
+    fileId->set_id(kernelId.id);
+    fileId->set_creationdate(kernelId.ctime.tv_sec * NS_IN_SEC +
+                             kernelId.ctime.tv_nsec);
+}
+
+/**
+ * Classifies kernel IO the way parsed IOs are classified for latency
+ * statistics, flushes without data are reported separately
+ */
+static bool getRollupOperation(const struct iotrace_event &ev,
+                               LatencyOperation &operation) {
+    if ((ev.flags & iotrace_event_flag_flush) && !ev.len) {
+        operation = LatencyOperation::Flush;
+        return true;
+    }
+
+    switch (ev.operation) {
+    case iotrace_event_operation_rd:
+        operation = LatencyOperation::Read;
+        return true;
+    case iotrace_event_operation_wr:
+        operation = LatencyOperation::Write;
+        return true;
+    case iotrace_event_operation_discard:
+        operation = LatencyOperation::Discard;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void recordIo(TimeSeriesRecorder &recorder,
+                     const struct iotrace_event &ev) {
+    LatencyOperation operation;
+    if (getRollupOperation(ev, operation)) {
+        recorder.recordIo(ev.hdr.timestamp, ev.id, ev.dev_id, ev.len,
+                          operation);
+    }
+}
+
+static void recordCompletion(TimeSeriesRecorder &recorder,
+                             const struct iotrace_event_completion &ev) {
+    recorder.recordCompletion(ev.hdr.timestamp, ev.ref_id, ev.dev_id,
+                              ev.error != 0);
+}
+
+KernelTraceConverter::KernelTraceConverter()
+        : m_pool()
+        , m_recorder()
+        , m_analysis()
+        , m_markers()
+        , m_eventCount(0) {}
+
+KernelTraceConverter::KernelTraceConverter(
+        std::shared_ptr<TimeSeriesRollup> rollup,
+        std::shared_ptr<CaptureAnalysis> analysis,
+        std::shared_ptr<TraceMarkerLog> markers)
+        : m_pool()
+        , m_recorder(rollup ? new TimeSeriesRecorder(rollup) : nullptr)
+        , m_analysis(analysis ? new CaptureAnalysisQueue(analysis) : nullptr)
+        , m_markers(markers)
+        , m_eventCount(0) {}
+
+KernelTraceConverter::~KernelTraceConverter() {
+    log::verbose << "Converted " << m_eventCount << " trace events using "
+                 << m_pool.getAllocationCount() << " event messages"
+                 << std::endl;
+}
+
+std::shared_ptr<const google::protobuf::Message>
+KernelTraceConverter::convertTrace(const char *trace, uint32_t size) {
+    if (m_analysis) {
+        m_analysis->record(trace, size);
+    }
+
+    return convertEvent(trace, size);
+}
+
+std::shared_ptr<const google::protobuf::Message>
+KernelTraceConverter::convertEvent(const char *trace, uint32_t size) {
+    const auto *hdr = getKernelEvent<struct iotrace_event_hdr>(trace, size);
+    std::shared_ptr<proto::trace::Event> event;
+
+    switch (hdr->type) {
+    case iotrace_event_type_device_desc: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_device_desc>(trace, size);
+        event = m_pool.get(proto::trace::Event::kDeviceDescription);
+
+        auto desc = event->mutable_devicedescription();
+        desc->set_id(kernelEvent->id);
+        desc->set_size(kernelEvent->device_size);
+        desc->set_name(kernelEvent->device_name,
+                       strnlen(kernelEvent->device_name,
+                                       sizeof(kernelEvent->device_name)));
+        desc->set_model(kernelEvent->device_model,
+                        strnlen(kernelEvent->device_model,
+                                        sizeof(kernelEvent->device_model)));
+
+        if (m_recorder) {
+            m_recorder->recordDevice(desc->id(), desc->name());
+        }
+    } break;
+
+    case iotrace_event_type_io: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event>(trace, size);
+        event = m_pool.get(proto::trace::Event::kIo);
+
+        auto io = event->mutable_io();
+        io->set_id(kernelEvent->id);
+        io->set_lba(kernelEvent->lba);
+        io->set_len(kernelEvent->len);
+        io->set_ioclass(kernelEvent->io_class);
+        io->set_deviceid(kernelEvent->dev_id);
+        io->set_writehint(kernelEvent->write_hint);
+        io->set_flush(kernelEvent->flags & iotrace_event_flag_flush);
+        io->set_fua(kernelEvent->flags & iotrace_event_flag_fua);
+        io->set_operation(getIoType(kernelEvent->operation));
+
+        if (m_recorder) {
+            recordIo(*m_recorder, *kernelEvent);
+        }
+    } break;
+
+    case iotrace_event_type_io_cmpl: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_completion>(trace, size);
+        event = m_pool.get(proto::trace::Event::kIoCompletion);
+
+        auto completion = event->mutable_iocompletion();
+        completion->set_refid(kernelEvent->ref_id);
+        completion->set_lba(kernelEvent->lba);
+        completion->set_len(kernelEvent->len);
+        completion->set_error(kernelEvent->error != 0);
+        completion->set_deviceid(kernelEvent->dev_id);
+
+        if (m_recorder) {
+            recordCompletion(*m_recorder, *kernelEvent);
+        }
+    } break;
+
+    case iotrace_event_type_fs_meta: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_fs_meta>(trace, size);
+        event = m_pool.get(proto::trace::Event::kFilesystemMeta);
+
+        auto meta = event->mutable_filesystemmeta();
+        meta->set_refsid(kernelEvent->ref_sid);
+        setFileId(meta->mutable_fileid(), kernelEvent->file_id);
+        meta->set_fileoffset(kernelEvent->file_offset);
+        meta->set_filesize(kernelEvent->file_size);
+        meta->set_partitionid(kernelEvent->partition_id);
+    } break;
+
+    case iotrace_event_type_fs_file_name: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_fs_file_name>(trace, size);
+        event = m_pool.get(proto::trace::Event::kFilesystemFileName);
+
+        auto fileName = event->mutable_filesystemfilename();
+        fileName->set_partitionid(kernelEvent->partition_id);
+        setFileId(fileName->mutable_fileid(), kernelEvent->file_id);
+        setFileId(fileName->mutable_fileparentid(),
+                  kernelEvent->file_parent_id);
+        fileName->set_filename(kernelEvent->file_name,
+                               strnlen(kernelEvent->file_name,
+                                               sizeof(kernelEvent->file_name)));
+    } break;
+
+    case iotrace_event_type_fs_file_event: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_fs_file_event>(trace,
+                                                                   size);
+        event = m_pool.get(proto::trace::Event::kFilesystemFileEvent);
+
+        auto fileEvent = event->mutable_filesystemfileevent();
+        fileEvent->set_partitionid(kernelEvent->partition_id);
+        setFileId(fileEvent->mutable_fileid(), kernelEvent->file_id);
+
+        switch (kernelEvent->fs_event_type) {
+        case iotrace_fs_event_create:
+            fileEvent->set_fseventtype(proto::trace::FsEventType::Create);
+            break;
+        case iotrace_fs_event_delete:
+            fileEvent->set_fseventtype(proto::trace::FsEventType::Delete);
+            break;
+        case iotrace_fs_event_move_from:
+            fileEvent->set_fseventtype(proto::trace::FsEventType::MoveFrom);
+            break;
+        case iotrace_fs_event_move_to:
+            fileEvent->set_fseventtype(proto::trace::FsEventType::MoveTo);
+            break;
+        default:
+            throw Exception("Unknown file system event type");
+        }
+    } break;
+
+    case IOTRACE_EVENT_TYPE_MARKER: {
+        const auto *kernelEvent =
+                getKernelEvent<struct iotrace_event_marker>(trace, size);
+
+        // Trace events have no marker type, the header keeps the place of
+        // the marker in the trace
+        event = m_pool.get(proto::trace::Event::EVENTTYPE_NOT_SET);
+
+        if (m_markers) {
+            m_markers->add(hdr->sid, hdr->timestamp,
+                           std::string(kernelEvent->text,
+                                       strnlen(kernelEvent->text,
+                                               sizeof(kernelEvent->text))));
+        }
+    } break;
+
+    default:
+        throw Exception("Unknown trace event type");
+    }
+
+    auto header = event->mutable_header();
+    header->set_sid(hdr->sid);
+    header->set_timestamp(hdr->timestamp);
+
+    m_eventCount++;
+    return event;
+}
+
+uint64_t KernelTraceConverter::getEventCount() const {
+    return m_eventCount;
+}
+
+uint64_t KernelTraceConverter::getAllocationCount() const {
+    return m_pool.getAllocationCount();
+}
+
+}  // namespace octf
@@ -0,0 +1,77 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_KERNELTRACECONVERTER_H
+#define SOURCE_USERSPACE_KERNELTRACECONVERTER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <octf/interface/ITraceConverter.h>
+#include <octf/proto/trace.pb.h>
+#include "analytics/CaptureAnalysis.h"
+#include "analytics/EventMessagePool.h"
+#include "analytics/TimeSeriesRollup.h"
+#include "analytics/TraceMarkerLog.h"
+
+namespace octf {
+
+/**
+ * @brief Converts kernel trace events into trace event messages
+ *
+ * Messages are recycled from a pool as soon as the serializer releases
+ * them, so converting an event does not allocate in steady state.
+ *
+ * When given a time series rollup, converted IOs and completions are
+ * recorded into it, so per interval statistics are ready when capture ends.
+ * Likewise, when given a capture analysis, all converted events are fed
+ * into states of its analyzers owned by this converter.
+ *
+ * User markers are kept in the trace as events with header only, their
+ * texts are added to the marker log when given.
+ */
+class KernelTraceConverter : public ITraceConverter {
+public:
+    KernelTraceConverter();
+
+    /**
+     * @param rollup Time series rollup shared by converters of all queues,
+     * may be nullptr
+     * @param analysis Capture analysis shared by converters of all queues,
+     * may be nullptr
+     * @param markers Marker log shared by converters of all queues, may be
+     * nullptr
+     */
+    KernelTraceConverter(std::shared_ptr<TimeSeriesRollup> rollup,
+                         std::shared_ptr<CaptureAnalysis> analysis,
+                         std::shared_ptr<TraceMarkerLog> markers);
+    virtual ~KernelTraceConverter();
+
+    std::shared_ptr<const google::protobuf::Message> convertTrace(
+            const char *trace,
+            uint32_t size) override;
+
+    uint64_t getEventCount() const;
+
+    /**
+     * @return Number of event messages allocated for conversion
+     */
+    uint64_t getAllocationCount() const;
+
+private:
+    std::shared_ptr<const google::protobuf::Message> convertEvent(
+            const char *trace,
+            uint32_t size);
+
+    EventMessagePool m_pool;
+    std::unique_ptr<TimeSeriesRecorder> m_recorder;
+    std::unique_ptr<CaptureAnalysisQueue> m_analysis;
+    std::shared_ptr<TraceMarkerLog> m_markers;
+    uint64_t m_eventCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_KERNELTRACECONVERTER_H
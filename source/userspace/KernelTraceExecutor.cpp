@@ -5,15 +5,17 @@
 
 #include "KernelTraceExecutor.h"
 
-#include <octf/interface/TraceConverter.h>
 #include <octf/trace/iotrace_event.h>
 #include <octf/utils/Exception.h>
 #include <octf/utils/Log.h>
 #include <octf/utils/SignalHandler.h>
+#include <fcntl.h>
 #include <procfs_files.h>
+#include <unistd.h>
 #include <fstream>
 #include <thread>
 #include "KernelRingTraceProducer.h"
+#include "KernelTraceConverter.h"
 
 namespace octf {
 
@@ -21,7 +23,13 @@ KernelTraceExecutor::KernelTraceExecutor(
         const std::vector<std::string> &devices,
         uint32_t ringSizeMiB)
         : m_devices(devices)
-        , m_startedDevices() {
+        , m_startedDevices()
+        , m_traceStopped(false)
+        , m_keepDevices(false)
+        , m_bufferFd(-1)
+        , m_rollup()
+        , m_analysis()
+        , m_markers() {
     if (!isKernelModuleLoaded()) {
         throw Exception("Kernel tracing module is not loaded.");
     }
@@ -37,7 +45,26 @@ KernelTraceExecutor::KernelTraceExecutor(
     }
 }
 
+KernelTraceExecutor::~KernelTraceExecutor() {
+    stopDevices();
+}
+
 bool KernelTraceExecutor::startTrace() {
+    m_traceStopped = false;
+
+    if (!m_startedDevices.empty()) {
+        // Devices are still traced since the previous segment
+        if (!writeSatraceProcfs(IOTRACE_PROCFS_DESCRIBE_DEVICES_FILE_NAME,
+                                "1")) {
+            stopDevices();
+            SignalHandler::get().sendSignal(SIGTERM);
+            throw Exception("Cannot describe traced devices");
+        }
+
+        log::verbose << "Tracing continued" << std::endl;
+        return true;
+    }
+
     for (const auto &dev : m_devices) {
         if (writeSatraceProcfs(IOTRACE_PROCFS_ADD_DEVICE_FILE_NAME, dev)) {
             m_startedDevices.push_back(dev);
@@ -49,11 +76,23 @@ bool KernelTraceExecutor::startTrace() {
         }
     }
 
+    if (m_keepDevices) {
+        holdTraceBuffers();
+    }
+
     return true;
 }
 
 bool KernelTraceExecutor::stopTrace() {
-    stopDevices();
+    if (m_traceStopped) {
+        // Do not signal again, it would interrupt the next trace segment
+        return true;
+    }
+    m_traceStopped = true;
+
+    if (!m_keepDevices) {
+        stopDevices();
+    }
     SignalHandler::get().sendSignal(SIGTERM);
     return true;
 }
@@ -69,7 +108,8 @@ std::unique_ptr<IRingTraceProducer> KernelTraceExecutor::createProducer(
 }
 
 std::unique_ptr<ITraceConverter> KernelTraceExecutor::createTraceConverter() {
-    return std::unique_ptr<TraceConverter>(new TraceConverter());
+    return std::unique_ptr<ITraceConverter>(
+            new KernelTraceConverter(m_rollup, m_analysis, m_markers));
 }
 
 bool KernelTraceExecutor::isKernelModuleLoaded() {
@@ -144,6 +184,29 @@ void KernelTraceExecutor::waitUntilStopTrace() {
     SignalHandler::get().wait();
 }
 
+bool KernelTraceExecutor::isTraceStopped() const {
+    return m_traceStopped;
+}
+
+void KernelTraceExecutor::setTimeSeriesRollup(
+        std::shared_ptr<TimeSeriesRollup> rollup) {
+    m_rollup = rollup;
+}
+
+void KernelTraceExecutor::setCaptureAnalysis(
+        std::shared_ptr<CaptureAnalysis> analysis) {
+    m_analysis = analysis;
+}
+
+void KernelTraceExecutor::setTraceMarkerLog(
+        std::shared_ptr<TraceMarkerLog> markers) {
+    m_markers = markers;
+}
+
+void KernelTraceExecutor::setKeepDevices(bool keep) {
+    m_keepDevices = keep;
+}
+
 void KernelTraceExecutor::stopDevices() {
     for (const auto &dev : m_startedDevices) {
         if (writeSatraceProcfs(IOTRACE_PROCFS_REMOVE_DEVICE_FILE_NAME, dev)) {
@@ -153,6 +216,27 @@ void KernelTraceExecutor::stopDevices() {
         }
     }
     m_startedDevices.clear();
+
+    if (m_bufferFd != -1) {
+        close(m_bufferFd);
+        m_bufferFd = -1;
+    }
+}
+
+void KernelTraceExecutor::holdTraceBuffers() {
+    if (m_bufferFd != -1) {
+        return;
+    }
+
+    // Buffer of the first CPU, any open buffer keeps devices traced
+    std::string path = std::string(IOTRACE_PROCFS_DIR) +
+                       IOTRACE_PROCFS_TRACE_FILE_PREFIX + "0";
+    m_bufferFd = open(path.c_str(), O_RDONLY);
+    if (m_bufferFd == -1) {
+        stopDevices();
+        SignalHandler::get().sendSignal(SIGTERM);
+        throw Exception("Cannot open trace buffer " + path);
+    }
 }
 
 }  // namespace octf
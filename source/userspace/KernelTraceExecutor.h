@@ -6,10 +6,15 @@
 #ifndef SOURCE_USERSPACE_KERNELTRACEEXECUTOR_H
 #define SOURCE_USERSPACE_KERNELTRACEEXECUTOR_H
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <octf/interface/ITraceExecutor.h>
+#include "analytics/CaptureAnalysis.h"
+#include "analytics/TimeSeriesRollup.h"
+#include "analytics/TraceMarkerLog.h"
 
 namespace octf {
 
@@ -27,7 +32,10 @@ public:
     KernelTraceExecutor(const std::vector<std::string> &devices,
                         uint32_t circBufferSize);
 
-    virtual ~KernelTraceExecutor() = default;
+    /**
+     * @note Stops tracing of devices
+     */
+    virtual ~KernelTraceExecutor();
 
     bool startTrace() override;
 
@@ -44,6 +52,45 @@ public:
      */
     void waitUntilStopTrace();
 
+    /**
+     * @brief Checks if tracing has been stopped by trace manager, e.g. when
+     * trace limits are reached, rather than interrupted by user
+     */
+    bool isTraceStopped() const;
+
+    /**
+     * @brief Keeps devices traced when a trace stops, so that the next
+     * segment of a rotated capture misses no IO
+     *
+     * Kernel module stops tracing of all devices once its trace buffers are
+     * not used, so the executor keeps one of them open meanwhile. A trace
+     * started later begins with descriptions of the kept devices.
+     */
+    void setKeepDevices(bool keep);
+
+    /**
+     * @brief Stops tracing of devices, also the kept ones
+     */
+    void stopDevices();
+
+    /**
+     * @brief Sets time series rollup fed by converters created from now on,
+     * nullptr disables rollups
+     */
+    void setTimeSeriesRollup(std::shared_ptr<TimeSeriesRollup> rollup);
+
+    /**
+     * @brief Sets capture analysis fed by converters created from now on,
+     * nullptr disables analyzers
+     */
+    void setCaptureAnalysis(std::shared_ptr<CaptureAnalysis> analysis);
+
+    /**
+     * @brief Sets marker log fed by converters created from now on, nullptr
+     * drops texts of markers
+     */
+    void setTraceMarkerLog(std::shared_ptr<TraceMarkerLog> markers);
+
     /**
      * @brief Checks if IO tracer Linux kernel module is loaded
      *
@@ -57,10 +104,17 @@ private:
 
     bool writeSatraceProcfs(std::string file, const std::string &text);
 
-    void stopDevices();
+    void holdTraceBuffers();
 
     std::vector<std::string> m_devices;
     std::list<std::string> m_startedDevices;
+    std::atomic<bool> m_traceStopped;
+    bool m_keepDevices;
+    /** Trace buffer kept open while devices are kept traced */
+    int m_bufferFd;
+    std::shared_ptr<TimeSeriesRollup> m_rollup;
+    std::shared_ptr<CaptureAnalysis> m_analysis;
+    std::shared_ptr<TraceMarkerLog> m_markers;
 };
 
 }  // namespace octf
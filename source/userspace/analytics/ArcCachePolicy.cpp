@@ -0,0 +1,160 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ArcCachePolicy.h"
+#include <algorithm>
+
+namespace octf {
+
+constexpr const char *ArcCachePolicy::NAME;
+
+ArcCachePolicy::ArcCachePolicy(uint64_t capacity, CacheMode mode)
+        : CachePolicy(capacity, mode)
+        , m_target(0)
+        , m_table(2 * capacity)
+        , m_pool(2 * capacity)
+        , m_lists() {}
+
+bool ArcCachePolicy::reference(uint64_t key, bool dirty) {
+    auto &t1 = m_lists[T1];
+    auto &t2 = m_lists[T2];
+    auto &b1 = m_lists[B1];
+    auto &b2 = m_lists[B2];
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        auto &node = m_pool[index];
+
+        switch (node.list) {
+        case T1:
+        case T2:
+            // Case I - cache hit, line becomes frequently used
+            m_pool.remove(m_lists[node.list], index);
+            m_pool.pushFront(t2, T2, index);
+            node.dirty |= dirty;
+            return true;
+
+        case B1: {
+            // Case II - recency ghost hit, favour T1
+            uint64_t delta = std::max<uint64_t>(b2.size / b1.size, 1);
+            m_target = std::min(m_capacity, m_target + delta);
+            replace(false);
+            m_pool.remove(b1, index);
+        } break;
+
+        default: {
+            // Case III - frequency ghost hit, favour T2
+            uint64_t delta = std::max<uint64_t>(b1.size / b2.size, 1);
+            m_target = m_target > delta ? m_target - delta : 0;
+            replace(true);
+            m_pool.remove(b2, index);
+        } break;
+        }
+
+        node.dirty = dirty;
+        m_pool.pushFront(t2, T2, index);
+        return false;
+    }
+
+    // Case IV - line not known at all
+    if (t1.size + b1.size >= m_capacity) {
+        if (t1.size < m_capacity) {
+            drop(b1.tail);
+            replace(false);
+        } else {
+            uint32_t victim = t1.tail;
+            evicted(m_pool[victim].dirty);
+            drop(victim);
+        }
+    } else {
+        uint64_t total = t1.size + t2.size + b1.size + b2.size;
+        if (total >= m_capacity) {
+            if (total >= 2 * m_capacity && b2.size) {
+                drop(b2.tail);
+            }
+            replace(false);
+        }
+    }
+
+    index = m_pool.allocate(key);
+    m_pool[index].dirty = dirty;
+    m_pool.pushFront(t1, T1, index);
+    m_table.insert(key, index);
+
+    return false;
+}
+
+void ArcCachePolicy::replace(bool inB2) {
+    auto &t1 = m_lists[T1];
+    auto &t2 = m_lists[T2];
+
+    if (t1.size + t2.size < m_capacity) {
+        // Free space left after invalidation, nothing to evict
+        return;
+    }
+
+    uint32_t victim;
+    uint8_t ghost;
+    if (t1.size &&
+        (t1.size > m_target || (inB2 && t1.size == m_target) || !t2.size)) {
+        victim = t1.tail;
+        m_pool.remove(t1, victim);
+        ghost = B1;
+    } else {
+        victim = t2.tail;
+        m_pool.remove(t2, victim);
+        ghost = B2;
+    }
+
+    evicted(m_pool[victim].dirty);
+    m_pool[victim].dirty = false;
+    m_pool.pushFront(m_lists[ghost], ghost, victim);
+}
+
+void ArcCachePolicy::drop(uint32_t index) {
+    auto &node = m_pool[index];
+
+    m_table.erase(node.key);
+    m_pool.remove(m_lists[node.list], index);
+    m_pool.release(index);
+}
+
+void ArcCachePolicy::invalidate(uint64_t key) {
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        drop(index);
+    }
+}
+
+uint64_t ArcCachePolicy::getTrackedCount() const {
+    return m_table.size();
+}
+
+void ArcCachePolicy::invalidateTracked(uint64_t first, uint64_t last) {
+    for (auto &list : m_lists) {
+        uint32_t index = list.head;
+
+        while (index != CacheNodePool::NONE) {
+            uint32_t next = m_pool[index].next;
+            uint64_t key = m_pool[index].key;
+
+            if (key >= first && key <= last) {
+                drop(index);
+            }
+            index = next;
+        }
+    }
+}
+
+const char *ArcCachePolicy::getName() const {
+    return NAME;
+}
+
+uint64_t ArcCachePolicy::getMemoryUsage() const {
+    return m_table.getMemoryUsage() + m_pool.getMemoryUsage();
+}
+
+}  // namespace octf
@@ -0,0 +1,66 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_ARCCACHEPOLICY_H
+#define SOURCE_USERSPACE_ANALYTICS_ARCCACHEPOLICY_H
+
+#include "CachePolicy.h"
+
+namespace octf {
+
+/**
+ * @brief Adaptive replacement cache policy (by N. Megiddo and D. Modha)
+ *
+ * Resident lines are kept in T1 (seen once recently) and T2 (seen at least
+ * twice). Keys of lines evicted from them are remembered in ghost lists B1 and
+ * B2, hits in ghost lists adapt the target size of T1.
+ */
+class ArcCachePolicy : public CachePolicy {
+public:
+    static constexpr const char *NAME = "arc";
+
+    ArcCachePolicy(uint64_t capacity, CacheMode mode);
+    virtual ~ArcCachePolicy() = default;
+
+    void invalidate(uint64_t key) override;
+
+    const char *getName() const override;
+
+    uint64_t getMemoryUsage() const override;
+
+protected:
+    bool reference(uint64_t key, bool dirty) override;
+
+    uint64_t getTrackedCount() const override;
+
+    void invalidateTracked(uint64_t first, uint64_t last) override;
+
+private:
+    enum ListId : uint8_t {
+        T1 = 0,
+        T2,
+        B1,
+        B2,
+        LIST_COUNT,
+    };
+
+    /**
+     * @brief Evicts resident line into ghost list
+     *
+     * @param inB2 Referenced line has been found in B2
+     */
+    void replace(bool inB2);
+
+    void drop(uint32_t index);
+
+    uint64_t m_target;
+    CacheLineTable m_table;
+    CacheNodePool m_pool;
+    CacheNodePool::List m_lists[LIST_COUNT];
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_ARCCACHEPOLICY_H
@@ -0,0 +1,153 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_BATCHBROADCASTER_H
+#define SOURCE_USERSPACE_ANALYTICS_BATCHBROADCASTER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Delivers every published batch to all consumers
+ *
+ * A single producer publishes immutable batches, each of a fixed number of
+ * consumers receives all of them in order. Batches are released as soon as
+ * the slowest consumer is done with them. Producer blocks when the slowest
+ * consumer is more than queueLimit batches behind, which bounds memory usage.
+ */
+template <typename Batch>
+class BatchBroadcaster {
+public:
+    typedef std::shared_ptr<const Batch> BatchShRef;
+
+    BatchBroadcaster(uint32_t consumerCount, uint32_t queueLimit)
+            : m_mutex()
+            , m_cv()
+            , m_batches()
+            , m_firstSeq(0)
+            , m_consumed(consumerCount, 0)
+            , m_queueLimit(queueLimit ? queueLimit : 1)
+            , m_closed(false) {}
+
+    /**
+     * @brief Publishes batch to all consumers, blocks if queue is full
+     */
+    void publish(BatchShRef batch) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_cv.wait(lock, [this]() { return m_batches.size() < m_queueLimit; });
+        m_batches.push_back(std::move(batch));
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief Marks end of the stream, consumers get remaining batches and
+     * then next() returns false
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief Gets next batch for the consumer
+     *
+     * @param consumer Consumer index
+     * @param[out] batch Next batch
+     *
+     * @retval true Batch received
+     * @retval false Stream closed and all batches consumed
+     */
+    bool next(uint32_t consumer, BatchShRef &batch) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        done(consumer, batch);
+
+        m_cv.wait(lock, [this, consumer]() {
+            return m_closed || m_consumed[consumer] < lastSeq();
+        });
+
+        if (m_consumed[consumer] >= lastSeq()) {
+            return false;
+        }
+
+        batch = m_batches[m_consumed[consumer] - m_firstSeq];
+        return true;
+    }
+
+    /**
+     * @brief Gets next batch for the consumer if it is already published
+     *
+     * @param consumer Consumer index
+     * @param[out] batch Next batch, null when none is available
+     * @param[out] closed Stream closed and all batches consumed
+     *
+     * @retval true Batch received
+     * @retval false No batch available now
+     */
+    bool tryNext(uint32_t consumer, BatchShRef &batch, bool &closed) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        done(consumer, batch);
+
+        closed = m_closed && m_consumed[consumer] >= lastSeq();
+        if (m_consumed[consumer] >= lastSeq()) {
+            return false;
+        }
+
+        batch = m_batches[m_consumed[consumer] - m_firstSeq];
+        return true;
+    }
+
+private:
+    void done(uint32_t consumer, BatchShRef &batch) {
+        if (batch) {
+            // Previous batch processed
+            batch.reset();
+            m_consumed[consumer]++;
+            release();
+        }
+    }
+
+    uint64_t lastSeq() const {
+        return m_firstSeq + m_batches.size();
+    }
+
+    void release() {
+        uint64_t minConsumed =
+                *std::min_element(m_consumed.begin(), m_consumed.end());
+
+        bool released = false;
+        while (m_firstSeq < minConsumed) {
+            m_batches.pop_front();
+            m_firstSeq++;
+            released = true;
+        }
+
+        if (released) {
+            m_cv.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<BatchShRef> m_batches;
+    uint64_t m_firstSeq;
+    std::vector<uint64_t> m_consumed;
+    const uint64_t m_queueLimit;
+    bool m_closed;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_BATCHBROADCASTER_H
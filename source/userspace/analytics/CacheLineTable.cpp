@@ -0,0 +1,106 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CacheLineTable.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint64_t CacheLineTable::EMPTY_KEY;
+constexpr uint32_t CacheLineTable::INVALID_VALUE;
+
+CacheLineTable::CacheLineTable(uint64_t maxEntries)
+        : m_keys()
+        , m_values()
+        , m_mask(0)
+        , m_size(0)
+        , m_maxEntries(maxEntries) {
+    // Keep load factor at most 50%, linear probing degrades above it
+    uint64_t slots = 16;
+    while (slots < maxEntries * 2) {
+        slots <<= 1;
+    }
+
+    m_keys.assign(slots, EMPTY_KEY);
+    m_values.assign(slots, INVALID_VALUE);
+    m_mask = slots - 1;
+}
+
+uint32_t CacheLineTable::find(uint64_t key) const {
+    uint64_t slot = slotOf(key);
+
+    while (m_keys[slot] != EMPTY_KEY) {
+        if (m_keys[slot] == key) {
+            return m_values[slot];
+        }
+        slot = (slot + 1) & m_mask;
+    }
+
+    return INVALID_VALUE;
+}
+
+void CacheLineTable::insert(uint64_t key, uint32_t value) {
+    uint64_t slot = slotOf(key);
+
+    while (m_keys[slot] != EMPTY_KEY) {
+        if (m_keys[slot] == key) {
+            m_values[slot] = value;
+            return;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+
+    if (m_size >= m_maxEntries) {
+        throw Exception("Cache line table is full");
+    }
+
+    m_keys[slot] = key;
+    m_values[slot] = value;
+    m_size++;
+}
+
+bool CacheLineTable::erase(uint64_t key) {
+    uint64_t slot = slotOf(key);
+
+    while (m_keys[slot] != key) {
+        if (m_keys[slot] == EMPTY_KEY) {
+            return false;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+
+    // Backward shift deletion - move following entries of the probe sequence
+    // into the hole, if it doesn't move them before their home slot
+    uint64_t hole = slot;
+    uint64_t next = (hole + 1) & m_mask;
+    while (m_keys[next] != EMPTY_KEY) {
+        uint64_t home = slotOf(m_keys[next]);
+        uint64_t distanceToNext = (next - home) & m_mask;
+        uint64_t distanceToHole = (hole - home) & m_mask;
+
+        if (distanceToHole < distanceToNext) {
+            m_keys[hole] = m_keys[next];
+            m_values[hole] = m_values[next];
+            hole = next;
+        }
+        next = (next + 1) & m_mask;
+    }
+
+    m_keys[hole] = EMPTY_KEY;
+    m_values[hole] = INVALID_VALUE;
+    m_size--;
+
+    return true;
+}
+
+uint64_t CacheLineTable::size() const {
+    return m_size;
+}
+
+uint64_t CacheLineTable::getMemoryUsage() const {
+    return m_keys.size() * (sizeof(uint64_t) + sizeof(uint32_t));
+}
+
+}  // namespace octf
@@ -0,0 +1,85 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CACHELINETABLE_H
+#define SOURCE_USERSPACE_ANALYTICS_CACHELINETABLE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Mixes bits of 64-bit value (MurmurHash3 finalizer)
+ */
+inline uint64_t hashMix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Fixed capacity hash map from cache line key to 32-bit index
+ *
+ * The table uses open addressing with linear probing and backward shift
+ * deletion, so no tombstones are left behind. Keys and values are kept in
+ * separate arrays to keep probing within as few cache lines as possible.
+ *
+ * @note Key ~0 is reserved as an empty slot marker
+ */
+class CacheLineTable {
+public:
+    static constexpr uint64_t EMPTY_KEY = ~0ULL;
+    static constexpr uint32_t INVALID_VALUE = ~0U;
+
+    /**
+     * @param maxEntries Maximum number of entries kept in table at once
+     */
+    explicit CacheLineTable(uint64_t maxEntries);
+
+    /**
+     * @return Value mapped to the key or INVALID_VALUE if there is no mapping
+     */
+    uint32_t find(uint64_t key) const;
+
+    /**
+     * @brief Maps key to the value, replaces existing mapping
+     *
+     * @throw Exception when the table is full
+     */
+    void insert(uint64_t key, uint32_t value);
+
+    /**
+     * @brief Removes mapping of the key
+     *
+     * @return true if key has been mapped, false otherwise
+     */
+    bool erase(uint64_t key);
+
+    uint64_t size() const;
+
+    /**
+     * @return Number of bytes occupied by the table
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    uint64_t slotOf(uint64_t key) const {
+        return hashMix64(key) & m_mask;
+    }
+
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_values;
+    uint64_t m_mask;
+    uint64_t m_size;
+    uint64_t m_maxEntries;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CACHELINETABLE_H
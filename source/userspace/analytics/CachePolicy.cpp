@@ -0,0 +1,224 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CachePolicy.h"
+#include <octf/utils/Exception.h>
+#include "ArcCachePolicy.h"
+#include "LruCachePolicy.h"
+#include "TwoQueueCachePolicy.h"
+
+namespace octf {
+
+constexpr uint32_t CacheNodePool::NONE;
+constexpr uint64_t CachePolicy::MAX_CAPACITY;
+
+const char *getCacheModeName(CacheMode mode) {
+    switch (mode) {
+    case CacheMode::WriteBack:
+        return "wb";
+    case CacheMode::WriteThrough:
+        return "wt";
+    default:
+        return "unknown";
+    }
+}
+
+CacheNodePool::CacheNodePool(uint32_t capacity)
+        : m_nodes(capacity)
+        , m_free(NONE) {
+    // Chain all nodes into free list
+    for (uint32_t i = capacity; i > 0; i--) {
+        m_nodes[i - 1].next = m_free;
+        m_free = i - 1;
+    }
+}
+
+uint32_t CacheNodePool::allocate(uint64_t key) {
+    uint32_t index = m_free;
+
+    if (index != NONE) {
+        Node &node = m_nodes[index];
+        m_free = node.next;
+
+        node.key = key;
+        node.prev = NONE;
+        node.next = NONE;
+        node.list = 0;
+        node.dirty = false;
+    }
+
+    return index;
+}
+
+void CacheNodePool::release(uint32_t index) {
+    m_nodes[index].next = m_free;
+    m_free = index;
+}
+
+void CacheNodePool::pushFront(List &list, uint8_t listId, uint32_t index) {
+    Node &node = m_nodes[index];
+
+    node.list = listId;
+    node.prev = NONE;
+    node.next = list.head;
+
+    if (list.head != NONE) {
+        m_nodes[list.head].prev = index;
+    } else {
+        list.tail = index;
+    }
+
+    list.head = index;
+    list.size++;
+}
+
+void CacheNodePool::remove(List &list, uint32_t index) {
+    Node &node = m_nodes[index];
+
+    if (node.prev != NONE) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        list.head = node.next;
+    }
+
+    if (node.next != NONE) {
+        m_nodes[node.next].prev = node.prev;
+    } else {
+        list.tail = node.prev;
+    }
+
+    node.prev = NONE;
+    node.next = NONE;
+    list.size--;
+}
+
+void CacheNodePool::moveToFront(List &list, uint32_t index) {
+    if (list.head == index) {
+        return;
+    }
+
+    uint8_t listId = m_nodes[index].list;
+    remove(list, index);
+    pushFront(list, listId, index);
+}
+
+uint64_t CacheNodePool::getMemoryUsage() const {
+    return m_nodes.size() * sizeof(Node);
+}
+
+CachePolicy::CachePolicy(uint64_t capacity, CacheMode mode)
+        : m_capacity(capacity)
+        , m_mode(mode)
+        , m_stats() {
+    if (!m_capacity || m_capacity > MAX_CAPACITY) {
+        throw Exception("Invalid cache capacity");
+    }
+}
+
+void CachePolicy::read(uint64_t key) {
+    m_stats.readAccesses++;
+    if (reference(key, false)) {
+        m_stats.readHits++;
+    }
+}
+
+void CachePolicy::write(uint64_t key) {
+    bool writeBack = m_mode == CacheMode::WriteBack;
+
+    m_stats.writeAccesses++;
+    if (reference(key, writeBack)) {
+        m_stats.writeHits++;
+    }
+
+    if (!writeBack) {
+        m_stats.coreWrites++;
+    }
+}
+
+void CachePolicy::readRange(uint64_t key, uint64_t count) {
+    if (count > m_capacity) {
+        uint64_t bypassed = count - m_capacity;
+
+        m_stats.readAccesses += bypassed;
+        key += bypassed;
+        count = m_capacity;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        read(key + i);
+    }
+}
+
+void CachePolicy::writeRange(uint64_t key, uint64_t count) {
+    if (count > m_capacity) {
+        uint64_t bypassed = count - m_capacity;
+
+        // Written directly to core, cached copies become stale
+        invalidateRange(key, bypassed);
+        m_stats.writeAccesses += bypassed;
+        m_stats.coreWrites += bypassed;
+        key += bypassed;
+        count = m_capacity;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        write(key + i);
+    }
+}
+
+void CachePolicy::invalidateRange(uint64_t key, uint64_t count) {
+    if (count > getTrackedCount()) {
+        // E.g. discard of whole device, walk lines in cache instead
+        invalidateTracked(key, key + count - 1);
+        return;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        invalidate(key + i);
+    }
+}
+
+void CachePolicy::evicted(bool dirty) {
+    m_stats.evictions++;
+    if (dirty) {
+        m_stats.coreWrites++;
+    }
+}
+
+uint64_t CachePolicy::getCapacity() const {
+    return m_capacity;
+}
+
+CacheMode CachePolicy::getMode() const {
+    return m_mode;
+}
+
+const CacheStatistics &CachePolicy::getStatistics() const {
+    return m_stats;
+}
+
+std::unique_ptr<CachePolicy> createCachePolicy(const std::string &name,
+                                               uint64_t capacity,
+                                               CacheMode mode) {
+    if (name == LruCachePolicy::NAME) {
+        return std::unique_ptr<CachePolicy>(
+                new LruCachePolicy(capacity, mode));
+    } else if (name == TwoQueueCachePolicy::NAME) {
+        return std::unique_ptr<CachePolicy>(
+                new TwoQueueCachePolicy(capacity, mode));
+    } else if (name == ArcCachePolicy::NAME) {
+        return std::unique_ptr<CachePolicy>(
+                new ArcCachePolicy(capacity, mode));
+    }
+
+    throw Exception("Unknown cache policy: " + name);
+}
+
+std::vector<std::string> getCachePolicyNames() {
+    return {LruCachePolicy::NAME, TwoQueueCachePolicy::NAME,
+            ArcCachePolicy::NAME};
+}
+
+}  // namespace octf
@@ -0,0 +1,233 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CACHEPOLICY_H
+#define SOURCE_USERSPACE_ANALYTICS_CACHEPOLICY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+/**
+ * @brief Write handling mode of simulated cache
+ */
+enum class CacheMode {
+    /** Writes are inserted dirty, core is written on dirty line eviction */
+    WriteBack,
+
+    /** Writes are inserted clean and always written to core */
+    WriteThrough,
+};
+
+const char *getCacheModeName(CacheMode mode);
+
+/**
+ * @brief Counters of simulated cache, in cache lines
+ */
+struct CacheStatistics {
+    uint64_t readAccesses;
+    uint64_t readHits;
+    uint64_t writeAccesses;
+    uint64_t writeHits;
+    uint64_t evictions;
+    uint64_t coreWrites;
+};
+
+/**
+ * @brief Pool of cache metadata nodes linked into intrusive lists
+ *
+ * Nodes are addressed by 32-bit indexes, so list links take 8 bytes per node.
+ */
+class CacheNodePool {
+public:
+    static constexpr uint32_t NONE = ~0U;
+
+    struct Node {
+        uint64_t key;
+        uint32_t prev;
+        uint32_t next;
+        uint8_t list;
+        bool dirty;
+    };
+
+    struct List {
+        List()
+                : head(NONE)
+                , tail(NONE)
+                , size(0) {}
+
+        uint32_t head;
+        uint32_t tail;
+        uint64_t size;
+    };
+
+    explicit CacheNodePool(uint32_t capacity);
+
+    /**
+     * @return Index of allocated node, NONE if pool is exhausted
+     */
+    uint32_t allocate(uint64_t key);
+
+    void release(uint32_t index);
+
+    Node &operator[](uint32_t index) {
+        return m_nodes[index];
+    }
+
+    void pushFront(List &list, uint8_t listId, uint32_t index);
+
+    void remove(List &list, uint32_t index);
+
+    /**
+     * @brief Moves node to the front of the list it belongs to
+     */
+    void moveToFront(List &list, uint32_t index);
+
+    uint64_t getMemoryUsage() const;
+
+private:
+    std::vector<Node> m_nodes;
+    uint32_t m_free;
+};
+
+/**
+ * @brief Base of simulated cache eviction policies
+ *
+ * Cache content is tracked at cache line granularity. Cache line is
+ * identified by 64-bit key unique across traced devices.
+ */
+class CachePolicy {
+public:
+    /**
+     * Maximum capacity in cache lines, policies keep up to twice as many
+     * nodes (including ghost entries) addressed by 32-bit indexes
+     */
+    static constexpr uint64_t MAX_CAPACITY = 1ULL << 31;
+
+    /**
+     * @param capacity Cache capacity in cache lines
+     * @param mode Cache write mode
+     */
+    CachePolicy(uint64_t capacity, CacheMode mode);
+    virtual ~CachePolicy() = default;
+
+    /**
+     * @brief Reads cache line
+     */
+    void read(uint64_t key);
+
+    /**
+     * @brief Writes cache line
+     */
+    void write(uint64_t key);
+
+    /**
+     * @brief Reads range of cache lines
+     *
+     * Range longer than the cache bypasses it, only its last capacity lines
+     * are read through the cache, preceding ones are accounted as misses.
+     *
+     * @param key Key of the first cache line
+     * @param count Number of cache lines
+     */
+    void readRange(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Writes range of cache lines
+     *
+     * Range longer than the cache bypasses it, only its last capacity lines
+     * are written through the cache, preceding ones are accounted as misses
+     * written to core and their cached copies are invalidated.
+     *
+     * @param key Key of the first cache line
+     * @param count Number of cache lines
+     */
+    void writeRange(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Removes cache line from cache (e.g. on discard), dirty data is
+     * dropped without core write
+     */
+    virtual void invalidate(uint64_t key) = 0;
+
+    /**
+     * @brief Removes range of cache lines from cache, in time bounded by the
+     * number of lines tracked by the policy
+     *
+     * @param key Key of the first cache line
+     * @param count Number of cache lines
+     */
+    void invalidateRange(uint64_t key, uint64_t count);
+
+    /**
+     * @return Name of eviction policy
+     */
+    virtual const char *getName() const = 0;
+
+    /**
+     * @return Number of bytes of policy metadata
+     */
+    virtual uint64_t getMemoryUsage() const = 0;
+
+    uint64_t getCapacity() const;
+
+    CacheMode getMode() const;
+
+    const CacheStatistics &getStatistics() const;
+
+protected:
+    /**
+     * @brief References cache line, inserts it into cache on miss
+     *
+     * @param key Cache line key
+     * @param dirty Mark line as dirty
+     *
+     * @return true on cache hit, false otherwise
+     */
+    virtual bool reference(uint64_t key, bool dirty) = 0;
+
+    /**
+     * @return Number of lines tracked by policy, including ghost entries
+     */
+    virtual uint64_t getTrackedCount() const = 0;
+
+    /**
+     * @brief Removes every tracked line with key in range [first, last]
+     */
+    virtual void invalidateTracked(uint64_t first, uint64_t last) = 0;
+
+    /**
+     * @brief Accounts eviction of resident cache line
+     */
+    void evicted(bool dirty);
+
+    const uint64_t m_capacity;
+
+private:
+    const CacheMode m_mode;
+    CacheStatistics m_stats;
+};
+
+/**
+ * @brief Creates cache policy by its name (lru, 2q, arc)
+ *
+ * @throw Exception when policy name is unknown
+ */
+std::unique_ptr<CachePolicy> createCachePolicy(const std::string &name,
+                                               uint64_t capacity,
+                                               CacheMode mode);
+
+/**
+ * @return Names of all available cache policies
+ */
+std::vector<std::string> getCachePolicyNames();
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CACHEPOLICY_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CacheSimulationHandler.h"
+
+namespace octf {
+
+CacheSimulationHandler::CacheSimulationHandler(const std::string &tracePath,
+                                               CacheSimulator &simulator)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_simulator(simulator) {}
+
+void CacheSimulationHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    const auto &pbIo = io.io();
+
+    if (pbIo.error()) {
+        // Failed IO does not change cache content
+        return;
+    }
+
+    CacheAccessType type;
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+        type = CacheAccessType::Read;
+        break;
+    case proto::trace::IoType::Write:
+        type = CacheAccessType::Write;
+        break;
+    case proto::trace::IoType::Discard:
+        type = CacheAccessType::Invalidate;
+        break;
+    default:
+        return;
+    }
+
+    m_simulator.access(io.device().id(), pbIo.lba(), pbIo.len(), type);
+}
+
+}  // namespace octf
@@ -0,0 +1,36 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CACHESIMULATIONHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_CACHESIMULATIONHANDLER_H
+
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "CacheSimulator.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler feeding trace into cache simulator
+ */
+class CacheSimulationHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace to be simulated
+     * @param simulator Simulator with configured caches
+     */
+    CacheSimulationHandler(const std::string &tracePath,
+                           CacheSimulator &simulator);
+    virtual ~CacheSimulationHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+private:
+    CacheSimulator &m_simulator;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CACHESIMULATIONHANDLER_H
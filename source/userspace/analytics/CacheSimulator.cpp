@@ -0,0 +1,209 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CacheSimulator.h"
+#include <algorithm>
+#include <limits>
+#include <octf/utils/Exception.h>
+#include "WorkerPool.h"
+
+namespace octf {
+
+/** Number of cache line range accesses in a single batch */
+static constexpr size_t BATCH_SIZE = 64 * 1024;
+
+/** Number of batches which can be queued for the slowest worker */
+static constexpr uint32_t QUEUE_LIMIT = 16;
+
+/** Cache line key keeps device index above line index */
+static constexpr uint32_t DEVICE_INDEX_SHIFT = 48;
+static constexpr uint64_t MAX_DEVICE_INDEX = (1ULL << 15) - 1;
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+CacheSimulator::CacheSimulator(uint32_t cacheLineSize, uint32_t threadCount)
+        : m_cacheLineSize(cacheLineSize)
+        , m_lineSectors(cacheLineSize / SECTOR_SIZE)
+        , m_threadCount(WorkerPool::resolveThreadCount(threadCount))
+        , m_caches()
+        , m_broadcaster()
+        , m_threads()
+        , m_errors()
+        , m_batch()
+        , m_devices()
+        , m_accessCount(0)
+        , m_finished(false) {
+    if (!m_lineSectors || cacheLineSize % SECTOR_SIZE) {
+        throw Exception("Invalid cache line size");
+    }
+}
+
+CacheSimulator::~CacheSimulator() {
+    if (m_broadcaster) {
+        m_broadcaster->close();
+    }
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void CacheSimulator::addCache(std::unique_ptr<CachePolicy> cache) {
+    if (m_broadcaster) {
+        throw Exception("Cannot add cache, simulation already started");
+    }
+
+    m_caches.push_back(std::move(cache));
+}
+
+void CacheSimulator::start() {
+    if (m_caches.empty()) {
+        throw Exception("No cache to be simulated");
+    }
+
+    m_threadCount = std::min<uint32_t>(m_threadCount, m_caches.size());
+    m_errors.resize(m_threadCount);
+    m_broadcaster.reset(new BatchBroadcaster<Batch>(m_threadCount, QUEUE_LIMIT));
+
+    for (uint32_t i = 0; i < m_threadCount; i++) {
+        m_threads.emplace_back(&CacheSimulator::run, this, i);
+    }
+}
+
+void CacheSimulator::access(uint64_t deviceId,
+                            uint64_t lba,
+                            uint64_t len,
+                            CacheAccessType type) {
+    if (!len) {
+        // E.g. flush request, there is no data
+        return;
+    }
+
+    if (!m_broadcaster) {
+        start();
+    }
+
+    uint64_t deviceKey = getDeviceIndex(deviceId) << DEVICE_INDEX_SHIFT;
+    uint64_t line = lba / m_lineSectors;
+    uint64_t last = (lba + len - 1) / m_lineSectors;
+
+    // Keys of the range have to stay within the device
+    last = std::min<uint64_t>(last, line | ((1ULL << DEVICE_INDEX_SHIFT) - 1));
+
+    while (line <= last) {
+        if (!m_batch) {
+            m_batch = std::make_shared<Batch>();
+            m_batch->reserve(BATCH_SIZE);
+        }
+
+        CacheAccess access;
+        access.key = deviceKey | (line & ((1ULL << DEVICE_INDEX_SHIFT) - 1));
+        access.count = std::min<uint64_t>(last - line + 1,
+                                          std::numeric_limits<uint32_t>::max());
+        access.type = type;
+        m_batch->push_back(access);
+        m_accessCount += access.count;
+        line += access.count;
+
+        if (m_batch->size() >= BATCH_SIZE) {
+            publish();
+        }
+    }
+}
+
+void CacheSimulator::finish() {
+    if (m_finished) {
+        return;
+    }
+
+    if (!m_broadcaster) {
+        start();
+    }
+
+    if (m_batch) {
+        publish();
+    }
+
+    m_broadcaster->close();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    m_finished = true;
+
+    for (const auto &error : m_errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+const std::vector<std::unique_ptr<CachePolicy>> &CacheSimulator::getCaches()
+        const {
+    return m_caches;
+}
+
+uint64_t CacheSimulator::getAccessCount() const {
+    return m_accessCount;
+}
+
+uint32_t CacheSimulator::getCacheLineSize() const {
+    return m_cacheLineSize;
+}
+
+void CacheSimulator::publish() {
+    std::shared_ptr<const Batch> batch(std::move(m_batch));
+    m_batch.reset();
+    m_broadcaster->publish(batch);
+}
+
+void CacheSimulator::run(uint32_t worker) {
+    std::shared_ptr<const Batch> batch;
+
+    try {
+        while (m_broadcaster->next(worker, batch)) {
+            for (size_t i = worker; i < m_caches.size(); i += m_threadCount) {
+                auto &cache = *m_caches[i];
+
+                for (const auto &access : *batch) {
+                    switch (access.type) {
+                    case CacheAccessType::Read:
+                        cache.readRange(access.key, access.count);
+                        break;
+                    case CacheAccessType::Write:
+                        cache.writeRange(access.key, access.count);
+                        break;
+                    case CacheAccessType::Invalidate:
+                        cache.invalidateRange(access.key, access.count);
+                        break;
+                    }
+                }
+            }
+        }
+    } catch (...) {
+        m_errors[worker] = std::current_exception();
+
+        // Keep consuming, so the producer is never blocked by this worker
+        while (m_broadcaster->next(worker, batch)) {
+        }
+    }
+}
+
+uint64_t CacheSimulator::getDeviceIndex(uint64_t deviceId) {
+    auto iter = m_devices.find(deviceId);
+    if (iter != m_devices.end()) {
+        return iter->second;
+    }
+
+    uint64_t index = m_devices.size();
+    if (index > MAX_DEVICE_INDEX) {
+        throw Exception("Too many devices for cache simulation");
+    }
+
+    m_devices[deviceId] = index;
+    return index;
+}
+
+}  // namespace octf
@@ -0,0 +1,120 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CACHESIMULATOR_H
+#define SOURCE_USERSPACE_ANALYTICS_CACHESIMULATOR_H
+
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "BatchBroadcaster.h"
+#include "CachePolicy.h"
+
+namespace octf {
+
+/**
+ * @brief Type of cache line access
+ */
+enum class CacheAccessType : uint8_t {
+    Read,
+    Write,
+    Invalidate,
+};
+
+/**
+ * @brief Access to range of cache lines fed into simulated caches
+ */
+struct CacheAccess {
+    /** Key of the first cache line */
+    uint64_t key;
+    /** Number of cache lines */
+    uint32_t count;
+    CacheAccessType type;
+};
+
+/**
+ * @brief Simulator feeding a stream of IOs into many simulated caches
+ *
+ * IOs are turned into accesses to ranges of cache lines and gathered into
+ * batches. Each batch is broadcast to worker threads, every worker owns a
+ * subset of simulated caches and replays the batch on them. Thus the trace
+ * is read once, regardless of the number of simulated caches.
+ *
+ * Ranges are not split into single lines up front, so a discard of the
+ * whole device costs as much as the lines the cache holds.
+ */
+class CacheSimulator {
+public:
+    /**
+     * @param cacheLineSize Cache line size in bytes
+     * @param threadCount Number of worker threads, 0 means number of CPUs
+     */
+    CacheSimulator(uint32_t cacheLineSize, uint32_t threadCount);
+    virtual ~CacheSimulator();
+
+    /**
+     * @brief Adds cache to be simulated, allowed before the first access
+     */
+    void addCache(std::unique_ptr<CachePolicy> cache);
+
+    /**
+     * @brief Accesses device range
+     *
+     * @param deviceId Device ID
+     * @param lba Address of the first sector
+     * @param len Length in sectors
+     * @param type Access type
+     */
+    void access(uint64_t deviceId,
+                uint64_t lba,
+                uint64_t len,
+                CacheAccessType type);
+
+    /**
+     * @brief Flushes pending accesses and waits until all caches are done
+     *
+     * @throw Exception when simulation failed in worker thread
+     */
+    void finish();
+
+    const std::vector<std::unique_ptr<CachePolicy>> &getCaches() const;
+
+    /**
+     * @return Number of cache line accesses
+     */
+    uint64_t getAccessCount() const;
+
+    uint32_t getCacheLineSize() const;
+
+private:
+    typedef std::vector<CacheAccess> Batch;
+
+    void start();
+
+    void publish();
+
+    void run(uint32_t worker);
+
+    uint64_t getDeviceIndex(uint64_t deviceId);
+
+    const uint32_t m_cacheLineSize;
+    const uint64_t m_lineSectors;
+    uint32_t m_threadCount;
+    std::vector<std::unique_ptr<CachePolicy>> m_caches;
+    std::unique_ptr<BatchBroadcaster<Batch>> m_broadcaster;
+    std::vector<std::thread> m_threads;
+    std::vector<std::exception_ptr> m_errors;
+    std::shared_ptr<Batch> m_batch;
+    std::map<uint64_t, uint64_t> m_devices;
+    uint64_t m_accessCount;
+    bool m_finished;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CACHESIMULATOR_H
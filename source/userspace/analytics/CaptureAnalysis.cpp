@@ -0,0 +1,160 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CaptureAnalysis.h"
+#include <cstdio>
+#include <fstream>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+#include "CaptureAnalyzers.h"
+
+namespace octf {
+
+static constexpr char ANALYSIS_FILE_NAME[] = "octf.analysis";
+
+/** 1 MiB ranges */
+static constexpr uint64_t HOT_LBA_RANGE_SIZE = 2048;
+static constexpr uint32_t HOT_LBA_TOP_COUNT = 16;
+
+CaptureAnalysis::CaptureAnalysis()
+        : m_mutex()
+        , m_analyzers()
+        , m_states()
+        , m_activeQueues(0) {}
+
+void CaptureAnalysis::addAnalyzer(std::unique_ptr<CaptureAnalyzer> analyzer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_activeQueues) {
+        throw Exception("Cannot add analyzer while capture is running");
+    }
+
+    m_analyzers.push_back(std::move(analyzer));
+    m_states.resize(m_analyzers.size());
+}
+
+std::vector<std::unique_ptr<CaptureAnalyzerState>>
+CaptureAnalysis::createStates() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::unique_ptr<CaptureAnalyzerState>> states;
+    for (const auto &analyzer : m_analyzers) {
+        states.push_back(analyzer->createState());
+    }
+
+    m_activeQueues++;
+    return states;
+}
+
+void CaptureAnalysis::releaseStates(
+        std::vector<std::unique_ptr<CaptureAnalyzerState>> &states) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (size_t i = 0; i < states.size() && i < m_states.size(); i++) {
+        m_states[i].push_back(std::move(states[i]));
+    }
+    states.clear();
+
+    m_activeQueues--;
+}
+
+void CaptureAnalysis::merge(proto::CaptureAnalysis &analysis) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_activeQueues) {
+        throw Exception("Capture analysis is still running");
+    }
+
+    for (size_t i = 0; i < m_analyzers.size(); i++) {
+        auto result = analysis.add_analyzer();
+        result->set_name(m_analyzers[i]->getName());
+        m_analyzers[i]->merge(m_states[i], *result);
+    }
+}
+
+std::unique_ptr<CaptureAnalyzer> CaptureAnalysis::createAnalyzer(
+        const std::string &name) {
+    if (name == "io-size") {
+        return std::unique_ptr<CaptureAnalyzer>(new IoSizeAnalyzer());
+    } else if (name == "hot-lba") {
+        return std::unique_ptr<CaptureAnalyzer>(
+                new HotLbaAnalyzer(HOT_LBA_RANGE_SIZE, HOT_LBA_TOP_COUNT));
+    }
+
+    throw Exception("Unknown capture analyzer: " + name);
+}
+
+std::string CaptureAnalysis::getFilePath(const std::string &tracePath) {
+    return getFrameworkConfiguration().getTraceRepositoryPath() + "/" +
+           tracePath + "/" + ANALYSIS_FILE_NAME;
+}
+
+void CaptureAnalysis::write(const std::string &tracePath,
+                            const proto::CaptureAnalysis &analysis) {
+    std::string path = getFilePath(tracePath);
+
+    // Write to temporary file and rename, readers never see partial analysis
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios_base::out |
+                                            std::ios_base::binary |
+                                            std::ios_base::trunc);
+        if (!file.good() || !analysis.SerializeToOstream(&file)) {
+            file.close();
+            std::remove(tmpPath.c_str());
+            throw Exception("Cannot write capture analysis " + path);
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str())) {
+        std::remove(tmpPath.c_str());
+        throw Exception("Cannot write capture analysis " + path);
+    }
+}
+
+void CaptureAnalysis::read(const std::string &tracePath,
+                           proto::CaptureAnalysis &analysis) {
+    std::string path = getFilePath(tracePath);
+
+    std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file.good()) {
+        throw Exception("Trace " + tracePath +
+                        " was not captured with analyzers");
+    }
+
+    if (!analysis.ParseFromIstream(&file)) {
+        throw Exception("Cannot read capture analysis " + path);
+    }
+}
+
+constexpr size_t CaptureAnalysisQueue::BATCH_SIZE;
+
+CaptureAnalysisQueue::CaptureAnalysisQueue(
+        std::shared_ptr<CaptureAnalysis> analysis)
+        : m_analysis(analysis)
+        , m_states(analysis->createStates())
+        , m_buffer() {
+    m_buffer.reserve(BATCH_SIZE);
+}
+
+CaptureAnalysisQueue::~CaptureAnalysisQueue() {
+    flush();
+    m_analysis->releaseStates(m_states);
+}
+
+void CaptureAnalysisQueue::flush() {
+    if (!m_buffer.empty()) {
+        analyze(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+}
+
+void CaptureAnalysisQueue::analyze(const char *events, uint64_t size) {
+    for (auto &state : m_states) {
+        state->analyze(events, size);
+    }
+}
+
+}  // namespace octf
@@ -0,0 +1,130 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYSIS_H
+#define SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYSIS_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CaptureAnalyzer.h"
+#include "InterfaceTraceAnalytics.pb.h"
+
+namespace octf {
+
+/**
+ * @brief Set of analyzers run in the capture pipeline
+ *
+ * Converters of all trace queues share the analysis, each creates its own
+ * states of all analyzers and hands them back when it is destroyed. The
+ * shared lock is taken only then, never for analyzed events. Once capture
+ * stops, states are merged and the result is stored next to the trace.
+ */
+class CaptureAnalysis {
+public:
+    CaptureAnalysis();
+
+    /**
+     * @brief Adds analyzer, allowed before states are created
+     */
+    void addAnalyzer(std::unique_ptr<CaptureAnalyzer> analyzer);
+
+    /**
+     * @brief Creates states of all analyzers for a trace queue
+     *
+     * @note Thread safe
+     */
+    std::vector<std::unique_ptr<CaptureAnalyzerState>> createStates();
+
+    /**
+     * @brief Takes back states of a finished trace queue
+     *
+     * @note Thread safe
+     */
+    void releaseStates(
+            std::vector<std::unique_ptr<CaptureAnalyzerState>> &states);
+
+    /**
+     * @brief Merges states of all queues into results of analyzers
+     *
+     * @throw Exception when states of some queue are still in use
+     */
+    void merge(proto::CaptureAnalysis &analysis);
+
+    /**
+     * @brief Creates built-in analyzer
+     *
+     * @param name Name of the analyzer, io-size or hot-lba
+     *
+     * @throw Exception when there is no analyzer of the name
+     */
+    static std::unique_ptr<CaptureAnalyzer> createAnalyzer(
+            const std::string &name);
+
+    /**
+     * @return Path of the analysis file in the directory of given trace
+     */
+    static std::string getFilePath(const std::string &tracePath);
+
+    /**
+     * @throw Exception when the file cannot be written
+     */
+    static void write(const std::string &tracePath,
+                      const proto::CaptureAnalysis &analysis);
+
+    /**
+     * @throw Exception when the trace has no analysis
+     */
+    static void read(const std::string &tracePath,
+                     proto::CaptureAnalysis &analysis);
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<CaptureAnalyzer>> m_analyzers;
+    /** States of finished queues, by analyzer */
+    std::vector<std::vector<std::unique_ptr<CaptureAnalyzerState>>> m_states;
+    uint32_t m_activeQueues;
+};
+
+/**
+ * @brief Feeds events of one trace queue into its states of capture
+ * analyzers
+ *
+ * Converted events are gathered into a buffer which is analyzed once it
+ * fills up or the queue is flushed.
+ */
+class CaptureAnalysisQueue {
+public:
+    explicit CaptureAnalysisQueue(std::shared_ptr<CaptureAnalysis> analysis);
+
+    /**
+     * @note Analyzes buffered events and hands states back to the analysis
+     */
+    ~CaptureAnalysisQueue();
+
+    void record(const char *event, uint32_t size) {
+        if (m_buffer.size() + size > BATCH_SIZE) {
+            flush();
+        }
+        m_buffer.append(event, size);
+    }
+
+    void flush();
+
+    static constexpr size_t BATCH_SIZE = 64 * 1024;
+
+private:
+    void analyze(const char *events, uint64_t size);
+
+    std::shared_ptr<CaptureAnalysis> m_analysis;
+    std::vector<std::unique_ptr<CaptureAnalyzerState>> m_states;
+    std::string m_buffer;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYSIS_H
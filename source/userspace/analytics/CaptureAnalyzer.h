@@ -0,0 +1,69 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZER_H
+#define SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "InterfaceTraceAnalytics.pb.h"
+
+namespace octf {
+
+/**
+ * @brief State of a capture analyzer for a single trace queue
+ *
+ * The state is used only by the thread consuming its queue, which is pinned
+ * to the CPU of the queue, so it needs no locking.
+ */
+class CaptureAnalyzerState {
+public:
+    virtual ~CaptureAnalyzerState() = default;
+
+    /**
+     * @brief Analyzes a batch of raw kernel events of the queue, in order
+     *
+     * @param events Span of whole kernel events, each starting with its
+     * header, see KernelEventIterator
+     * @param size Size of the span in bytes
+     */
+    virtual void analyze(const char *events, uint64_t size) = 0;
+};
+
+/**
+ * @brief Analyzer plugged into the capture pipeline
+ *
+ * Events are analyzed on consumer threads while they are captured, so
+ * aggregates are ready when capture stops, without reading the trace again.
+ * Every trace queue gets its own state, states of all queues are merged
+ * into the result once the capture is stopped.
+ */
+class CaptureAnalyzer {
+public:
+    virtual ~CaptureAnalyzer() = default;
+
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Creates state of a trace queue
+     */
+    virtual std::unique_ptr<CaptureAnalyzerState> createState() = 0;
+
+    /**
+     * @brief Merges states of all queues into the result
+     *
+     * @param states States created by this analyzer, no longer in use
+     * @param[out] result Result of the analyzer, its name is already set
+     */
+    virtual void merge(
+            const std::vector<std::unique_ptr<CaptureAnalyzerState>> &states,
+            proto::CaptureAnalyzerResult &result) = 0;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZER_H
@@ -0,0 +1,208 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CaptureAnalyzers.h"
+#include <algorithm>
+#include <octf/trace/iotrace_event.h>
+#include <octf/utils/Exception.h>
+#include "HotRangeTracker.h"
+#include "LatencyHistogram.h"
+#include "LatencyStatisticsHandler.h"
+#include "consumer/KernelTraceHandler.h"
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+static constexpr uint32_t SIZE_PRECISION = 2;
+
+/** Sketch of every queue is small, there may be many CPUs */
+static constexpr uint32_t SKETCH_DEPTH = 4;
+static constexpr uint32_t SKETCH_WIDTH = 16 * 1024;
+
+/** Range key keeps device id above range index */
+static constexpr uint32_t DEVICE_ID_SHIFT = 32;
+
+static bool getIoOperation(const struct iotrace_event &ev,
+                           LatencyOperation &operation) {
+    switch (ev.operation) {
+    case iotrace_event_operation_rd:
+        operation = LatencyOperation::Read;
+        return true;
+    case iotrace_event_operation_wr:
+        operation = LatencyOperation::Write;
+        return true;
+    case iotrace_event_operation_discard:
+        operation = LatencyOperation::Discard;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Calls handler for every IO event of the span carrying data
+ */
+template <typename Handler>
+static void forEachIo(const char *events, uint64_t size, Handler handler) {
+    KernelEventIterator iterator(events, size);
+
+    while (const auto *hdr = iterator.next()) {
+        if (hdr->type != iotrace_event_type_io) {
+            continue;
+        }
+
+        const auto *ev = KernelEventIterator::get<struct iotrace_event>(hdr);
+        if (ev && ev->len) {
+            handler(*ev);
+        }
+    }
+}
+
+class IoSizeState : public CaptureAnalyzerState {
+public:
+    IoSizeState()
+            : m_histograms(static_cast<size_t>(LatencyOperation::Count),
+                           LatencyHistogram(SIZE_PRECISION)) {}
+    virtual ~IoSizeState() = default;
+
+    void analyze(const char *events, uint64_t size) override {
+        forEachIo(events, size, [this](const struct iotrace_event &ev) {
+            LatencyOperation operation;
+            if (getIoOperation(ev, operation)) {
+                m_histograms[static_cast<size_t>(operation)].record(
+                        ev.len * SECTOR_SIZE);
+            }
+        });
+    }
+
+    const std::vector<LatencyHistogram> &getHistograms() const {
+        return m_histograms;
+    }
+
+private:
+    std::vector<LatencyHistogram> m_histograms;
+};
+
+std::string IoSizeAnalyzer::getName() const {
+    return "io-size";
+}
+
+std::unique_ptr<CaptureAnalyzerState> IoSizeAnalyzer::createState() {
+    return std::unique_ptr<CaptureAnalyzerState>(new IoSizeState());
+}
+
+void IoSizeAnalyzer::merge(
+        const std::vector<std::unique_ptr<CaptureAnalyzerState>> &states,
+        proto::CaptureAnalyzerResult &result) {
+    static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+
+    std::vector<LatencyHistogram> histograms(
+            static_cast<size_t>(LatencyOperation::Count),
+            LatencyHistogram(SIZE_PRECISION));
+
+    for (const auto &state : states) {
+        const auto &other =
+                static_cast<const IoSizeState &>(*state).getHistograms();
+        for (size_t i = 0; i < histograms.size(); i++) {
+            histograms[i].merge(other[i]);
+        }
+    }
+
+    for (size_t i = 0; i < histograms.size(); i++) {
+        const auto &histogram = histograms[i];
+        if (!histogram.getCount()) {
+            continue;
+        }
+
+        auto distribution = result.add_distribution();
+        distribution->set_name(
+                getLatencyOperationName(static_cast<LatencyOperation>(i)));
+        distribution->set_count(histogram.getCount());
+        distribution->set_min(histogram.getMin());
+        distribution->set_max(histogram.getMax());
+        distribution->set_mean(histogram.getMean());
+
+        for (auto percentile : PERCENTILES) {
+            auto pbPercentile = distribution->add_percentile();
+            pbPercentile->set_percentile(percentile);
+            pbPercentile->set_value(histogram.getValueAtPercentile(percentile));
+        }
+    }
+}
+
+class HotLbaState : public CaptureAnalyzerState {
+public:
+    HotLbaState(uint64_t rangeSize, uint32_t topCount)
+            : m_rangeSize(rangeSize)
+            , m_tracker(topCount, SKETCH_DEPTH, SKETCH_WIDTH) {}
+    virtual ~HotLbaState() = default;
+
+    void analyze(const char *events, uint64_t size) override {
+        forEachIo(events, size, [this](const struct iotrace_event &ev) {
+            uint64_t deviceKey = static_cast<uint64_t>(ev.dev_id)
+                                 << DEVICE_ID_SHIFT;
+            uint64_t end = ev.lba + ev.len;
+
+            // Account sectors to every range the IO spans
+            for (uint64_t range = ev.lba / m_rangeSize;
+                 range * m_rangeSize < end; range++) {
+                uint64_t from = std::max<uint64_t>(ev.lba, range * m_rangeSize);
+                uint64_t to = std::min(end, (range + 1) * m_rangeSize);
+
+                m_tracker.add(
+                        deviceKey | (range & ((1ULL << DEVICE_ID_SHIFT) - 1)),
+                        to - from);
+            }
+        });
+    }
+
+    const HotRangeTracker &getTracker() const {
+        return m_tracker;
+    }
+
+private:
+    const uint64_t m_rangeSize;
+    HotRangeTracker m_tracker;
+};
+
+HotLbaAnalyzer::HotLbaAnalyzer(uint64_t rangeSize, uint32_t topCount)
+        : m_rangeSize(rangeSize)
+        , m_topCount(topCount) {
+    if (!rangeSize || !topCount) {
+        throw Exception("Invalid hot LBA analyzer parameters");
+    }
+}
+
+std::string HotLbaAnalyzer::getName() const {
+    return "hot-lba";
+}
+
+std::unique_ptr<CaptureAnalyzerState> HotLbaAnalyzer::createState() {
+    return std::unique_ptr<CaptureAnalyzerState>(
+            new HotLbaState(m_rangeSize, m_topCount));
+}
+
+void HotLbaAnalyzer::merge(
+        const std::vector<std::unique_ptr<CaptureAnalyzerState>> &states,
+        proto::CaptureAnalyzerResult &result) {
+    HotRangeTracker tracker(m_topCount, SKETCH_DEPTH, SKETCH_WIDTH);
+
+    for (const auto &state : states) {
+        tracker.merge(static_cast<const HotLbaState &>(*state).getTracker());
+    }
+
+    for (const auto &entry : tracker.getTop()) {
+        auto range = result.add_hotrange();
+        uint64_t index = entry.first & ((1ULL << DEVICE_ID_SHIFT) - 1);
+
+        range->set_deviceid(entry.first >> DEVICE_ID_SHIFT);
+        range->set_lba(index * m_rangeSize);
+        range->set_len(m_rangeSize);
+        range->set_sectors(entry.second);
+    }
+}
+
+}  // namespace octf
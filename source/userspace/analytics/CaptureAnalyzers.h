@@ -0,0 +1,62 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZERS_H
+#define SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZERS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CaptureAnalyzer.h"
+
+namespace octf {
+
+/**
+ * @brief Builds histograms of IO sizes per operation
+ */
+class IoSizeAnalyzer : public CaptureAnalyzer {
+public:
+    IoSizeAnalyzer() = default;
+    virtual ~IoSizeAnalyzer() = default;
+
+    std::string getName() const override;
+
+    std::unique_ptr<CaptureAnalyzerState> createState() override;
+
+    void merge(const std::vector<std::unique_ptr<CaptureAnalyzerState>> &states,
+               proto::CaptureAnalyzerResult &result) override;
+};
+
+/**
+ * @brief Tracks the most accessed LBA ranges of all devices
+ *
+ * Every queue counts accessed sectors of fixed size ranges in its own
+ * count-min sketch, sketches are merged when capture stops.
+ */
+class HotLbaAnalyzer : public CaptureAnalyzer {
+public:
+    /**
+     * @param rangeSize Size of LBA range in sectors
+     * @param topCount Number of reported ranges
+     */
+    HotLbaAnalyzer(uint64_t rangeSize, uint32_t topCount);
+    virtual ~HotLbaAnalyzer() = default;
+
+    std::string getName() const override;
+
+    std::unique_ptr<CaptureAnalyzerState> createState() override;
+
+    void merge(const std::vector<std::unique_ptr<CaptureAnalyzerState>> &states,
+               proto::CaptureAnalyzerResult &result) override;
+
+private:
+    const uint64_t m_rangeSize;
+    const uint32_t m_topCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_CAPTUREANALYZERS_H
@@ -0,0 +1,110 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ColumnEncoding.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+const char *getColumnEncodingName(ColumnEncoding encoding) {
+    switch (encoding) {
+    case ColumnEncoding::Varint:
+        return "varint";
+    case ColumnEncoding::Delta:
+        return "delta";
+    case ColumnEncoding::RunLength:
+        return "run-length";
+    default:
+        return "unknown";
+    }
+}
+
+void appendVarint(std::string &buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+static void encodeVarint(const std::vector<uint64_t> &values,
+                        std::string &buffer) {
+    for (auto value : values) {
+        appendVarint(buffer, value);
+    }
+}
+
+static void encodeDelta(const std::vector<uint64_t> &values,
+                        std::string &buffer) {
+    uint64_t previous = 0;
+
+    for (auto value : values) {
+        int64_t delta = static_cast<int64_t>(value - previous);
+        appendVarint(buffer, zigzagEncode(delta));
+        previous = value;
+    }
+}
+
+static void encodeRunLength(const std::vector<uint64_t> &values,
+                            std::string &buffer) {
+    size_t i = 0;
+
+    while (i < values.size()) {
+        size_t run = 1;
+        while (i + run < values.size() && values[i + run] == values[i]) {
+            run++;
+        }
+
+        appendVarint(buffer, values[i]);
+        appendVarint(buffer, run);
+        i += run;
+    }
+}
+
+void encodeColumn(const std::vector<uint64_t> &values,
+                  ColumnEncoding encoding,
+                  std::string &buffer) {
+    buffer.clear();
+    // Most of values fit into two bytes, reserve to limit reallocations
+    buffer.reserve(values.size() * 2);
+
+    switch (encoding) {
+    case ColumnEncoding::Varint:
+        encodeVarint(values, buffer);
+        break;
+    case ColumnEncoding::Delta:
+        encodeDelta(values, buffer);
+        break;
+    case ColumnEncoding::RunLength:
+        encodeRunLength(values, buffer);
+        break;
+    default:
+        throw Exception("Unknown column encoding");
+    }
+}
+
+ColumnEncoding encodeColumnCompact(const std::vector<uint64_t> &values,
+                                   std::string &buffer) {
+    static const ColumnEncoding candidates[] = {
+            ColumnEncoding::Delta,
+            ColumnEncoding::RunLength,
+    };
+
+    ColumnEncoding best = ColumnEncoding::Varint;
+    encodeColumn(values, best, buffer);
+
+    std::string candidate;
+    for (auto encoding : candidates) {
+        encodeColumn(values, encoding, candidate);
+        if (candidate.size() < buffer.size()) {
+            buffer.swap(candidate);
+            best = encoding;
+        }
+    }
+
+    return best;
+}
+
+}  // namespace octf
@@ -0,0 +1,83 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_COLUMNENCODING_H
+#define SOURCE_USERSPACE_ANALYTICS_COLUMNENCODING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Encodings of integer columns stored in columnar trace exports
+ */
+enum class ColumnEncoding : uint8_t {
+    /** Each value stored as LEB128 varint */
+    Varint = 0,
+
+    /** Difference to the previous value, zigzag mapped, stored as varint */
+    Delta = 1,
+
+    /** Pairs of (value, run length), both stored as varints */
+    RunLength = 2,
+};
+
+/**
+ * @return Human readable name of the encoding
+ */
+const char *getColumnEncodingName(ColumnEncoding encoding);
+
+/**
+ * @brief Appends fixed size little endian representation of the value
+ */
+template <typename T>
+void appendLittleEndian(std::string &buffer, T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief Appends LEB128 varint representation of the value to the buffer
+ */
+void appendVarint(std::string &buffer, uint64_t value);
+
+/**
+ * @brief Maps signed integer to unsigned one, keeping small magnitudes small
+ */
+inline uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Encodes column using given encoding
+ *
+ * @param values Column values
+ * @param encoding Encoding to be used
+ * @param[out] buffer Encoded column (replaced)
+ */
+void encodeColumn(const std::vector<uint64_t> &values,
+                  ColumnEncoding encoding,
+                  std::string &buffer);
+
+/**
+ * @brief Encodes column with all known encodings and keeps the smallest
+ * result
+ *
+ * @param values Column values
+ * @param[out] buffer Encoded column (replaced)
+ *
+ * @return Encoding which has been chosen
+ */
+ColumnEncoding encodeColumnCompact(const std::vector<uint64_t> &values,
+                                   std::string &buffer);
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_COLUMNENCODING_H
@@ -0,0 +1,29 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ColumnarExportHandler.h"
+
+namespace octf {
+
+ColumnarExportHandler::ColumnarExportHandler(const std::string &tracePath,
+                                             ColumnarTraceWriter &writer)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_writer(writer) {}
+
+void ColumnarExportHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    ColumnarRow row;
+
+    row.timestamp = io.header().timestamp();
+    row.lba = io.io().lba();
+    row.length = io.io().len();
+    row.operation = io.io().operation();
+    row.deviceId = io.device().id();
+    row.latency = io.io().latency();
+    row.fileId = io.file().id();
+
+    m_writer.append(row);
+}
+
+}  // namespace octf
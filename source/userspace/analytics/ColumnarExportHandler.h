@@ -0,0 +1,36 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_COLUMNAREXPORTHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_COLUMNAREXPORTHANDLER_H
+
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "ColumnarTraceWriter.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler writing events into columnar export
+ */
+class ColumnarExportHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace to be exported
+     * @param writer Columnar writer receiving parsed events
+     */
+    ColumnarExportHandler(const std::string &tracePath,
+                          ColumnarTraceWriter &writer);
+    virtual ~ColumnarExportHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+private:
+    ColumnarTraceWriter &m_writer;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_COLUMNAREXPORTHANDLER_H
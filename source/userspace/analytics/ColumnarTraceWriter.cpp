@@ -0,0 +1,248 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "ColumnarTraceWriter.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint32_t ColumnarTraceWriter::VERSION;
+constexpr size_t ColumnarTraceWriter::COLUMN_COUNT;
+
+static const char COLUMNAR_MAGIC[] = "IOTRCOL1";
+static constexpr size_t COLUMNAR_MAGIC_SIZE = sizeof(COLUMNAR_MAGIC) - 1;
+
+/**
+ * Maximum number of row groups being encoded at once, per worker thread.
+ * It bounds memory consumption when parsing is faster than encoding.
+ */
+static constexpr size_t PENDING_ROW_GROUPS_PER_THREAD = 2;
+
+const char *getTraceColumnName(TraceColumn column) {
+    switch (column) {
+    case TraceColumn::Timestamp:
+        return "timestamp";
+    case TraceColumn::Lba:
+        return "lba";
+    case TraceColumn::Length:
+        return "len";
+    case TraceColumn::Operation:
+        return "operation";
+    case TraceColumn::DeviceId:
+        return "deviceId";
+    case TraceColumn::Latency:
+        return "latency";
+    case TraceColumn::FileId:
+        return "fileId";
+    default:
+        return "unknown";
+    }
+}
+
+ColumnarTraceWriter::ColumnarTraceWriter(const std::string &path,
+                                         uint32_t rowGroupSize,
+                                         uint32_t threadCount)
+        : m_path(path)
+        , m_file()
+        , m_rowGroupSize(rowGroupSize)
+        , m_pool(threadCount)
+        , m_current()
+        , m_pending()
+        , m_index()
+        , m_summary()
+        , m_rowCount(0)
+        , m_offset(0)
+        , m_closed(false) {
+    if (!m_rowGroupSize) {
+        throw Exception("Invalid row group size");
+    }
+
+    m_file.open(m_path, std::ios_base::out | std::ios_base::binary |
+                                std::ios_base::trunc);
+    if (m_file.fail()) {
+        throw Exception("Cannot open columnar output file: " + m_path);
+    }
+
+    write(std::string(COLUMNAR_MAGIC, COLUMNAR_MAGIC_SIZE));
+}
+
+ColumnarTraceWriter::~ColumnarTraceWriter() {
+    // Let workers finish before the pool is destroyed
+    for (auto &pending : m_pending) {
+        pending.wait();
+    }
+}
+
+void ColumnarTraceWriter::append(const ColumnarRow &row) {
+    if (m_closed) {
+        throw Exception("Columnar output already closed: " + m_path);
+    }
+
+    if (!m_current) {
+        m_current = std::make_shared<RowGroup>();
+        for (auto &column : m_current->columns) {
+            column.reserve(m_rowGroupSize);
+        }
+    }
+
+    auto &columns = m_current->columns;
+    columns[static_cast<size_t>(TraceColumn::Timestamp)].push_back(
+            row.timestamp);
+    columns[static_cast<size_t>(TraceColumn::Lba)].push_back(row.lba);
+    columns[static_cast<size_t>(TraceColumn::Length)].push_back(row.length);
+    columns[static_cast<size_t>(TraceColumn::Operation)].push_back(
+            row.operation);
+    columns[static_cast<size_t>(TraceColumn::DeviceId)].push_back(
+            row.deviceId);
+    columns[static_cast<size_t>(TraceColumn::Latency)].push_back(row.latency);
+    columns[static_cast<size_t>(TraceColumn::FileId)].push_back(row.fileId);
+
+    m_rowCount++;
+
+    if (columns[0].size() >= m_rowGroupSize) {
+        submitRowGroup();
+    }
+}
+
+void ColumnarTraceWriter::close() {
+    if (m_closed) {
+        return;
+    }
+
+    if (m_current) {
+        submitRowGroup();
+    }
+
+    while (!m_pending.empty()) {
+        writeRowGroup(*m_pending.front().get());
+        m_pending.pop_front();
+    }
+
+    writeFooter();
+
+    m_file.close();
+    if (m_file.fail()) {
+        throw Exception("Cannot close columnar output file: " + m_path);
+    }
+
+    m_closed = true;
+}
+
+uint64_t ColumnarTraceWriter::getRowCount() const {
+    return m_rowCount;
+}
+
+uint64_t ColumnarTraceWriter::getRowGroupCount() const {
+    return m_index.size();
+}
+
+uint64_t ColumnarTraceWriter::getFileSize() const {
+    return m_offset;
+}
+
+const ColumnarColumnSummary &ColumnarTraceWriter::getColumnSummary(
+        TraceColumn column) const {
+    return m_summary.at(static_cast<size_t>(column));
+}
+
+std::shared_ptr<ColumnarTraceWriter::EncodedRowGroup>
+ColumnarTraceWriter::encodeRowGroup(std::shared_ptr<RowGroup> group) {
+    auto encoded = std::make_shared<EncodedRowGroup>();
+    const auto &timestamps =
+            group->columns[static_cast<size_t>(TraceColumn::Timestamp)];
+
+    encoded->rowCount = timestamps.size();
+    encoded->firstTimestamp = timestamps.front();
+    encoded->lastTimestamp = timestamps.back();
+
+    for (size_t i = 0; i < COLUMN_COUNT; i++) {
+        encoded->encodings[i] =
+                encodeColumnCompact(group->columns[i], encoded->chunks[i]);
+    }
+
+    return encoded;
+}
+
+void ColumnarTraceWriter::submitRowGroup() {
+    std::shared_ptr<RowGroup> group;
+    group.swap(m_current);
+
+    // Bound number of row groups kept in memory
+    size_t limit = m_pool.getThreadCount() * PENDING_ROW_GROUPS_PER_THREAD;
+    while (m_pending.size() >= limit) {
+        writeRowGroup(*m_pending.front().get());
+        m_pending.pop_front();
+    }
+
+    m_pending.push_back(
+            m_pool.submit([group]() { return encodeRowGroup(group); }));
+}
+
+void ColumnarTraceWriter::writeRowGroup(const EncodedRowGroup &group) {
+    RowGroupIndex index;
+
+    index.rowCount = group.rowCount;
+    index.firstTimestamp = group.firstTimestamp;
+    index.lastTimestamp = group.lastTimestamp;
+
+    for (size_t i = 0; i < COLUMN_COUNT; i++) {
+        index.offsets[i] = m_offset;
+        index.sizes[i] = group.chunks[i].size();
+        index.encodings[i] = group.encodings[i];
+
+        auto &summary = m_summary[i];
+        summary.rawSize += group.rowCount * sizeof(uint64_t);
+        summary.encodedSize += group.chunks[i].size();
+        summary.encodingUsage.at(static_cast<size_t>(group.encodings[i]))++;
+
+        write(group.chunks[i]);
+    }
+
+    m_index.push_back(index);
+}
+
+void ColumnarTraceWriter::writeFooter() {
+    std::string footer;
+
+    appendLittleEndian<uint32_t>(footer, VERSION);
+    appendLittleEndian<uint32_t>(footer, COLUMN_COUNT);
+    for (size_t i = 0; i < COLUMN_COUNT; i++) {
+        std::string name = getTraceColumnName(static_cast<TraceColumn>(i));
+
+        appendLittleEndian<uint8_t>(footer, i);
+        appendLittleEndian<uint16_t>(footer, name.size());
+        footer += name;
+    }
+
+    appendLittleEndian<uint64_t>(footer, m_index.size());
+    for (const auto &index : m_index) {
+        appendLittleEndian<uint64_t>(footer, index.rowCount);
+        appendLittleEndian<uint64_t>(footer, index.firstTimestamp);
+        appendLittleEndian<uint64_t>(footer, index.lastTimestamp);
+
+        for (size_t i = 0; i < COLUMN_COUNT; i++) {
+            appendLittleEndian<uint64_t>(footer, index.offsets[i]);
+            appendLittleEndian<uint64_t>(footer, index.sizes[i]);
+            appendLittleEndian<uint8_t>(
+                    footer, static_cast<uint8_t>(index.encodings[i]));
+        }
+    }
+
+    uint64_t footerSize = footer.size();
+    appendLittleEndian<uint64_t>(footer, footerSize);
+    footer.append(COLUMNAR_MAGIC, COLUMNAR_MAGIC_SIZE);
+
+    write(footer);
+}
+
+void ColumnarTraceWriter::write(const std::string &data) {
+    m_file.write(data.data(), data.size());
+    if (m_file.fail()) {
+        throw Exception("Cannot write columnar output file: " + m_path);
+    }
+    m_offset += data.size();
+}
+
+}  // namespace octf
@@ -0,0 +1,190 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_COLUMNARTRACEWRITER_H
+#define SOURCE_USERSPACE_ANALYTICS_COLUMNARTRACEWRITER_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ColumnEncoding.h"
+#include "WorkerPool.h"
+
+namespace octf {
+
+/**
+ * @file
+ *
+ * @brief Columnar export of parsed IO events
+ *
+ * File layout (all fixed size integers are little endian):
+ *
+ * @code
+ * "IOTRCOL1"                                  8 bytes magic
+ * row group 0: column chunk 0 ... column chunk N-1
+ * ...
+ * row group M-1
+ * footer:
+ *     u32 version
+ *     u32 column count
+ *     per column: u8 column id, u16 name length, name
+ *     u64 row group count
+ *     per row group:
+ *         u64 row count, u64 first timestamp, u64 last timestamp
+ *         per column: u64 chunk offset, u64 chunk size, u8 encoding
+ * u64 footer size
+ * "IOTRCOL1"                                  8 bytes magic
+ * @endcode
+ *
+ * Each column chunk is encoded independently (see ColumnEncoding), so readers
+ * can seek directly to columns they need and skip the others.
+ */
+
+/**
+ * @brief Columns of the columnar export, in the order stored in the file
+ */
+enum class TraceColumn : uint8_t {
+    Timestamp = 0,
+    Lba,
+    Length,
+    Operation,
+    DeviceId,
+    Latency,
+    FileId,
+    Count,
+};
+
+/**
+ * @return Name of the column as stored in the file footer
+ */
+const char *getTraceColumnName(TraceColumn column);
+
+/**
+ * @brief Single parsed IO event in the columnar form
+ */
+struct ColumnarRow {
+    uint64_t timestamp;
+    uint64_t lba;
+    uint64_t length;
+    uint64_t operation;
+    uint64_t deviceId;
+    uint64_t latency;
+    uint64_t fileId;
+};
+
+/**
+ * @brief Statistics of a single column gathered during export
+ */
+struct ColumnarColumnSummary {
+    /** Size of the column if values were stored as plain u64 */
+    uint64_t rawSize;
+
+    /** Size of the column after encoding */
+    uint64_t encodedSize;
+
+    /** Number of row groups stored with particular encoding */
+    std::array<uint64_t, 3> encodingUsage;
+};
+
+/**
+ * @brief Writer of columnar trace exports
+ *
+ * Rows are gathered into row groups. Full row groups are encoded in parallel
+ * by the worker pool and written to the file in order of their creation.
+ */
+class ColumnarTraceWriter {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @param path Path of the output file
+     * @param rowGroupSize Number of rows in a single row group
+     * @param threadCount Number of encoding threads, 0 means number of CPUs
+     */
+    ColumnarTraceWriter(const std::string &path,
+                        uint32_t rowGroupSize,
+                        uint32_t threadCount);
+
+    /**
+     * @note Unfinished export is not closed properly, call close() to get
+     * a valid file
+     */
+    virtual ~ColumnarTraceWriter();
+
+    /**
+     * @brief Appends row to the current row group
+     */
+    void append(const ColumnarRow &row);
+
+    /**
+     * @brief Flushes pending row groups and writes the footer
+     */
+    void close();
+
+    uint64_t getRowCount() const;
+
+    uint64_t getRowGroupCount() const;
+
+    uint64_t getFileSize() const;
+
+    const ColumnarColumnSummary &getColumnSummary(TraceColumn column) const;
+
+private:
+    static constexpr size_t COLUMN_COUNT =
+            static_cast<size_t>(TraceColumn::Count);
+
+    struct RowGroup {
+        std::array<std::vector<uint64_t>, COLUMN_COUNT> columns;
+    };
+
+    struct EncodedRowGroup {
+        uint64_t rowCount;
+        uint64_t firstTimestamp;
+        uint64_t lastTimestamp;
+        std::array<std::string, COLUMN_COUNT> chunks;
+        std::array<ColumnEncoding, COLUMN_COUNT> encodings;
+    };
+
+    struct RowGroupIndex {
+        uint64_t rowCount;
+        uint64_t firstTimestamp;
+        uint64_t lastTimestamp;
+        std::array<uint64_t, COLUMN_COUNT> offsets;
+        std::array<uint64_t, COLUMN_COUNT> sizes;
+        std::array<ColumnEncoding, COLUMN_COUNT> encodings;
+    };
+
+    static std::shared_ptr<EncodedRowGroup> encodeRowGroup(
+            std::shared_ptr<RowGroup> group);
+
+    void submitRowGroup();
+
+    void writeRowGroup(const EncodedRowGroup &group);
+
+    void writeFooter();
+
+    void write(const std::string &data);
+
+    std::string m_path;
+    std::ofstream m_file;
+    uint32_t m_rowGroupSize;
+    WorkerPool m_pool;
+    std::shared_ptr<RowGroup> m_current;
+    std::deque<std::future<std::shared_ptr<EncodedRowGroup>>> m_pending;
+    std::vector<RowGroupIndex> m_index;
+    std::array<ColumnarColumnSummary, COLUMN_COUNT> m_summary;
+    uint64_t m_rowCount;
+    uint64_t m_offset;
+    bool m_closed;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_COLUMNARTRACEWRITER_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "CountMinSketch.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+CountMinSketch::CountMinSketch(uint32_t depth, uint32_t width)
+        : m_depth(depth)
+        , m_width(width)
+        , m_counters() {
+    if (!depth || !width || (width & (width - 1))) {
+        throw Exception("Invalid count-min sketch dimensions");
+    }
+
+    m_counters.resize(static_cast<uint64_t>(depth) * width, 0);
+}
+
+void CountMinSketch::add(uint64_t key, uint64_t count) {
+    for (uint32_t row = 0; row < m_depth; row++) {
+        m_counters[slotOf(key, row)] += count;
+    }
+}
+
+uint64_t CountMinSketch::estimate(uint64_t key) const {
+    uint64_t result = ~0ULL;
+
+    for (uint32_t row = 0; row < m_depth; row++) {
+        result = std::min(result, m_counters[slotOf(key, row)]);
+    }
+
+    return result;
+}
+
+void CountMinSketch::merge(const CountMinSketch &other) {
+    if (other.m_depth != m_depth || other.m_width != m_width) {
+        throw Exception("Cannot merge count-min sketches of different size");
+    }
+
+    for (size_t i = 0; i < m_counters.size(); i++) {
+        m_counters[i] += other.m_counters[i];
+    }
+}
+
+uint64_t CountMinSketch::getMemoryUsage() const {
+    return m_counters.size() * sizeof(m_counters[0]);
+}
+
+uint64_t CountMinSketch::slotOf(uint64_t key, uint32_t row) const {
+    // Rows use independent hashes, seeded with the golden ratio multiples
+    uint64_t hash = hashMix64(key + (row + 1) * 0x9e3779b97f4a7c15ULL);
+    return static_cast<uint64_t>(row) * m_width + (hash & (m_width - 1));
+}
+
+}  // namespace octf
@@ -0,0 +1,55 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_COUNTMINSKETCH_H
+#define SOURCE_USERSPACE_ANALYTICS_COUNTMINSKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Count-min sketch of 64-bit keys
+ *
+ * Estimates are never lower than real counts. With width w and depth d
+ * an estimate exceeds the real count by more than e/w of the total count
+ * with probability at most e^-d.
+ *
+ * Sketches of the same dimensions can be merged by adding counters.
+ */
+class CountMinSketch {
+public:
+    /**
+     * @param depth Number of rows (hash functions)
+     * @param width Number of counters in row, power of 2
+     */
+    CountMinSketch(uint32_t depth, uint32_t width);
+
+    void add(uint64_t key, uint64_t count);
+
+    uint64_t estimate(uint64_t key) const;
+
+    /**
+     * @throw Exception when dimensions differ
+     */
+    void merge(const CountMinSketch &other);
+
+    /**
+     * @return Number of bytes occupied by the sketch
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    uint64_t slotOf(uint64_t key, uint32_t row) const;
+
+    uint32_t m_depth;
+    uint32_t m_width;
+    std::vector<uint64_t> m_counters;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_COUNTMINSKETCH_H
@@ -0,0 +1,35 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "EventCountingHandler.h"
+
+namespace octf {
+
+EventCountingHandler::EventCountingHandler(const std::string &tracePath)
+        : TraceEventHandler<proto::trace::Event>(tracePath)
+        , m_eventCount(0)
+        , m_ioEventCount(0) {}
+
+void EventCountingHandler::handleEvent(
+        std::shared_ptr<proto::trace::Event> traceEvent) {
+    count(*traceEvent);
+}
+
+void EventCountingHandler::count(const proto::trace::Event &event) {
+    m_eventCount++;
+    if (event.EventType_case() == proto::trace::Event::kIo) {
+        m_ioEventCount++;
+    }
+}
+
+uint64_t EventCountingHandler::getEventCount() const {
+    return m_eventCount;
+}
+
+uint64_t EventCountingHandler::getIoEventCount() const {
+    return m_ioEventCount;
+}
+
+}  // namespace octf
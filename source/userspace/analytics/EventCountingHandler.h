@@ -0,0 +1,46 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_EVENTCOUNTINGHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_EVENTCOUNTINGHANDLER_H
+
+#include <memory>
+#include <string>
+#include <octf/proto/trace.pb.h>
+#include <octf/trace/parser/TraceEventHandler.h>
+
+namespace octf {
+
+/**
+ * @brief Raw trace event handler only counting events, it measures cost
+ * of reading the trace
+ */
+class EventCountingHandler : public TraceEventHandler<proto::trace::Event> {
+public:
+    /**
+     * @param tracePath Path of the trace to be read
+     */
+    explicit EventCountingHandler(const std::string &tracePath);
+    virtual ~EventCountingHandler() = default;
+
+    void handleEvent(std::shared_ptr<proto::trace::Event> traceEvent) override;
+
+    /**
+     * @brief Accounts event read by other reader
+     */
+    void count(const proto::trace::Event &event);
+
+    uint64_t getEventCount() const;
+
+    uint64_t getIoEventCount() const;
+
+private:
+    uint64_t m_eventCount;
+    uint64_t m_ioEventCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_EVENTCOUNTINGHANDLER_H
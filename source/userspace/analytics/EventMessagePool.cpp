@@ -0,0 +1,116 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "EventMessagePool.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace octf {
+
+/** Event types above are not expected, they share the generic slots */
+static constexpr uint32_t MAX_EVENT_TYPES = 64;
+
+/**
+ * Clears fields of the message, but unlike Clear() keeps nested messages
+ * allocated, so that setting them again does not allocate
+ */
+static void clearFields(google::protobuf::Message &message) {
+    const auto *descriptor = message.GetDescriptor();
+    const auto *reflection = message.GetReflection();
+
+    for (int i = 0; i < descriptor->field_count(); i++) {
+        const auto *field = descriptor->field(i);
+
+        if (field->cpp_type() ==
+                    google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE &&
+            !field->is_repeated()) {
+            if (reflection->HasField(message, field)) {
+                clearFields(*reflection->MutableMessage(&message, field));
+            }
+        } else if (field->cpp_type() ==
+                           google::protobuf::FieldDescriptor::CPPTYPE_STRING &&
+                   !field->is_repeated()) {
+            // Clearing would free the string, assigning keeps its buffer
+            reflection->SetString(&message, field, std::string());
+        } else {
+            reflection->ClearField(&message, field);
+        }
+    }
+}
+
+static void clearEvent(proto::trace::Event &event,
+                       proto::trace::Event::EventTypeCase type) {
+    if (event.EventType_case() == type) {
+        clearFields(event);
+    } else {
+        // New message, or one from the generic slots
+        event.Clear();
+    }
+}
+
+EventMessagePool::EventMessagePool()
+        : m_slots()
+        , m_allocationCount(0) {}
+
+std::shared_ptr<proto::trace::Event> EventMessagePool::get(
+        proto::trace::Event::EventTypeCase type) {
+    uint32_t index = static_cast<uint32_t>(type);
+    if (index >= MAX_EVENT_TYPES) {
+        index = 0;
+        type = proto::trace::Event::EVENTTYPE_NOT_SET;
+    }
+
+    if (index >= m_slots.size()) {
+        m_slots.resize(index + 1);
+    }
+    auto &slots = m_slots[index];
+
+    // Look for a message released by consumers, starting after the last one
+    // handed out, the oldest is the most likely to be released
+    for (uint32_t i = 0; i < slots.messages.size(); i++) {
+        auto &message = slots.messages[slots.next];
+        slots.next = (slots.next + 1) % slots.messages.size();
+
+        if (message.use_count() == 1) {
+            clearEvent(*message, type);
+            return message;
+        }
+    }
+
+    slots.messages.push_back(std::make_shared<proto::trace::Event>());
+    m_allocationCount++;
+
+    auto &message = slots.messages.back();
+    clearEvent(*message, type);
+    return message;
+}
+
+uint64_t EventMessagePool::getAllocationCount() const {
+    return m_allocationCount;
+}
+
+proto::trace::Event::EventTypeCase EventMessagePool::peekEventType(
+        const uint8_t *data,
+        uint32_t size) {
+    using google::protobuf::internal::WireFormatLite;
+    google::protobuf::io::CodedInputStream input(data, size);
+
+    // Skip the header, the first other field is the event type oneof
+    while (uint32_t tag = input.ReadTag()) {
+        int field = WireFormatLite::GetTagFieldNumber(tag);
+        if (field != proto::trace::Event::kHeaderFieldNumber) {
+            return static_cast<proto::trace::Event::EventTypeCase>(field);
+        }
+
+        if (!WireFormatLite::SkipField(&input, tag)) {
+            break;
+        }
+    }
+
+    return proto::trace::Event::EVENTTYPE_NOT_SET;
+}
+
+}  // namespace octf
@@ -0,0 +1,75 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_EVENTMESSAGEPOOL_H
+#define SOURCE_USERSPACE_ANALYTICS_EVENTMESSAGEPOOL_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <octf/proto/trace.pb.h>
+
+namespace octf {
+
+/**
+ * @brief Pool of trace event messages recycled between events
+ *
+ * Clearing an event message deletes the message held in its event type
+ * oneof, so reusing a single message for events of changing types still
+ * allocates per event, as does clearing a message with nested messages.
+ * The pool keeps separate messages for each event type instead, and only
+ * clears their fields, keeping nested messages allocated.
+ *
+ * A message is recycled once no one but the pool references it, so events
+ * may be kept by consumers for a while, e.g. queued for serialization.
+ */
+class EventMessagePool {
+public:
+    EventMessagePool();
+    virtual ~EventMessagePool() = default;
+
+    /**
+     * @brief Gets a message for event of given type
+     *
+     * @param type Type of the event to be stored in the message
+     *
+     * @return Message with cleared fields, not referenced by anyone else.
+     * Once the message has been used for given type, its event type member
+     * stays allocated.
+     */
+    std::shared_ptr<proto::trace::Event> get(
+            proto::trace::Event::EventTypeCase type);
+
+    /**
+     * @return Number of messages allocated by the pool
+     */
+    uint64_t getAllocationCount() const;
+
+    /**
+     * @brief Finds type of serialized event without parsing it
+     *
+     * @param data Serialized event message
+     * @param size Size of serialized message
+     *
+     * @return Type of the event, or EVENTTYPE_NOT_SET if it cannot be told
+     */
+    static proto::trace::Event::EventTypeCase peekEventType(
+            const uint8_t *data,
+            uint32_t size);
+
+private:
+    struct Slots {
+        std::vector<std::shared_ptr<proto::trace::Event>> messages;
+        uint32_t next;
+    };
+
+    /** Slots indexed by event type, which matches oneof field number */
+    std::vector<Slots> m_slots;
+    uint64_t m_allocationCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_EVENTMESSAGEPOOL_H
@@ -0,0 +1,239 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "FilePathTree.h"
+
+namespace octf {
+
+constexpr uint32_t FilePathTree::NONE;
+constexpr uint32_t FilePathTree::MAX_DEPTH;
+
+FilePathTree::FilePathTree()
+        : m_index()
+        , m_nodes()
+        , m_nameIndex()
+        , m_names()
+        , m_paths()
+        , m_generation(0)
+        , m_chain()
+        , m_path()
+        , m_rootPath("/")
+        , m_emptyName() {}
+
+uint32_t FilePathTree::addName(const FileKey &key,
+                               const FileKey &parent,
+                               const std::string &name) {
+    uint32_t node = getNode(key);
+    uint32_t nameId = internName(name);
+    bool root = parent == key;
+
+    uint32_t parentNode = NONE;
+    if (parent.inode && !root) {
+        parentNode = getNode(parent);
+        m_nodes[parentNode].directory = true;
+    }
+
+    Node &entry = m_nodes[node];
+    if (entry.name != NONE &&
+        (entry.name != nameId || entry.parent != parentNode)) {
+        // Renamed or moved, paths of its descendants have changed
+        m_generation++;
+    }
+
+    entry.name = nameId;
+    entry.parent = parentNode;
+    entry.root = root;
+
+    return node;
+}
+
+uint32_t FilePathTree::getNode(const FileKey &key) {
+    auto iter = m_index.find(key);
+    if (iter != m_index.end()) {
+        return iter->second;
+    }
+
+    Node node;
+    node.partition = key.partition;
+    node.inode = key.inode;
+    node.creationDate = key.creationDate;
+    node.name = NONE;
+    node.parent = NONE;
+    node.path = NONE;
+    node.generation = 0;
+    node.directory = false;
+    node.root = false;
+
+    uint32_t index = m_nodes.size();
+    m_nodes.push_back(node);
+    m_index.emplace(key, index);
+
+    return index;
+}
+
+uint32_t FilePathTree::findNode(const FileKey &key) const {
+    auto iter = m_index.find(key);
+    return iter != m_index.end() ? iter->second : NONE;
+}
+
+const std::string &FilePathTree::getPath(uint32_t node) {
+    if (m_nodes[node].root) {
+        return m_rootPath;
+    }
+    if (isCached(m_nodes[node])) {
+        return m_paths[m_nodes[node].path];
+    }
+
+    collectChain(node, true);
+
+    // Walk down from the topmost node, appending names
+    m_path.clear();
+    for (auto iter = m_chain.rbegin(); iter != m_chain.rend(); ++iter) {
+        Node &entry = m_nodes[*iter];
+
+        if (entry.root) {
+            continue;
+        }
+        if (iter == m_chain.rbegin() && isCached(entry)) {
+            m_path = m_paths[entry.path];
+            continue;
+        }
+
+        m_path += '/';
+        if (entry.name != NONE) {
+            m_path += *m_names[entry.name];
+        } else {
+            m_path += '#' + std::to_string(entry.inode);
+        }
+
+        if (entry.directory) {
+            if (entry.path == NONE) {
+                entry.path = m_paths.size();
+                m_paths.push_back(m_path);
+            } else {
+                m_paths[entry.path] = m_path;
+            }
+            entry.generation = m_generation;
+        }
+    }
+
+    return m_path;
+}
+
+uint32_t FilePathTree::getAncestor(uint32_t node, uint32_t depth) {
+    collectChain(node, false);
+
+    // Directories containing the node, from the deepest one
+    uint32_t count = m_chain.size() - 1;
+    if (count && m_nodes[m_chain.back()].root) {
+        count--;
+    }
+
+    if (!depth || !count) {
+        return NONE;
+    }
+    if (depth > count) {
+        depth = count;
+    }
+
+    return m_chain[1 + count - depth];
+}
+
+uint64_t FilePathTree::getPartition(uint32_t node) const {
+    return m_nodes[node].partition;
+}
+
+FileKey FilePathTree::getKey(uint32_t node) const {
+    FileKey key;
+    key.partition = m_nodes[node].partition;
+    key.inode = m_nodes[node].inode;
+    key.creationDate = m_nodes[node].creationDate;
+    return key;
+}
+
+uint32_t FilePathTree::getParent(uint32_t node) const {
+    return m_nodes[node].root ? NONE : m_nodes[node].parent;
+}
+
+const std::string &FilePathTree::getName(uint32_t node) const {
+    uint32_t name = m_nodes[node].name;
+    return name != NONE ? *m_names[name] : m_emptyName;
+}
+
+bool FilePathTree::isRoot(uint32_t node) const {
+    return m_nodes[node].root;
+}
+
+void FilePathTree::merge(const FilePathTree &other,
+                         std::vector<uint32_t> &mapping) {
+    mapping.resize(other.m_nodes.size());
+    for (uint32_t node = 0; node < other.m_nodes.size(); node++) {
+        mapping[node] = getNode(other.getKey(node));
+    }
+
+    for (uint32_t node = 0; node < other.m_nodes.size(); node++) {
+        const Node &entry = other.m_nodes[node];
+        if (entry.name == NONE) {
+            continue;
+        }
+
+        FileKey parent;
+        if (entry.root) {
+            parent = other.getKey(node);
+        } else if (entry.parent != NONE) {
+            parent = other.getKey(entry.parent);
+        } else {
+            parent = FileKey{entry.partition, 0, 0};
+        }
+
+        addName(other.getKey(node), parent, *other.m_names[entry.name]);
+    }
+}
+
+bool FilePathTree::isNamed(uint32_t node) const {
+    return m_nodes[node].name != NONE;
+}
+
+uint64_t FilePathTree::getNodeCount() const {
+    return m_nodes.size();
+}
+
+uint64_t FilePathTree::getNameCount() const {
+    return m_names.size();
+}
+
+uint32_t FilePathTree::internName(const std::string &name) {
+    auto result = m_nameIndex.emplace(name, m_names.size());
+    if (result.second) {
+        m_names.push_back(&result.first->first);
+    }
+
+    return result.first->second;
+}
+
+void FilePathTree::collectChain(uint32_t node, bool stopAtCached) {
+    m_chain.clear();
+
+    while (true) {
+        const Node &entry = m_nodes[node];
+        m_chain.push_back(node);
+
+        if (entry.root || entry.parent == NONE ||
+            m_chain.size() > MAX_DEPTH) {
+            break;
+        }
+        if (stopAtCached && m_chain.size() > 1 && isCached(entry)) {
+            break;
+        }
+
+        node = entry.parent;
+    }
+}
+
+bool FilePathTree::isCached(const Node &node) const {
+    return node.path != NONE && node.generation == m_generation;
+}
+
+}  // namespace octf
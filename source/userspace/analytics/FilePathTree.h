@@ -0,0 +1,197 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_FILEPATHTREE_H
+#define SOURCE_USERSPACE_ANALYTICS_FILEPATHTREE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+/**
+ * @brief File identity, inode numbers are reused so creation time is a part
+ * of it
+ */
+struct FileKey {
+    uint64_t partition;
+    uint64_t inode;
+    uint64_t creationDate;
+
+    bool operator==(const FileKey &other) const {
+        return partition == other.partition && inode == other.inode &&
+               creationDate == other.creationDate;
+    }
+};
+
+struct FileKeyHash {
+    std::size_t operator()(const FileKey &key) const {
+        return hashMix64(hashMix64(key.partition ^ key.inode) ^
+                         key.creationDate);
+    }
+};
+
+/**
+ * @brief Tree of files and directories reconstructed from file name events
+ *
+ * File name events carry only the name and the parent of a file, so full
+ * paths are reconstructed by chasing parent links. Each file is a node
+ * referring to its parent by index, and names are interned, so millions of
+ * files sharing names take little memory.
+ *
+ * Paths are resolved lazily. Paths of directories are cached, so resolving
+ * a path costs appending a name to the cached path of its parent. Renames
+ * invalidate the cache.
+ *
+ * Files whose parent is not known are placed directly in the root of their
+ * partition, files whose name is not known are named after their inode.
+ * Paths do not contain the partition.
+ */
+class FilePathTree {
+public:
+    static constexpr uint32_t NONE = ~0U;
+
+    FilePathTree();
+    virtual ~FilePathTree() = default;
+
+    /**
+     * @brief Records name and parent of a file
+     *
+     * @param key File
+     * @param parent Parent directory, inode 0 when unknown
+     * @param name Name of file
+     *
+     * @return Node of the file
+     */
+    uint32_t addName(const FileKey &key,
+                     const FileKey &parent,
+                     const std::string &name);
+
+    /**
+     * @brief Gets node of the file, creating a node without name if the file
+     * is not known yet
+     */
+    uint32_t getNode(const FileKey &key);
+
+    /**
+     * @return Node of the file or NONE if the file is not known
+     */
+    uint32_t findNode(const FileKey &key) const;
+
+    /**
+     * @return Full path of the node, valid until next call
+     */
+    const std::string &getPath(uint32_t node);
+
+    /**
+     * @return Directory containing the node at given depth, or the parent
+     * of the node when it is shallower, NONE for partition root
+     *
+     * @note Directories in the root of partition are at depth 1
+     */
+    uint32_t getAncestor(uint32_t node, uint32_t depth);
+
+    uint64_t getPartition(uint32_t node) const;
+
+    FileKey getKey(uint32_t node) const;
+
+    /**
+     * @return Parent of the node, NONE for partition root or when the
+     * parent is not known
+     */
+    uint32_t getParent(uint32_t node) const;
+
+    /**
+     * @return Name of the node, empty if not traced
+     */
+    const std::string &getName(uint32_t node) const;
+
+    /**
+     * @retval true Node is the root of its partition
+     */
+    bool isRoot(uint32_t node) const;
+
+    /**
+     * @brief Merges files and names of other tree into this one
+     *
+     * Names of the other tree override names of this one, so trees of
+     * following trace segments shall be merged in order.
+     *
+     * @param other Tree to be merged
+     * @param[out] mapping Nodes of this tree indexed by nodes of other tree
+     */
+    void merge(const FilePathTree &other, std::vector<uint32_t> &mapping);
+
+    /**
+     * @retval true Name of the node has been traced
+     */
+    bool isNamed(uint32_t node) const;
+
+    uint64_t getNodeCount() const;
+
+    /**
+     * @return Number of distinct names
+     */
+    uint64_t getNameCount() const;
+
+private:
+    /** Chains of parent links longer than this are treated as cycles */
+    static constexpr uint32_t MAX_DEPTH = 4096;
+
+    struct Node {
+        uint64_t partition;
+        uint64_t inode;
+        uint64_t creationDate;
+
+        /** Interned name, NONE if the name has not been traced */
+        uint32_t name;
+        uint32_t parent;
+
+        /** Index of cached path, NONE if not cached */
+        uint32_t path;
+
+        /** Generation of the tree when the path was cached */
+        uint32_t generation;
+
+        /** Some other node has it as parent, i.e. it is a directory */
+        bool directory;
+
+        /** Root of partition, which is traced as its own parent */
+        bool root;
+    };
+
+    uint32_t internName(const std::string &name);
+
+    /**
+     * @brief Collects the node and its ancestors, starting from the node
+     *
+     * @param node Node to start from
+     * @param stopAtCached Stop at the first ancestor with cached path
+     */
+    void collectChain(uint32_t node, bool stopAtCached);
+
+    bool isCached(const Node &node) const;
+
+    std::unordered_map<FileKey, uint32_t, FileKeyHash> m_index;
+    std::vector<Node> m_nodes;
+    std::unordered_map<std::string, uint32_t> m_nameIndex;
+    std::vector<const std::string *> m_names;
+    std::vector<std::string> m_paths;
+
+    /** Incremented on rename, invalidates all cached paths */
+    uint32_t m_generation;
+
+    std::vector<uint32_t> m_chain;
+    std::string m_path;
+    const std::string m_rootPath;
+    const std::string m_emptyName;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_FILEPATHTREE_H
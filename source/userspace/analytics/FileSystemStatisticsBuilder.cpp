@@ -0,0 +1,301 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "FileSystemStatisticsBuilder.h"
+#include <algorithm>
+
+namespace octf {
+
+constexpr uint32_t FileSystemStatisticsBuilder::MAX_PENDING_IOS;
+constexpr uint32_t FileSystemStatisticsBuilder::MAX_SUBTREE_DEPTH;
+
+/** DSS IO classes assigned by the kernel module, see trace_bio.c */
+enum DssIoClass {
+    DSS_UNCLASSIFIED = 0,
+    DSS_METADATA = 1,
+    DSS_DATA_DIR = 7,
+    DSS_DATA_FILE_4KB = 11,
+    DSS_DATA_FILE_BULK = 21,
+    DSS_DATA_DIRECT = 22,
+    DSS_MISC = 23,
+};
+
+static FileKey getFileKey(uint64_t partition,
+                          const proto::trace::FileId &fileId) {
+    FileKey key;
+    key.partition = partition;
+    key.inode = fileId.id();
+    key.creationDate = fileId.creationdate();
+    return key;
+}
+
+FileSystemStatisticsBuilder::FileSystemStatisticsBuilder()
+        : m_tree()
+        , m_files()
+        , m_fileClasses()
+        , m_pending()
+        , m_pendingOrder()
+        , m_unmatchedCount(0) {}
+
+void FileSystemStatisticsBuilder::handleEvent(
+        const proto::trace::Event &event) {
+    switch (event.EventType_case()) {
+    case proto::trace::Event::kIo:
+        handleIo(event);
+        break;
+
+    case proto::trace::Event::kFilesystemMeta:
+        handleMeta(event.filesystemmeta());
+        break;
+
+    case proto::trace::Event::kFilesystemFileName: {
+        const auto &name = event.filesystemfilename();
+        m_tree.addName(getFileKey(name.partitionid(), name.fileid()),
+                       getFileKey(name.partitionid(), name.fileparentid()),
+                       name.filename());
+    } break;
+
+    default:
+        break;
+    }
+}
+
+std::map<FileSystemStatisticsBuilder::DirectoryKey, FileIoCounters>
+FileSystemStatisticsBuilder::getDirectoryStatistics(uint32_t depth) {
+    // Group by node first, so that each directory path is resolved once
+    std::map<std::pair<uint64_t, uint32_t>, FileIoCounters> nodes;
+    for (uint32_t node = 0; node < m_files.size(); node++) {
+        if (m_files[node].empty()) {
+            continue;
+        }
+
+        uint32_t directory = m_tree.getAncestor(node, depth);
+        nodes[std::make_pair(m_tree.getPartition(node), directory)].add(
+                m_files[node]);
+    }
+
+    std::map<DirectoryKey, FileIoCounters> directories;
+    for (const auto &entry : nodes) {
+        uint32_t directory = entry.first.second;
+        std::string path = directory == FilePathTree::NONE
+                                   ? "/"
+                                   : m_tree.getPath(directory);
+
+        directories[DirectoryKey(entry.first.first, path)].add(entry.second);
+    }
+
+    return directories;
+}
+
+typedef FileSystemStatisticsBuilder::SubtreeCandidate SubtreeCandidate;
+
+static bool compareSubtreeBytes(const SubtreeCandidate &a,
+                                const SubtreeCandidate &b) {
+    return a.second.getSectors() > b.second.getSectors();
+}
+
+static bool compareSubtreeIos(const SubtreeCandidate &a,
+                              const SubtreeCandidate &b) {
+    return a.second.getCount() > b.second.getCount();
+}
+
+static std::string getExtension(const std::string &name) {
+    auto dot = name.rfind('.');
+
+    // Leading dot marks hidden file, not extension
+    if (dot == std::string::npos || dot == 0) {
+        return std::string();
+    }
+
+    return name.substr(dot + 1);
+}
+
+FileSystemRollups FileSystemStatisticsBuilder::getRollups(uint32_t topCount) {
+    FileSystemRollups rollups;
+    std::vector<FileIoCounters> subtrees(m_tree.getNodeCount());
+
+    for (uint32_t node = 0; node < m_files.size(); node++) {
+        const FileIoCounters &file = m_files[node];
+        if (file.empty()) {
+            continue;
+        }
+
+        rollups.partitions[m_tree.getPartition(node)].add(file);
+        rollups.extensions[getExtension(m_tree.getName(node))].add(file);
+        rollups.sizeClasses[m_fileClasses[node]].add(file);
+
+        // Account the file to all directories above it
+        uint32_t parent = m_tree.getParent(node);
+        for (uint32_t depth = 0; parent != FilePathTree::NONE; depth++) {
+            if (depth >= MAX_SUBTREE_DEPTH) {
+                // Cycle of parent links
+                break;
+            }
+
+            subtrees[parent].add(file);
+            parent = m_tree.getParent(parent);
+        }
+    }
+
+    std::vector<SubtreeCandidate> candidates;
+    for (uint32_t node = 0; node < subtrees.size(); node++) {
+        if (!subtrees[node].empty() && !m_tree.isRoot(node)) {
+            candidates.emplace_back(node, subtrees[node]);
+        }
+    }
+
+    rankSubtrees(candidates, compareSubtreeBytes, topCount,
+                 rollups.topByBytes);
+    rankSubtrees(candidates, compareSubtreeIos, topCount, rollups.topByIos);
+
+    return rollups;
+}
+
+void FileSystemStatisticsBuilder::rankSubtrees(
+        std::vector<SubtreeCandidate> candidates,
+        bool (*compare)(const SubtreeCandidate &, const SubtreeCandidate &),
+        uint32_t topCount,
+        std::vector<FileSystemRollups::Subtree> &top) {
+    auto end = candidates.begin() +
+               std::min<uint64_t>(topCount, candidates.size());
+    std::partial_sort(candidates.begin(), end, candidates.end(), compare);
+
+    // Resolve paths of the top subtrees only
+    for (auto iter = candidates.begin(); iter != end; ++iter) {
+        uint32_t node = iter->first;
+        auto key = std::make_pair(m_tree.getPartition(node),
+                                  m_tree.getPath(node));
+        top.push_back(FileSystemRollups::Subtree(key, iter->second));
+    }
+}
+
+void FileSystemStatisticsBuilder::merge(
+        const FileSystemStatisticsBuilder &other) {
+    std::vector<uint32_t> mapping;
+    m_tree.merge(other.m_tree, mapping);
+
+    for (uint32_t node = 0; node < other.m_files.size(); node++) {
+        const FileIoCounters &file = other.m_files[node];
+        if (file.empty()) {
+            continue;
+        }
+
+        uint32_t target = mapping[node];
+        if (target >= m_files.size()) {
+            m_files.resize(target + 1);
+            m_fileClasses.resize(target + 1);
+        }
+
+        // The file is counted once, no matter in how many segments
+        bool known = !m_files[target].empty();
+        m_files[target].add(file);
+        if (known) {
+            m_files[target].files = 1;
+        }
+        m_fileClasses[target] = other.m_fileClasses[node];
+    }
+
+    m_unmatchedCount += other.m_unmatchedCount;
+}
+
+std::string FileSystemStatisticsBuilder::getSizeClassName(uint32_t ioClass) {
+    static const char *const fileSizes[] = {
+            "4KiB",  "16KiB", "64KiB",  "256KiB", "1MiB",
+            "4MiB",  "16MiB", "64MiB",  "256MiB", "1GiB"};
+
+    switch (ioClass) {
+    case DSS_UNCLASSIFIED:
+        return "unclassified";
+    case DSS_METADATA:
+        return "metadata";
+    case DSS_DATA_DIR:
+        return "directory";
+    case DSS_DATA_FILE_BULK:
+        return "file_bulk";
+    case DSS_DATA_DIRECT:
+        return "direct";
+    case DSS_MISC:
+        return "misc";
+    default:
+        break;
+    }
+
+    if (ioClass >= DSS_DATA_FILE_4KB && ioClass < DSS_DATA_FILE_BULK) {
+        return std::string("file_") + fileSizes[ioClass - DSS_DATA_FILE_4KB];
+    }
+
+    return "class_" + std::to_string(ioClass);
+}
+
+FilePathTree &FileSystemStatisticsBuilder::getPathTree() {
+    return m_tree;
+}
+
+uint64_t FileSystemStatisticsBuilder::getUnmatchedCount() const {
+    return m_unmatchedCount;
+}
+
+void FileSystemStatisticsBuilder::handleIo(const proto::trace::Event &event) {
+    const auto &io = event.io();
+    if (io.operation() != proto::trace::IoType::Read &&
+        io.operation() != proto::trace::IoType::Write) {
+        return;
+    }
+
+    PendingIo &pending = m_pending[io.id()];
+    pending.sid = event.header().sid();
+    pending.len = io.len();
+    pending.ioClass = io.ioclass();
+    pending.operation = io.operation();
+    m_pendingOrder.emplace_back(io.id(), pending.sid);
+
+    // IOs of other than file data never get metadata event, forget the
+    // oldest ones unless replaced by a newer IO with the same id
+    if (m_pendingOrder.size() > MAX_PENDING_IOS) {
+        auto oldest = m_pendingOrder.front();
+        m_pendingOrder.pop_front();
+
+        auto iter = m_pending.find(oldest.first);
+        if (iter != m_pending.end() && iter->second.sid == oldest.second) {
+            m_pending.erase(iter);
+        }
+    }
+}
+
+void FileSystemStatisticsBuilder::handleMeta(
+        const proto::trace::EventIoFilesystemMeta &meta) {
+    // Metadata event refers to id of its IO
+    auto iter = m_pending.find(meta.refsid());
+    if (iter == m_pending.end()) {
+        m_unmatchedCount++;
+        return;
+    }
+
+    uint32_t node =
+            m_tree.getNode(getFileKey(meta.partitionid(), meta.fileid()));
+    if (node >= m_files.size()) {
+        m_files.resize(node + 1);
+        m_fileClasses.resize(node + 1);
+    }
+    m_fileClasses[node] = iter->second.ioClass;
+
+    FileIoCounters &file = m_files[node];
+    if (file.empty()) {
+        file.files = 1;
+    }
+
+    if (iter->second.operation == proto::trace::IoType::Read) {
+        file.readCount++;
+        file.readSectors += iter->second.len;
+    } else {
+        file.writeCount++;
+        file.writeSectors += iter->second.len;
+    }
+
+    // Entry in arrival order is dropped once it becomes the oldest
+    m_pending.erase(iter);
+}
+
+}  // namespace octf
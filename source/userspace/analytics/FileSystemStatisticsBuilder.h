@@ -0,0 +1,183 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_FILESYSTEMSTATISTICSBUILDER_H
+#define SOURCE_USERSPACE_ANALYTICS_FILESYSTEMSTATISTICSBUILDER_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <octf/proto/trace.pb.h>
+#include "FilePathTree.h"
+
+namespace octf {
+
+/**
+ * @brief IO statistics of a file or of a group of files
+ */
+struct FileIoCounters {
+    uint64_t readCount;
+    uint64_t readSectors;
+    uint64_t writeCount;
+    uint64_t writeSectors;
+
+    /** Number of files with IO */
+    uint64_t files;
+
+    FileIoCounters()
+            : readCount(0)
+            , readSectors(0)
+            , writeCount(0)
+            , writeSectors(0)
+            , files(0) {}
+
+    void add(const FileIoCounters &other) {
+        readCount += other.readCount;
+        readSectors += other.readSectors;
+        writeCount += other.writeCount;
+        writeSectors += other.writeSectors;
+        files += other.files;
+    }
+
+    bool empty() const {
+        return !readCount && !writeCount;
+    }
+
+    uint64_t getCount() const {
+        return readCount + writeCount;
+    }
+
+    uint64_t getSectors() const {
+        return readSectors + writeSectors;
+    }
+};
+
+/**
+ * @brief Statistics of files rolled up by partition, directory subtree,
+ * file extension and DSS size class
+ */
+struct FileSystemRollups {
+    typedef std::pair<std::pair<uint64_t, std::string>, FileIoCounters>
+            Subtree;
+
+    std::map<uint64_t, FileIoCounters> partitions;
+
+    /** Subtrees with the biggest number of bytes, in descending order */
+    std::vector<Subtree> topByBytes;
+
+    /** Subtrees with the biggest number of IOs, in descending order */
+    std::vector<Subtree> topByIos;
+
+    /** Extension without the dot, empty for files without extension */
+    std::map<std::string, FileIoCounters> extensions;
+
+    /** DSS IO class of the last IO of the file, which reflects its size */
+    std::map<uint32_t, FileIoCounters> sizeClasses;
+};
+
+/**
+ * @brief Builds file system statistics from raw trace events
+ *
+ * IOs are attributed to files by their file system metadata events, and
+ * file paths are reconstructed from file name events by FilePathTree. As
+ * file names are traced after the first IO to the file, IOs are accounted
+ * per file first, and grouped by paths once the whole trace is read.
+ */
+class FileSystemStatisticsBuilder {
+public:
+    /** Partition and path of directory */
+    typedef std::pair<uint64_t, std::string> DirectoryKey;
+
+    /** Node of subtree root and statistics of the subtree */
+    typedef std::pair<uint32_t, FileIoCounters> SubtreeCandidate;
+
+    FileSystemStatisticsBuilder();
+    virtual ~FileSystemStatisticsBuilder() = default;
+
+    void handleEvent(const proto::trace::Event &event);
+
+    /**
+     * @brief Groups statistics of files by directory prefix
+     *
+     * @param depth Depth of directory prefix, 0 groups files by partition,
+     * 1 by directories in the root of partition, etc. Files in shallower
+     * directories are accounted to their directory.
+     */
+    std::map<DirectoryKey, FileIoCounters> getDirectoryStatistics(
+            uint32_t depth);
+
+    /**
+     * @brief Rolls statistics of files up
+     *
+     * Each subtree accounts all files below its root directory. Partition
+     * roots are not ranked as subtrees, they are reported as partitions.
+     *
+     * @param topCount Number of subtrees reported in each ranking
+     */
+    FileSystemRollups getRollups(uint32_t topCount);
+
+    /**
+     * @brief Merges statistics built from the following trace segment
+     */
+    void merge(const FileSystemStatisticsBuilder &other);
+
+    FilePathTree &getPathTree();
+
+    /**
+     * @return Name of DSS IO class
+     */
+    static std::string getSizeClassName(uint32_t ioClass);
+
+    /**
+     * @return Number of file system metadata events not matched with IO
+     */
+    uint64_t getUnmatchedCount() const;
+
+private:
+    /** IOs waiting for their file system metadata event */
+    static constexpr uint32_t MAX_PENDING_IOS = 65536;
+
+    /** Chains of parent links longer than this are treated as cycles */
+    static constexpr uint32_t MAX_SUBTREE_DEPTH = 4096;
+
+    struct PendingIo {
+        uint64_t sid;
+        uint32_t len;
+        uint32_t ioClass;
+        proto::trace::IoType operation;
+    };
+
+    void handleIo(const proto::trace::Event &event);
+
+    void handleMeta(const proto::trace::EventIoFilesystemMeta &meta);
+
+    void rankSubtrees(std::vector<SubtreeCandidate> candidates,
+                      bool (*compare)(const SubtreeCandidate &,
+                                      const SubtreeCandidate &),
+                      uint32_t topCount,
+                      std::vector<FileSystemRollups::Subtree> &top);
+
+    FilePathTree m_tree;
+
+    /** IO statistics indexed by node of path tree */
+    std::vector<FileIoCounters> m_files;
+
+    /** DSS IO class of the last IO, indexed by node of path tree */
+    std::vector<uint32_t> m_fileClasses;
+
+    /** Pending IOs by IO id, and their ids and sids in arrival order */
+    std::unordered_map<uint64_t, PendingIo> m_pending;
+    std::deque<std::pair<uint64_t, uint64_t>> m_pendingOrder;
+
+    uint64_t m_unmatchedCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_FILESYSTEMSTATISTICSBUILDER_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "FollowTraceHandler.h"
+#include <google/protobuf/util/json_util.h>
+#include <octf/utils/Log.h>
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+FollowTraceHandler::FollowTraceHandler(const std::string &tracePath,
+                                       RollingStatistics &statistics,
+                                       bool printEvents)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_statistics(statistics)
+        , m_printEvents(printEvents)
+        , m_deviceNames()
+        , m_eventCount(0) {}
+
+void FollowTraceHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    m_eventCount++;
+
+    if (m_printEvents) {
+        std::string json;
+        google::protobuf::util::MessageToJsonString(io, &json);
+        log::cout << json << std::endl;
+    }
+
+    LatencyOperation operation;
+    if (!getLatencyOperation(io, operation)) {
+        return;
+    }
+
+    uint64_t deviceId = io.device().id();
+    if (m_deviceNames.find(deviceId) == m_deviceNames.end()) {
+        m_deviceNames[deviceId] = io.device().name();
+    }
+
+    m_statistics.record(deviceId, io.header().timestamp(), operation,
+                        uint64_t(io.io().len()) * SECTOR_SIZE,
+                        io.io().latency());
+}
+
+const std::map<uint64_t, std::string> &FollowTraceHandler::getDeviceNames()
+        const {
+    return m_deviceNames;
+}
+
+uint64_t FollowTraceHandler::getEventCount() const {
+    return m_eventCount;
+}
+
+}  // namespace octf
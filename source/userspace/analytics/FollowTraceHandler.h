@@ -0,0 +1,49 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_FOLLOWTRACEHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_FOLLOWTRACEHANDLER_H
+
+#include <map>
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "RollingStatistics.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler of a trace being followed during capture
+ *
+ * Accounts IOs of consecutive segments in rolling statistics and
+ * optionally prints them as they are parsed.
+ */
+class FollowTraceHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the first followed segment
+     * @param statistics Rolling statistics to be updated
+     * @param printEvents Print parsed IOs in JSON format
+     */
+    FollowTraceHandler(const std::string &tracePath,
+                       RollingStatistics &statistics,
+                       bool printEvents);
+    virtual ~FollowTraceHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+    uint64_t getEventCount() const;
+
+private:
+    RollingStatistics &m_statistics;
+    const bool m_printEvents;
+    std::map<uint64_t, std::string> m_deviceNames;
+    uint64_t m_eventCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_FOLLOWTRACEHANDLER_H
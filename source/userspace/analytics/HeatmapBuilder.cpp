@@ -0,0 +1,281 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "HeatmapBuilder.h"
+#include <algorithm>
+#include <fstream>
+#include <octf/utils/Exception.h>
+#include "ColumnEncoding.h"
+
+namespace octf {
+
+constexpr uint32_t HeatmapBuilder::VERSION;
+
+static const char HEATMAP_MAGIC[] = "IOTRHMP1";
+static constexpr size_t HEATMAP_MAGIC_SIZE = sizeof(HEATMAP_MAGIC) - 1;
+
+static constexpr size_t BATCH_SIZE = 64 * 1024;
+
+/** Count-min sketch of 4 x 64K counters takes 2 MiB per worker */
+static constexpr uint32_t SKETCH_DEPTH = 4;
+static constexpr uint32_t SKETCH_WIDTH = 64 * 1024;
+
+/** Hot range key keeps device index in high bits */
+static constexpr uint64_t DEVICE_INDEX_SHIFT = 48;
+
+HeatmapBuilder::HeatmapBuilder(uint32_t rows,
+                               uint32_t cols,
+                               uint64_t hotRangeSize,
+                               uint32_t topRanges,
+                               uint32_t threadCount)
+        : m_rows(rows)
+        , m_cols(cols)
+        , m_hotRangeSize(hotRangeSize)
+        , m_pool(threadCount)
+        , m_slots(m_pool.getThreadCount())
+        , m_nextSlot(0)
+        , m_batch()
+        , m_deviceIndexes()
+        , m_deviceIds()
+        , m_deviceNames()
+        , m_gridMutex()
+        , m_grids()
+        , m_finished(false) {
+    if (!m_hotRangeSize) {
+        throw Exception("Invalid hot range size");
+    }
+
+    // Validate grid size before any worker runs
+    HeatmapGrid(rows, cols);
+
+    for (auto &slot : m_slots) {
+        slot.hotRanges.reset(
+                new HotRangeTracker(topRanges, SKETCH_DEPTH, SKETCH_WIDTH));
+    }
+}
+
+HeatmapBuilder::~HeatmapBuilder() {
+    for (auto &slot : m_slots) {
+        if (slot.pending.valid()) {
+            slot.pending.wait();
+        }
+    }
+}
+
+void HeatmapBuilder::add(uint64_t deviceId,
+                         const std::string &deviceName,
+                         uint64_t time,
+                         uint64_t lba,
+                         uint64_t len,
+                         bool write) {
+    if (m_finished) {
+        throw Exception("Heatmap already finished");
+    }
+
+    auto index = m_deviceIndexes.find(deviceId);
+    if (index == m_deviceIndexes.end()) {
+        if (m_deviceIds.size() > UINT16_MAX) {
+            throw Exception("Too many devices in trace");
+        }
+
+        index = m_deviceIndexes
+                        .insert(std::make_pair(deviceId, m_deviceIds.size()))
+                        .first;
+        m_deviceIds.push_back(deviceId);
+        m_deviceNames.push_back(deviceName);
+
+        std::lock_guard<std::mutex> lock(m_gridMutex);
+        m_grids.emplace_back(new HeatmapGrid(m_rows, m_cols));
+    }
+
+    if (!m_batch) {
+        m_batch = std::make_shared<Batch>();
+        m_batch->reserve(BATCH_SIZE);
+    }
+
+    Io io;
+    io.time = time;
+    io.lba = lba;
+    io.len = static_cast<uint32_t>(len);
+    io.deviceIndex = index->second;
+    io.write = write;
+    m_batch->push_back(io);
+
+    if (m_batch->size() >= BATCH_SIZE) {
+        submit();
+    }
+}
+
+void HeatmapBuilder::finish() {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    if (m_batch) {
+        submit();
+    }
+
+    for (auto &slot : m_slots) {
+        if (slot.pending.valid()) {
+            slot.pending.get();
+        }
+    }
+
+    // Merge hot ranges of all slots into the first one
+    auto &result = m_slots.front();
+    for (size_t i = 1; i < m_slots.size(); i++) {
+        result.hotRanges->merge(*m_slots[i].hotRanges);
+    }
+}
+
+uint64_t HeatmapBuilder::write(const std::string &path) const {
+    if (!m_finished) {
+        throw Exception("Heatmap not finished");
+    }
+
+    std::ofstream file(path, std::ios_base::out | std::ios_base::binary |
+                                     std::ios_base::trunc);
+    if (file.fail()) {
+        throw Exception("Cannot open heatmap output file: " + path);
+    }
+
+    std::string buffer(HEATMAP_MAGIC, HEATMAP_MAGIC_SIZE);
+    appendLittleEndian<uint32_t>(buffer, VERSION);
+    appendLittleEndian<uint32_t>(buffer, m_deviceIds.size());
+
+    uint64_t size = 0;
+    std::vector<uint64_t> row;
+    std::string encoded;
+
+    for (uint32_t i = 0; i < getDeviceCount(); i++) {
+        const auto &grid = getGrid(i);
+        const auto &name = m_deviceNames[i];
+
+        appendLittleEndian<uint64_t>(buffer, m_deviceIds[i]);
+        appendLittleEndian<uint16_t>(buffer, name.size());
+        buffer += name;
+        appendLittleEndian<uint32_t>(buffer, grid.getUsedRows());
+        appendLittleEndian<uint32_t>(buffer, grid.getUsedCols());
+        appendLittleEndian<uint64_t>(buffer, grid.getTimeBucket());
+        appendLittleEndian<uint64_t>(buffer, grid.getLbaBucket());
+
+        for (auto plane : {HeatmapGrid::Read, HeatmapGrid::Write}) {
+            for (uint32_t r = 0; r < grid.getUsedRows(); r++) {
+                row.clear();
+                for (uint32_t c = 0; c < grid.getUsedCols(); c++) {
+                    row.push_back(grid.get(plane, r, c));
+                }
+
+                encoded.clear();
+                auto encoding = encodeColumnCompact(row, encoded);
+
+                appendLittleEndian<uint8_t>(buffer,
+                                            static_cast<uint8_t>(encoding));
+                appendLittleEndian<uint32_t>(buffer, encoded.size());
+                buffer += encoded;
+            }
+
+            file.write(buffer.data(), buffer.size());
+            size += buffer.size();
+            buffer.clear();
+        }
+    }
+
+    file.write(buffer.data(), buffer.size());
+    size += buffer.size();
+
+    file.close();
+    if (file.fail()) {
+        throw Exception("Cannot write heatmap output file: " + path);
+    }
+
+    return size;
+}
+
+uint32_t HeatmapBuilder::getDeviceCount() const {
+    return m_deviceIds.size();
+}
+
+uint64_t HeatmapBuilder::getDeviceId(uint32_t index) const {
+    return m_deviceIds.at(index);
+}
+
+const std::string &HeatmapBuilder::getDeviceName(uint32_t index) const {
+    return m_deviceNames.at(index);
+}
+
+const HeatmapGrid &HeatmapBuilder::getGrid(uint32_t index) const {
+    if (!m_finished) {
+        throw Exception("Heatmap not finished");
+    }
+
+    return *m_grids.at(index);
+}
+
+std::vector<HotRange> HeatmapBuilder::getHotRanges() const {
+    if (!m_finished) {
+        throw Exception("Heatmap not finished");
+    }
+
+    std::vector<HotRange> ranges;
+    for (const auto &entry : m_slots.front().hotRanges->getTop()) {
+        HotRange range;
+        uint64_t index = entry.first & ((1ULL << DEVICE_INDEX_SHIFT) - 1);
+
+        range.deviceId = m_deviceIds.at(entry.first >> DEVICE_INDEX_SHIFT);
+        range.lba = index * m_hotRangeSize;
+        range.len = m_hotRangeSize;
+        range.sectors = entry.second;
+        ranges.push_back(range);
+    }
+
+    return ranges;
+}
+
+void HeatmapBuilder::submit() {
+    auto batch = m_batch;
+    m_batch.reset();
+
+    Slot &slot = m_slots[m_nextSlot];
+    m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+
+    // Slot is not thread safe, wait until its previous batch is done
+    if (slot.pending.valid()) {
+        slot.pending.get();
+    }
+
+    slot.pending = m_pool.submit(
+            [this, &slot, batch]() { account(slot, *batch); });
+}
+
+void HeatmapBuilder::account(Slot &slot, const Batch &batch) {
+    {
+        // Order of IOs does not matter, grids are sums of sectors
+        std::lock_guard<std::mutex> lock(m_gridMutex);
+
+        for (const auto &io : batch) {
+            m_grids[io.deviceIndex]->add(
+                    io.time, io.lba, io.len,
+                    io.write ? HeatmapGrid::Write : HeatmapGrid::Read);
+        }
+    }
+
+    for (const auto &io : batch) {
+        // Account sectors to every hot range the IO spans
+        uint64_t deviceKey =
+                static_cast<uint64_t>(io.deviceIndex) << DEVICE_INDEX_SHIFT;
+        uint64_t end = io.lba + io.len;
+        for (uint64_t range = io.lba / m_hotRangeSize;
+             range * m_hotRangeSize < end; range++) {
+            uint64_t from = std::max(io.lba, range * m_hotRangeSize);
+            uint64_t to = std::min(end, (range + 1) * m_hotRangeSize);
+
+            slot.hotRanges->add(deviceKey | range, to - from);
+        }
+    }
+}
+
+}  // namespace octf
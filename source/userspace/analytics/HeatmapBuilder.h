@@ -0,0 +1,155 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_HEATMAPBUILDER_H
+#define SOURCE_USERSPACE_ANALYTICS_HEATMAPBUILDER_H
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "HeatmapGrid.h"
+#include "HotRangeTracker.h"
+#include "WorkerPool.h"
+
+namespace octf {
+
+/**
+ * @brief Hot LBA range reported by heatmap builder
+ */
+struct HotRange {
+    uint64_t deviceId;
+    uint64_t lba;
+    uint64_t len;
+
+    /** Estimated number of accessed sectors, never lower than real one */
+    uint64_t sectors;
+};
+
+/**
+ * @brief Builds time x LBA heatmaps of devices and finds hot LBA ranges
+ *
+ * IOs are gathered into batches which are accounted by worker threads.
+ * There is a single grid per device, shared by all workers, so memory of
+ * grids does not grow with the number of threads. Each worker slot keeps
+ * its own hot range tracker of fixed size, slots are used round robin and
+ * merged when building is finished. Every slot has at most one batch in
+ * flight, which bounds memory usage.
+ *
+ * Heatmap file layout (little endian):
+ * @code
+ * "IOTRHMP1"
+ * u32 version, u32 device count
+ * for each device:
+ *     u64 device id, u16 name size, name
+ *     u32 rows, u32 cols, u64 time bucket [ns], u64 LBA bucket [sectors]
+ *     for read and write plane, for each row:
+ *         u8 encoding, u32 size, row encoded as column (see ColumnEncoding.h)
+ * @endcode
+ */
+class HeatmapBuilder {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @param rows Maximum number of time buckets
+     * @param cols Maximum number of LBA buckets
+     * @param hotRangeSize Size of hot range in sectors
+     * @param topRanges Number of hottest ranges to be reported
+     * @param threadCount Number of worker threads, 0 - number of CPUs
+     */
+    HeatmapBuilder(uint32_t rows,
+                   uint32_t cols,
+                   uint64_t hotRangeSize,
+                   uint32_t topRanges,
+                   uint32_t threadCount);
+
+    /**
+     * @note Waits for workers
+     */
+    ~HeatmapBuilder();
+
+    /**
+     * @param deviceId Device id
+     * @param deviceName Device name
+     * @param time Nanoseconds since the beginning of the trace
+     * @param lba First sector
+     * @param len Number of sectors
+     * @param write Write IO
+     */
+    void add(uint64_t deviceId,
+             const std::string &deviceName,
+             uint64_t time,
+             uint64_t lba,
+             uint64_t len,
+             bool write);
+
+    /**
+     * @brief Waits for workers and merges their results
+     *
+     * @throw Exception raised by a worker
+     */
+    void finish();
+
+    /**
+     * @brief Writes heatmaps of all devices into file
+     *
+     * @return File size
+     */
+    uint64_t write(const std::string &path) const;
+
+    uint32_t getDeviceCount() const;
+
+    uint64_t getDeviceId(uint32_t index) const;
+
+    const std::string &getDeviceName(uint32_t index) const;
+
+    const HeatmapGrid &getGrid(uint32_t index) const;
+
+    std::vector<HotRange> getHotRanges() const;
+
+private:
+    struct Io {
+        uint64_t time;
+        uint64_t lba;
+        uint32_t len;
+        uint16_t deviceIndex;
+        bool write;
+    };
+
+    typedef std::vector<Io> Batch;
+
+    struct Slot {
+        std::unique_ptr<HotRangeTracker> hotRanges;
+        std::future<void> pending;
+    };
+
+    void submit();
+
+    void account(Slot &slot, const Batch &batch);
+
+    const uint32_t m_rows;
+    const uint32_t m_cols;
+    const uint64_t m_hotRangeSize;
+    WorkerPool m_pool;
+    std::vector<Slot> m_slots;
+    uint32_t m_nextSlot;
+    std::shared_ptr<Batch> m_batch;
+    std::map<uint64_t, uint16_t> m_deviceIndexes;
+    std::vector<uint64_t> m_deviceIds;
+    std::vector<std::string> m_deviceNames;
+
+    /** Grids by device index, cheap to update, workers take turns */
+    std::mutex m_gridMutex;
+    std::vector<std::unique_ptr<HeatmapGrid>> m_grids;
+    bool m_finished;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_HEATMAPBUILDER_H
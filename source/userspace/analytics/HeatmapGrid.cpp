@@ -0,0 +1,150 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "HeatmapGrid.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint64_t HeatmapGrid::MIN_TIME_BUCKET;
+constexpr uint64_t HeatmapGrid::MIN_LBA_BUCKET;
+
+HeatmapGrid::HeatmapGrid(uint32_t rows, uint32_t cols)
+        : m_rows(rows)
+        , m_cols(cols)
+        , m_usedRows(0)
+        , m_usedCols(0)
+        , m_timeBucket(MIN_TIME_BUCKET)
+        , m_lbaBucket(MIN_LBA_BUCKET)
+        , m_cells() {
+    if (!rows || !cols || rows % 2 || cols % 2) {
+        throw Exception("Invalid heatmap grid size");
+    }
+
+    for (auto &cells : m_cells) {
+        cells.resize(static_cast<uint64_t>(rows) * cols, 0);
+    }
+}
+
+void HeatmapGrid::add(uint64_t time, uint64_t lba, uint64_t len, Plane plane) {
+    if (!len) {
+        return;
+    }
+
+    while (time / m_timeBucket >= m_rows) {
+        rescaleTime();
+    }
+
+    uint64_t end = lba + len;
+    while ((end - 1) / m_lbaBucket >= m_cols) {
+        rescaleLba();
+    }
+
+    uint64_t row = time / m_timeBucket;
+    uint64_t firstCol = lba / m_lbaBucket;
+    uint64_t lastCol = (end - 1) / m_lbaBucket;
+    auto &cells = m_cells[plane];
+
+    for (uint64_t col = firstCol; col <= lastCol; col++) {
+        // Split IO among LBA buckets it spans
+        uint64_t from = std::max(lba, col * m_lbaBucket);
+        uint64_t to = std::min(end, (col + 1) * m_lbaBucket);
+
+        cells[row * m_cols + col] += to - from;
+    }
+
+    m_usedRows = std::max<uint32_t>(m_usedRows, row + 1);
+    m_usedCols = std::max<uint32_t>(m_usedCols, lastCol + 1);
+}
+
+void HeatmapGrid::merge(const HeatmapGrid &other) {
+    if (other.m_rows != m_rows || other.m_cols != m_cols) {
+        throw Exception("Cannot merge heatmap grids of different size");
+    }
+
+    HeatmapGrid scaled(other);
+    while (scaled.m_timeBucket < m_timeBucket) {
+        scaled.rescaleTime();
+    }
+    while (m_timeBucket < scaled.m_timeBucket) {
+        rescaleTime();
+    }
+    while (scaled.m_lbaBucket < m_lbaBucket) {
+        scaled.rescaleLba();
+    }
+    while (m_lbaBucket < scaled.m_lbaBucket) {
+        rescaleLba();
+    }
+
+    for (size_t plane = 0; plane < PlaneCount; plane++) {
+        auto &cells = m_cells[plane];
+        const auto &otherCells = scaled.m_cells[plane];
+
+        for (size_t i = 0; i < cells.size(); i++) {
+            cells[i] += otherCells[i];
+        }
+    }
+
+    m_usedRows = std::max(m_usedRows, scaled.m_usedRows);
+    m_usedCols = std::max(m_usedCols, scaled.m_usedCols);
+}
+
+uint32_t HeatmapGrid::getUsedRows() const {
+    return m_usedRows;
+}
+
+uint32_t HeatmapGrid::getUsedCols() const {
+    return m_usedCols;
+}
+
+uint64_t HeatmapGrid::getTimeBucket() const {
+    return m_timeBucket;
+}
+
+uint64_t HeatmapGrid::getLbaBucket() const {
+    return m_lbaBucket;
+}
+
+uint64_t HeatmapGrid::getMemoryUsage() const {
+    return PlaneCount * m_cells[0].size() * sizeof(uint64_t);
+}
+
+void HeatmapGrid::rescaleTime() {
+    for (auto &cells : m_cells) {
+        for (uint64_t row = 0; row < m_rows / 2; row++) {
+            uint64_t *dst = &cells[row * m_cols];
+            const uint64_t *first = &cells[2 * row * m_cols];
+            const uint64_t *second = &cells[(2 * row + 1) * m_cols];
+
+            for (uint64_t col = 0; col < m_cols; col++) {
+                dst[col] = first[col] + second[col];
+            }
+        }
+
+        std::fill(cells.begin() + (m_rows / 2) * m_cols, cells.end(), 0);
+    }
+
+    m_timeBucket *= 2;
+    m_usedRows = (m_usedRows + 1) / 2;
+}
+
+void HeatmapGrid::rescaleLba() {
+    for (auto &cells : m_cells) {
+        for (uint64_t row = 0; row < m_rows; row++) {
+            uint64_t *data = &cells[row * m_cols];
+
+            for (uint64_t col = 0; col < m_cols / 2; col++) {
+                data[col] = data[2 * col] + data[2 * col + 1];
+            }
+            std::fill(data + m_cols / 2, data + m_cols, 0);
+        }
+    }
+
+    m_lbaBucket *= 2;
+    m_usedCols = (m_usedCols + 1) / 2;
+}
+
+}  // namespace octf
@@ -0,0 +1,90 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_HEATMAPGRID_H
+#define SOURCE_USERSPACE_ANALYTICS_HEATMAPGRID_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Fixed size time x LBA grid of accessed sectors
+ *
+ * Rows are time buckets, columns are LBA buckets. Neither trace duration
+ * nor device size has to be known upfront: both buckets start small and
+ * whenever a value does not fit the grid the bucket width is doubled and
+ * adjacent rows (or columns) are summed up. Memory usage is constant.
+ *
+ * Grids built from the same parameters can be merged, the one with
+ * narrower buckets is rescaled first.
+ */
+class HeatmapGrid {
+public:
+    enum Plane { Read = 0, Write = 1, PlaneCount = 2 };
+
+    static constexpr uint64_t MIN_TIME_BUCKET = 1000ULL * 1000ULL; /* 1 ms */
+    static constexpr uint64_t MIN_LBA_BUCKET = 8; /* 4 KiB */
+
+    /**
+     * @param rows Number of time buckets, even
+     * @param cols Number of LBA buckets, even
+     */
+    HeatmapGrid(uint32_t rows, uint32_t cols);
+
+    /**
+     * @param time Nanoseconds since the beginning of the trace
+     * @param lba First sector
+     * @param len Number of sectors
+     * @param plane Read or write
+     */
+    void add(uint64_t time, uint64_t lba, uint64_t len, Plane plane);
+
+    void merge(const HeatmapGrid &other);
+
+    uint64_t get(Plane plane, uint32_t row, uint32_t col) const {
+        return m_cells[plane][static_cast<uint64_t>(row) * m_cols + col];
+    }
+
+    /**
+     * @return Number of rows up to the last one containing data
+     */
+    uint32_t getUsedRows() const;
+
+    /**
+     * @return Number of columns up to the last one containing data
+     */
+    uint32_t getUsedCols() const;
+
+    /**
+     * @return Time bucket width in nanoseconds
+     */
+    uint64_t getTimeBucket() const;
+
+    /**
+     * @return LBA bucket width in sectors
+     */
+    uint64_t getLbaBucket() const;
+
+    uint64_t getMemoryUsage() const;
+
+private:
+    void rescaleTime();
+
+    void rescaleLba();
+
+    uint32_t m_rows;
+    uint32_t m_cols;
+    uint32_t m_usedRows;
+    uint32_t m_usedCols;
+    uint64_t m_timeBucket;
+    uint64_t m_lbaBucket;
+    std::vector<uint64_t> m_cells[PlaneCount];
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_HEATMAPGRID_H
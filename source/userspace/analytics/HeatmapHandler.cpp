@@ -0,0 +1,49 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "HeatmapHandler.h"
+
+namespace octf {
+
+HeatmapHandler::HeatmapHandler(const std::string &tracePath,
+                               HeatmapBuilder &builder)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_builder(builder)
+        , m_firstTimestamp(0)
+        , m_started(false) {}
+
+void HeatmapHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    const auto &pbIo = io.io();
+    bool write;
+
+    if (pbIo.error() || !pbIo.len()) {
+        return;
+    }
+
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+        write = false;
+        break;
+    case proto::trace::IoType::Write:
+        write = true;
+        break;
+    default:
+        return;
+    }
+
+    uint64_t timestamp = io.header().timestamp();
+    if (!m_started) {
+        m_firstTimestamp = timestamp;
+        m_started = true;
+    }
+    // Events are ordered by queue time only roughly, clamp early ones
+    uint64_t time =
+            timestamp > m_firstTimestamp ? timestamp - m_firstTimestamp : 0;
+
+    m_builder.add(io.device().id(), io.device().name(), time, pbIo.lba(),
+                  pbIo.len(), write);
+}
+
+}  // namespace octf
@@ -0,0 +1,33 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_HEATMAPHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_HEATMAPHANDLER_H
+
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "HeatmapBuilder.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler feeding reads and writes into heatmap builder
+ */
+class HeatmapHandler : public ParsedIoTraceEventHandler {
+public:
+    HeatmapHandler(const std::string &tracePath, HeatmapBuilder &builder);
+    virtual ~HeatmapHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+private:
+    HeatmapBuilder &m_builder;
+    uint64_t m_firstTimestamp;
+    bool m_started;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_HEATMAPHANDLER_H
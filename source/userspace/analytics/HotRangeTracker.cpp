@@ -0,0 +1,82 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "HotRangeTracker.h"
+#include <algorithm>
+
+namespace octf {
+
+HotRangeTracker::HotRangeTracker(uint32_t topCount,
+                                 uint32_t depth,
+                                 uint32_t width)
+        : m_topCount(topCount)
+        , m_capacity(2 * topCount)
+        , m_sketch(depth, width)
+        , m_candidates()
+        , m_order() {}
+
+void HotRangeTracker::add(uint64_t key, uint64_t count) {
+    m_sketch.add(key, count);
+
+    if (m_capacity) {
+        updateCandidate(key, m_sketch.estimate(key));
+    }
+}
+
+void HotRangeTracker::merge(const HotRangeTracker &other) {
+    m_sketch.merge(other.m_sketch);
+
+    std::vector<uint64_t> keys;
+    for (const auto &candidate : m_candidates) {
+        keys.push_back(candidate.first);
+    }
+    for (const auto &candidate : other.m_candidates) {
+        keys.push_back(candidate.first);
+    }
+
+    // Estimates of all candidates changed, select them again
+    m_candidates.clear();
+    m_order.clear();
+    for (auto key : keys) {
+        updateCandidate(key, m_sketch.estimate(key));
+    }
+}
+
+std::vector<HotRangeTracker::Entry> HotRangeTracker::getTop() const {
+    std::vector<Entry> top;
+
+    for (auto iter = m_order.rbegin();
+         iter != m_order.rend() && top.size() < m_topCount; iter++) {
+        top.push_back(Entry(iter->second, iter->first));
+    }
+
+    return top;
+}
+
+void HotRangeTracker::updateCandidate(uint64_t key, uint64_t estimate) {
+    auto candidate = m_candidates.find(key);
+
+    if (candidate != m_candidates.end()) {
+        m_order.erase(Entry(candidate->second, key));
+        candidate->second = estimate;
+        m_order.insert(Entry(estimate, key));
+        return;
+    }
+
+    if (m_candidates.size() >= m_capacity) {
+        auto coldest = m_order.begin();
+        if (coldest->first >= estimate) {
+            return;
+        }
+
+        m_candidates.erase(coldest->second);
+        m_order.erase(coldest);
+    }
+
+    m_candidates[key] = estimate;
+    m_order.insert(Entry(estimate, key));
+}
+
+}  // namespace octf
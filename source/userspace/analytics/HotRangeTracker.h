@@ -0,0 +1,63 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_HOTRANGETRACKER_H
+#define SOURCE_USERSPACE_ANALYTICS_HOTRANGETRACKER_H
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CountMinSketch.h"
+
+namespace octf {
+
+/**
+ * @brief Tracks the most accessed keys (heavy hitters) in bounded memory
+ *
+ * Counts are estimated with count-min sketch. Keys with the highest
+ * estimates are kept as candidates, twice as many as requested to lower
+ * the chance of missing a key which became hot late.
+ */
+class HotRangeTracker {
+public:
+    /** Key and estimated count */
+    typedef std::pair<uint64_t, uint64_t> Entry;
+
+    /**
+     * @param topCount Number of keys to be reported
+     * @param depth Count-min sketch depth
+     * @param width Count-min sketch width, power of 2
+     */
+    HotRangeTracker(uint32_t topCount, uint32_t depth, uint32_t width);
+
+    void add(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Merges sketch and candidates of other tracker into this one
+     */
+    void merge(const HotRangeTracker &other);
+
+    /**
+     * @return Keys with the highest estimated counts, in descending order
+     */
+    std::vector<Entry> getTop() const;
+
+private:
+    void updateCandidate(uint64_t key, uint64_t estimate);
+
+    uint32_t m_topCount;
+    uint32_t m_capacity;
+    CountMinSketch m_sketch;
+    std::unordered_map<uint64_t, uint64_t> m_candidates;
+
+    /** Candidates ordered by (estimate, key) */
+    std::set<Entry> m_order;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_HOTRANGETRACKER_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "HyperLogLog.h"
+#include <algorithm>
+#include <cmath>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint32_t HyperLogLog::MIN_PRECISION;
+constexpr uint32_t HyperLogLog::MAX_PRECISION;
+
+HyperLogLog::HyperLogLog(uint32_t precision)
+        : m_precision(precision)
+        , m_shift(64 - precision)
+        , m_registers() {
+    if (precision < MIN_PRECISION || precision > MAX_PRECISION) {
+        throw Exception("Invalid HyperLogLog precision");
+    }
+
+    m_registers.resize(1ULL << precision, 0);
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) {
+    if (other.m_precision != m_precision) {
+        throw Exception("Cannot merge HyperLogLog of different precision");
+    }
+
+    for (size_t i = 0; i < m_registers.size(); i++) {
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+}
+
+uint64_t HyperLogLog::estimate() const {
+    double m = static_cast<double>(m_registers.size());
+    double alpha;
+
+    switch (m_registers.size()) {
+    case 16:
+        alpha = 0.673;
+        break;
+    case 32:
+        alpha = 0.697;
+        break;
+    case 64:
+        alpha = 0.709;
+        break;
+    default:
+        alpha = 0.7213 / (1.0 + 1.079 / m);
+        break;
+    }
+
+    double sum = 0;
+    uint64_t zeros = 0;
+    for (auto reg : m_registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(reg));
+        if (!reg) {
+            zeros++;
+        }
+    }
+
+    double estimate = alpha * m * m / sum;
+
+    if (estimate <= 2.5 * m && zeros) {
+        // Small range correction - linear counting
+        estimate = m * std::log(m / zeros);
+    }
+
+    // 64-bit hashes make large range correction unnecessary
+    return static_cast<uint64_t>(estimate + 0.5);
+}
+
+void HyperLogLog::clear() {
+    std::fill(m_registers.begin(), m_registers.end(), 0);
+}
+
+uint32_t HyperLogLog::getPrecision() const {
+    return m_precision;
+}
+
+uint64_t HyperLogLog::getMemoryUsage() const {
+    return m_registers.size() * sizeof(m_registers[0]);
+}
+
+}  // namespace octf
@@ -0,0 +1,75 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_HYPERLOGLOG_H
+#define SOURCE_USERSPACE_ANALYTICS_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief HyperLogLog cardinality sketch
+ *
+ * Estimates number of distinct 64-bit hashes added to the sketch using
+ * 2^precision one byte registers. Standard error is about
+ * 1.04 / sqrt(2^precision), e.g. 1.6% for precision 12 (4 KiB).
+ *
+ * Sketches of the same precision can be merged, the result is the sketch
+ * of the union of both sets.
+ *
+ * @note Values added to the sketch have to be well mixed hashes
+ */
+class HyperLogLog {
+public:
+    static constexpr uint32_t MIN_PRECISION = 4;
+    static constexpr uint32_t MAX_PRECISION = 18;
+
+    explicit HyperLogLog(uint32_t precision);
+
+    void add(uint64_t hash) {
+        uint64_t index = hash >> m_shift;
+        uint64_t rest = hash << m_precision;
+        uint8_t rank = rest ? __builtin_clzll(rest) + 1 : m_shift + 1;
+
+        if (rank > m_registers[index]) {
+            m_registers[index] = rank;
+        }
+    }
+
+    /**
+     * @brief Merges other sketch into this one
+     *
+     * @throw Exception when precisions differ
+     */
+    void merge(const HyperLogLog &other);
+
+    /**
+     * @return Estimated number of distinct hashes
+     */
+    uint64_t estimate() const;
+
+    /**
+     * @brief Removes all hashes from the sketch
+     */
+    void clear();
+
+    uint32_t getPrecision() const;
+
+    /**
+     * @return Number of bytes occupied by the sketch
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    uint32_t m_precision;
+    uint32_t m_shift;
+    std::vector<uint8_t> m_registers;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_HYPERLOGLOG_H
@@ -0,0 +1,138 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "InFlightIoMatcher.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint32_t InFlightIoMatcher::NONE;
+
+InFlightIoMatcher::InFlightIoMatcher(uint32_t capacity, uint64_t timeout)
+        : m_timeout(timeout)
+        , m_index(capacity)
+        , m_entries(capacity)
+        , m_free(NONE)
+        , m_newest(NONE)
+        , m_oldest(NONE)
+        , m_count(0)
+        , m_stats() {
+    if (!capacity || capacity == NONE) {
+        throw Exception("Invalid in-flight IO capacity");
+    }
+
+    for (uint32_t i = capacity; i > 0; i--) {
+        m_entries[i - 1].older = m_free;
+        m_free = i - 1;
+    }
+}
+
+void InFlightIoMatcher::queue(const InFlightIo &io) {
+    m_stats.queued++;
+    expire(io.timestamp);
+
+    if (io.id == CacheLineTable::EMPTY_KEY) {
+        // Cannot be indexed, completion will be an orphan
+        return;
+    }
+
+    uint32_t existing = m_index.find(io.id);
+    if (existing != CacheLineTable::INVALID_VALUE) {
+        remove(existing);
+        m_stats.replaced++;
+    }
+
+    if (m_free == NONE) {
+        remove(m_oldest);
+        m_stats.capacityEvictions++;
+    }
+
+    uint32_t index = m_free;
+    Entry &entry = m_entries[index];
+    m_free = entry.older;
+
+    entry.io = io;
+    entry.newer = NONE;
+    entry.older = m_newest;
+    if (m_newest != NONE) {
+        m_entries[m_newest].newer = index;
+    } else {
+        m_oldest = index;
+    }
+    m_newest = index;
+
+    m_index.insert(io.id, index);
+    m_count++;
+    m_stats.peakInFlight = std::max(m_stats.peakInFlight, m_count);
+}
+
+bool InFlightIoMatcher::complete(uint64_t refId,
+                                 uint64_t deviceId,
+                                 uint64_t timestamp,
+                                 InFlightIo &io) {
+    uint32_t index = CacheLineTable::INVALID_VALUE;
+    if (refId != CacheLineTable::EMPTY_KEY) {
+        index = m_index.find(refId);
+    }
+
+    bool matched = index != CacheLineTable::INVALID_VALUE &&
+                   m_entries[index].io.deviceId == deviceId;
+
+    if (matched) {
+        io = m_entries[index].io;
+        remove(index);
+        m_stats.matched++;
+    } else {
+        m_stats.orphanCompletions++;
+    }
+
+    expire(timestamp);
+    return matched;
+}
+
+uint64_t InFlightIoMatcher::getInFlightCount() const {
+    return m_count;
+}
+
+const IoMatchingStatistics &InFlightIoMatcher::getStatistics() const {
+    return m_stats;
+}
+
+uint64_t InFlightIoMatcher::getMemoryUsage() const {
+    return m_index.getMemoryUsage() + m_entries.size() * sizeof(Entry);
+}
+
+void InFlightIoMatcher::expire(uint64_t now) {
+    while (m_oldest != NONE &&
+           m_entries[m_oldest].io.timestamp + m_timeout < now) {
+        remove(m_oldest);
+        m_stats.timeoutEvictions++;
+    }
+}
+
+void InFlightIoMatcher::remove(uint32_t index) {
+    Entry &entry = m_entries[index];
+
+    if (entry.newer != NONE) {
+        m_entries[entry.newer].older = entry.older;
+    } else {
+        m_newest = entry.older;
+    }
+
+    if (entry.older != NONE) {
+        m_entries[entry.older].newer = entry.newer;
+    } else {
+        m_oldest = entry.newer;
+    }
+
+    m_index.erase(entry.io.id);
+
+    entry.older = m_free;
+    m_free = index;
+    m_count--;
+}
+
+}  // namespace octf
@@ -0,0 +1,137 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_INFLIGHTIOMATCHER_H
+#define SOURCE_USERSPACE_ANALYTICS_INFLIGHTIOMATCHER_H
+
+#include <cstdint>
+#include <vector>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+/**
+ * @brief Queued IO waiting for its completion
+ */
+struct InFlightIo {
+    uint64_t id;
+    uint64_t sid;
+    uint64_t timestamp;
+    uint64_t deviceId;
+    uint64_t lba;
+    uint32_t len;
+    uint32_t ioClass;
+    uint32_t writeHint;
+    uint32_t operation;
+    bool flush;
+    bool fua;
+};
+
+struct IoMatchingStatistics {
+    uint64_t queued;
+    uint64_t matched;
+
+    /** Completions without queued IO, e.g. its event has been dropped */
+    uint64_t orphanCompletions;
+
+    /** IOs not completed within timeout */
+    uint64_t timeoutEvictions;
+
+    /** Oldest IOs evicted to make room in full table */
+    uint64_t capacityEvictions;
+
+    /** Not completed IOs replaced by a new IO with the same id */
+    uint64_t replaced;
+
+    uint64_t peakInFlight;
+
+    IoMatchingStatistics()
+            : queued(0)
+            , matched(0)
+            , orphanCompletions(0)
+            , timeoutEvictions(0)
+            , capacityEvictions(0)
+            , replaced(0)
+            , peakInFlight(0) {}
+};
+
+/**
+ * @brief Matches queued IOs with their completions in bounded memory
+ *
+ * Queued IOs are kept in a fixed pool linked in queue order and indexed by
+ * IO id in an open addressing table. A completion looks the IO up by its
+ * reference id. IOs lost their completions (drops, module unload) would
+ * otherwise be kept forever, so the oldest IOs are evicted when they are
+ * older than the timeout or when the pool is full. Memory usage depends only
+ * on the capacity, not on the trace length.
+ */
+class InFlightIoMatcher {
+public:
+    /**
+     * @param capacity Maximum number of IOs in flight
+     * @param timeout Maximum time between queue and completion in ns
+     */
+    InFlightIoMatcher(uint32_t capacity, uint64_t timeout);
+
+    /**
+     * @brief Registers queued IO
+     */
+    void queue(const InFlightIo &io);
+
+    /**
+     * @brief Matches completion with queued IO
+     *
+     * @param refId Id of the completed IO
+     * @param deviceId Device of the completed IO
+     * @param timestamp Completion time
+     * @param[out] io Matched IO
+     *
+     * @retval true Completion matched, io is valid
+     * @retval false Orphan completion
+     */
+    bool complete(uint64_t refId,
+                  uint64_t deviceId,
+                  uint64_t timestamp,
+                  InFlightIo &io);
+
+    uint64_t getInFlightCount() const;
+
+    const IoMatchingStatistics &getStatistics() const;
+
+    /**
+     * @return Number of bytes occupied by the matcher
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    static constexpr uint32_t NONE = ~0U;
+
+    struct Entry {
+        InFlightIo io;
+        uint32_t newer;
+        uint32_t older;
+    };
+
+    void expire(uint64_t now);
+
+    void remove(uint32_t index);
+
+    const uint64_t m_timeout;
+    CacheLineTable m_index;
+    std::vector<Entry> m_entries;
+    uint32_t m_free;
+
+    /** Most recently queued IO */
+    uint32_t m_newest;
+
+    /** Eviction candidate */
+    uint32_t m_oldest;
+    uint64_t m_count;
+    IoMatchingStatistics m_stats;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_INFLIGHTIOMATCHER_H
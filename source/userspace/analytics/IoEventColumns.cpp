@@ -0,0 +1,72 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "IoEventColumns.h"
+
+namespace octf {
+
+static uint64_t getOperation(proto::trace::IoType type) {
+    switch (type) {
+    case proto::trace::IoType::Read:
+        return IoEventColumns::Read;
+    case proto::trace::IoType::Write:
+        return IoEventColumns::Write;
+    case proto::trace::IoType::Discard:
+        return IoEventColumns::Discard;
+    default:
+        return IoEventColumns::Other;
+    }
+}
+
+bool IoEventColumns::append(const proto::trace::Event &event) {
+    switch (event.EventType_case()) {
+    case proto::trace::Event::kIo: {
+        const auto &io = event.io();
+
+        timestamp.push_back(event.header().timestamp());
+        deviceId.push_back(io.deviceid());
+        lba.push_back(io.lba());
+        len.push_back(io.len());
+        operation.push_back(getOperation(io.operation()));
+    } break;
+
+    case proto::trace::Event::kIoCompletion: {
+        const auto &completion = event.iocompletion();
+
+        timestamp.push_back(event.header().timestamp());
+        deviceId.push_back(completion.deviceid());
+        lba.push_back(completion.lba());
+        len.push_back(completion.len());
+        operation.push_back(Completion);
+    } break;
+
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+void IoEventColumns::reserve(uint64_t count) {
+    timestamp.reserve(count);
+    deviceId.reserve(count);
+    lba.reserve(count);
+    len.reserve(count);
+    operation.reserve(count);
+}
+
+void IoEventColumns::clear() {
+    timestamp.clear();
+    deviceId.clear();
+    lba.clear();
+    len.clear();
+    operation.clear();
+}
+
+uint64_t IoEventColumns::size() const {
+    return timestamp.size();
+}
+
+}  // namespace octf
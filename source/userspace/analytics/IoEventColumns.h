@@ -0,0 +1,55 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_IOEVENTCOLUMNS_H
+#define SOURCE_USERSPACE_ANALYTICS_IOEVENTCOLUMNS_H
+
+#include <cstdint>
+#include <vector>
+#include <octf/proto/trace.pb.h>
+
+namespace octf {
+
+/**
+ * @brief IO and completion events decoded into columns
+ *
+ * All columns have the same 64-bit width, so that filters can process
+ * them in bulk with the same number of lanes per vector register.
+ */
+struct IoEventColumns {
+    /** Bits of operation column */
+    enum Operation : uint64_t {
+        Read = 1,
+        Write = 2,
+        Discard = 4,
+        Completion = 8,
+        Other = 16,
+    };
+
+    std::vector<uint64_t> timestamp;
+    std::vector<uint64_t> deviceId;
+    std::vector<uint64_t> lba;
+    /** In sectors */
+    std::vector<uint64_t> len;
+    std::vector<uint64_t> operation;
+
+    /**
+     * @brief Appends IO or completion event to columns
+     *
+     * @retval true Event appended
+     * @retval false Event is neither IO nor completion, it is skipped
+     */
+    bool append(const proto::trace::Event &event);
+
+    void reserve(uint64_t count);
+
+    void clear();
+
+    uint64_t size() const;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_IOEVENTCOLUMNS_H
@@ -0,0 +1,267 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "IoEventFilter.h"
+#include <limits>
+#include <octf/utils/Exception.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace octf {
+
+namespace {
+
+/** Columns of events being filtered, and criteria prepared for kernels */
+struct FilterArgs {
+    const uint64_t *timestamp;
+    const uint64_t *device;
+    const uint64_t *lba;
+    const uint64_t *len;
+    const uint64_t *operation;
+    uint64_t count;
+
+    uint64_t deviceMask;
+    uint64_t deviceId;
+    uint64_t operationMask;
+    uint64_t lbaBegin;
+    uint64_t lbaRange;
+    uint64_t timeBegin;
+    uint64_t timeRange;
+};
+
+}  // namespace
+
+static void filterScalar(const FilterArgs &args,
+                         uint64_t begin,
+                         IoFilterResult &result) {
+    uint64_t matched = 0;
+    uint64_t sectors = 0;
+
+    for (uint64_t i = begin; i < args.count; i++) {
+        uint64_t match =
+                ((args.device[i] & args.deviceMask) == args.deviceId) &
+                ((args.operation[i] & args.operationMask) != 0) &
+                (args.lba[i] - args.lbaBegin < args.lbaRange) &
+                (args.timestamp[i] - args.timeBegin < args.timeRange);
+
+        matched += match;
+        sectors += args.len[i] & (0 - match);
+    }
+
+    result.matched += matched;
+    result.sectors += sectors;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2"))) static inline __m256i lessUnsignedAvx2(
+        __m256i a,
+        __m256i b) {
+    // AVX2 compares signed integers only, flipping sign bit fixes the order
+    const __m256i sign =
+            _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign),
+                              _mm256_xor_si256(a, sign));
+}
+
+__attribute__((target("avx2"))) static void filterAvx2(
+        const FilterArgs &args,
+        IoFilterResult &result) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i deviceMask = _mm256_set1_epi64x(args.deviceMask);
+    const __m256i deviceId = _mm256_set1_epi64x(args.deviceId);
+    const __m256i operations = _mm256_set1_epi64x(args.operationMask);
+    const __m256i lbaBegin = _mm256_set1_epi64x(args.lbaBegin);
+    const __m256i lbaRange = _mm256_set1_epi64x(args.lbaRange);
+    const __m256i timeBegin = _mm256_set1_epi64x(args.timeBegin);
+    const __m256i timeRange = _mm256_set1_epi64x(args.timeRange);
+
+    __m256i matched = zero;
+    __m256i sectors = zero;
+    uint64_t i = 0;
+
+    for (; i + 4 <= args.count; i += 4) {
+        __m256i device = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(args.device + i));
+        __m256i operation = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(args.operation + i));
+        __m256i lba = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(args.lba + i));
+        __m256i timestamp = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(args.timestamp + i));
+        __m256i len = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(args.len + i));
+
+        __m256i mask = _mm256_cmpeq_epi64(
+                _mm256_and_si256(device, deviceMask), deviceId);
+        mask = _mm256_andnot_si256(
+                _mm256_cmpeq_epi64(_mm256_and_si256(operation, operations),
+                                   zero),
+                mask);
+        mask = _mm256_and_si256(
+                mask, lessUnsignedAvx2(_mm256_sub_epi64(lba, lbaBegin),
+                                       lbaRange));
+        mask = _mm256_and_si256(
+                mask, lessUnsignedAvx2(_mm256_sub_epi64(timestamp, timeBegin),
+                                       timeRange));
+
+        // Matching lanes are all ones, i.e. -1
+        matched = _mm256_sub_epi64(matched, mask);
+        sectors = _mm256_add_epi64(sectors, _mm256_and_si256(len, mask));
+    }
+
+    alignas(32) uint64_t lanes[2][4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[0]), matched);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[1]), sectors);
+    for (uint32_t lane = 0; lane < 4; lane++) {
+        result.matched += lanes[0][lane];
+        result.sectors += lanes[1][lane];
+    }
+
+    filterScalar(args, i, result);
+}
+
+__attribute__((target("avx512f"))) static void filterAvx512(
+        const FilterArgs &args,
+        IoFilterResult &result) {
+    const __m512i deviceMask = _mm512_set1_epi64(args.deviceMask);
+    const __m512i deviceId = _mm512_set1_epi64(args.deviceId);
+    const __m512i operations = _mm512_set1_epi64(args.operationMask);
+    const __m512i lbaBegin = _mm512_set1_epi64(args.lbaBegin);
+    const __m512i lbaRange = _mm512_set1_epi64(args.lbaRange);
+    const __m512i timeBegin = _mm512_set1_epi64(args.timeBegin);
+    const __m512i timeRange = _mm512_set1_epi64(args.timeRange);
+
+    uint64_t matched = 0;
+    __m512i sectors = _mm512_setzero_si512();
+    uint64_t i = 0;
+
+    for (; i + 8 <= args.count; i += 8) {
+        __m512i device = _mm512_loadu_si512(args.device + i);
+        __m512i operation = _mm512_loadu_si512(args.operation + i);
+        __m512i lba = _mm512_loadu_si512(args.lba + i);
+        __m512i timestamp = _mm512_loadu_si512(args.timestamp + i);
+        __m512i len = _mm512_loadu_si512(args.len + i);
+
+        __mmask8 mask = _mm512_cmpeq_epu64_mask(
+                _mm512_and_si512(device, deviceMask), deviceId);
+        mask = _mm512_mask_test_epi64_mask(mask, operation, operations);
+        mask = _mm512_mask_cmplt_epu64_mask(
+                mask, _mm512_sub_epi64(lba, lbaBegin), lbaRange);
+        mask = _mm512_mask_cmplt_epu64_mask(
+                mask, _mm512_sub_epi64(timestamp, timeBegin), timeRange);
+
+        matched += __builtin_popcount(mask);
+        sectors = _mm512_mask_add_epi64(sectors, mask, sectors, len);
+    }
+
+    result.matched += matched;
+    result.sectors += _mm512_reduce_add_epi64(sectors);
+
+    filterScalar(args, i, result);
+}
+
+#endif
+
+IoFilterCriteria::IoFilterCriteria()
+        : deviceMask(0)
+        , deviceId(0)
+        , operations(~0ULL)
+        , lbaBegin(0)
+        , lbaEnd(std::numeric_limits<uint64_t>::max())
+        , timeBegin(0)
+        , timeEnd(std::numeric_limits<uint64_t>::max()) {}
+
+IoEventFilter::IoEventFilter(const IoFilterCriteria &criteria)
+        : m_criteria(criteria) {
+    if (m_criteria.lbaEnd < m_criteria.lbaBegin ||
+        m_criteria.timeEnd < m_criteria.timeBegin) {
+        throw Exception("Invalid filter range, end precedes begin");
+    }
+}
+
+void IoEventFilter::filter(const IoEventColumns &columns,
+                           IoFilterImplementation implementation,
+                           IoFilterResult &result) const {
+    FilterArgs args;
+    args.timestamp = columns.timestamp.data();
+    args.device = columns.deviceId.data();
+    args.lba = columns.lba.data();
+    args.len = columns.len.data();
+    args.operation = columns.operation.data();
+    args.count = columns.size();
+    args.deviceMask = m_criteria.deviceMask;
+    args.deviceId = m_criteria.deviceId;
+    args.operationMask = m_criteria.operations;
+    args.lbaBegin = m_criteria.lbaBegin;
+    args.lbaRange = m_criteria.lbaEnd - m_criteria.lbaBegin;
+    args.timeBegin = m_criteria.timeBegin;
+    args.timeRange = m_criteria.timeEnd - m_criteria.timeBegin;
+
+    switch (implementation) {
+#if defined(__x86_64__)
+    case IoFilterImplementation::Avx2:
+        filterAvx2(args, result);
+        break;
+    case IoFilterImplementation::Avx512:
+        filterAvx512(args, result);
+        break;
+#endif
+    case IoFilterImplementation::Scalar:
+        filterScalar(args, 0, result);
+        break;
+    default:
+        throw Exception("Filter implementation not supported: " +
+                        getImplementationName(implementation));
+    }
+}
+
+std::vector<IoFilterImplementation>
+IoEventFilter::getSupportedImplementations() {
+    std::vector<IoFilterImplementation> implementations = {
+            IoFilterImplementation::Scalar};
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        implementations.push_back(IoFilterImplementation::Avx2);
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        implementations.push_back(IoFilterImplementation::Avx512);
+    }
+#endif
+
+    return implementations;
+}
+
+std::string IoEventFilter::getImplementationName(
+        IoFilterImplementation implementation) {
+    switch (implementation) {
+    case IoFilterImplementation::Scalar:
+        return "scalar";
+    case IoFilterImplementation::Avx2:
+        return "avx2";
+    case IoFilterImplementation::Avx512:
+        return "avx512";
+    }
+
+    return "unknown";
+}
+
+IoFilterImplementation IoEventFilter::getImplementation(
+        const std::string &name) {
+    for (auto implementation : getSupportedImplementations()) {
+        if (getImplementationName(implementation) == name) {
+            return implementation;
+        }
+    }
+
+    throw Exception("Filter implementation unknown or not supported: " +
+                    name);
+}
+
+}  // namespace octf
@@ -0,0 +1,105 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_IOEVENTFILTER_H
+#define SOURCE_USERSPACE_ANALYTICS_IOEVENTFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "IoEventColumns.h"
+
+namespace octf {
+
+/**
+ * @brief Criteria of IO event filter, all of them have to be met
+ */
+struct IoFilterCriteria {
+    /** Event matches when (deviceId & deviceMask) == deviceId */
+    uint64_t deviceMask;
+    uint64_t deviceId;
+
+    /** Bits of IoEventColumns::Operation */
+    uint64_t operations;
+
+    /** LBA range [lbaBegin, lbaEnd) */
+    uint64_t lbaBegin;
+    uint64_t lbaEnd;
+
+    /** Time window [timeBegin, timeEnd) of absolute timestamps */
+    uint64_t timeBegin;
+    uint64_t timeEnd;
+
+    /** Criteria matching all events */
+    IoFilterCriteria();
+};
+
+struct IoFilterResult {
+    uint64_t matched;
+    /** Sum of lengths of matched events, in sectors */
+    uint64_t sectors;
+
+    IoFilterResult()
+            : matched(0)
+            , sectors(0) {}
+
+    bool operator==(const IoFilterResult &other) const {
+        return matched == other.matched && sectors == other.sectors;
+    }
+};
+
+/** Instruction set used for evaluating filter */
+enum class IoFilterImplementation {
+    Scalar,
+    Avx2,
+    Avx512,
+};
+
+/**
+ * @brief Filters decoded IO events by device, operation, LBA range and time
+ * window, and aggregates matched events
+ *
+ * Filter is evaluated in bulk on event columns, with vector instructions
+ * supported by the CPU: AVX2 or AVX-512 on x86, otherwise scalar. Ranges
+ * are checked with a single unsigned comparison (value - begin < end - begin),
+ * so that every criterion is a branchless operation on whole vectors.
+ */
+class IoEventFilter {
+public:
+    explicit IoEventFilter(const IoFilterCriteria &criteria);
+    virtual ~IoEventFilter() = default;
+
+    /**
+     * @brief Filters events and adds matched ones to result
+     *
+     * @param columns Decoded events
+     * @param implementation Implementation to be used, it has to be
+     * supported by the CPU
+     * @param[in,out] result Result to which matched events are added
+     */
+    void filter(const IoEventColumns &columns,
+                IoFilterImplementation implementation,
+                IoFilterResult &result) const;
+
+    /**
+     * @return Implementations supported by the CPU, the fastest one last
+     */
+    static std::vector<IoFilterImplementation> getSupportedImplementations();
+
+    static std::string getImplementationName(
+            IoFilterImplementation implementation);
+
+    /**
+     * @throw Exception when implementation is unknown or not supported
+     */
+    static IoFilterImplementation getImplementation(const std::string &name);
+
+private:
+    IoFilterCriteria m_criteria;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_IOEVENTFILTER_H
@@ -0,0 +1,62 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "IoMatchingHandler.h"
+
+namespace octf {
+
+IoMatchingHandler::IoMatchingHandler(const std::string &tracePath,
+                                     uint32_t capacity,
+                                     uint64_t timeout)
+        : TraceEventHandler<proto::trace::Event>(tracePath)
+        , m_matcher(capacity, timeout)
+        , m_eventCount(0) {}
+
+void IoMatchingHandler::handleEvent(
+        std::shared_ptr<proto::trace::Event> traceEvent) {
+    m_eventCount++;
+
+    switch (traceEvent->EventType_case()) {
+    case proto::trace::Event::kIo: {
+        const auto &pbIo = traceEvent->io();
+        InFlightIo io;
+
+        io.id = pbIo.id();
+        io.sid = traceEvent->header().sid();
+        io.timestamp = traceEvent->header().timestamp();
+        io.deviceId = pbIo.deviceid();
+        io.lba = pbIo.lba();
+        io.len = pbIo.len();
+        io.ioClass = pbIo.ioclass();
+        io.writeHint = pbIo.writehint();
+        io.operation = pbIo.operation();
+        io.flush = pbIo.flush();
+        io.fua = pbIo.fua();
+
+        m_matcher.queue(io);
+    } break;
+
+    case proto::trace::Event::kIoCompletion: {
+        const auto &completion = traceEvent->iocompletion();
+        InFlightIo io;
+
+        m_matcher.complete(completion.refid(), completion.deviceid(),
+                           traceEvent->header().timestamp(), io);
+    } break;
+
+    default:
+        break;
+    }
+}
+
+const InFlightIoMatcher &IoMatchingHandler::getMatcher() const {
+    return m_matcher;
+}
+
+uint64_t IoMatchingHandler::getEventCount() const {
+    return m_eventCount;
+}
+
+}  // namespace octf
@@ -0,0 +1,45 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_IOMATCHINGHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_IOMATCHINGHANDLER_H
+
+#include <memory>
+#include <string>
+#include <octf/proto/trace.pb.h>
+#include <octf/trace/parser/TraceEventHandler.h>
+#include "InFlightIoMatcher.h"
+
+namespace octf {
+
+/**
+ * @brief Raw trace event handler matching IO queue and completion events
+ */
+class IoMatchingHandler : public TraceEventHandler<proto::trace::Event> {
+public:
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param capacity Maximum number of IOs in flight
+     * @param timeout Maximum IO latency in ns, older IOs are evicted
+     */
+    IoMatchingHandler(const std::string &tracePath,
+                      uint32_t capacity,
+                      uint64_t timeout);
+    virtual ~IoMatchingHandler() = default;
+
+    void handleEvent(std::shared_ptr<proto::trace::Event> traceEvent) override;
+
+    const InFlightIoMatcher &getMatcher() const;
+
+    uint64_t getEventCount() const;
+
+private:
+    InFlightIoMatcher m_matcher;
+    uint64_t m_eventCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_IOMATCHINGHANDLER_H
@@ -0,0 +1,289 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "IoUring.h"
+#include <octf/utils/Exception.h>
+
+#ifdef IOTRACE_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace octf {
+
+static constexpr uint64_t NS_IN_SEC = 1000000000ULL;
+
+static void *mapRing(int fd, uint64_t size, uint64_t offset) {
+    void *ring = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (ring == MAP_FAILED) {
+        throw Exception("Cannot map io_uring: " +
+                        std::string(strerror(errno)));
+    }
+
+    return ring;
+}
+
+template <typename T>
+static T *getRingField(void *ring, uint32_t offset) {
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+IoUring::IoUring(uint32_t entries)
+        : m_fd(-1)
+        , m_sqRing(nullptr)
+        , m_sqRingSize(0)
+        , m_cqRing(nullptr)
+        , m_cqRingSize(0)
+        , m_entries(nullptr)
+        , m_entriesSize(0)
+        , m_sqHead(nullptr)
+        , m_sqTail(nullptr)
+        , m_sqMask(0)
+        , m_sqArray(nullptr)
+        , m_sqEntries(0)
+        , m_cqHead(nullptr)
+        , m_cqTail(nullptr)
+        , m_cqMask(0)
+        , m_cqes(nullptr)
+        , m_pendingTail(0)
+        , m_timeout() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    m_fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (m_fd < 0) {
+        throw Exception("Cannot set up io_uring: " +
+                        std::string(strerror(errno)));
+    }
+
+    try {
+        m_sqRingSize = params.sq_off.array +
+                       params.sq_entries * sizeof(uint32_t);
+        m_cqRingSize = params.cq_off.cqes +
+                       params.cq_entries * sizeof(struct io_uring_cqe);
+        m_entriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+        m_sqRing = mapRing(m_fd, m_sqRingSize, IORING_OFF_SQ_RING);
+        m_cqRing = mapRing(m_fd, m_cqRingSize, IORING_OFF_CQ_RING);
+        m_entries = mapRing(m_fd, m_entriesSize, IORING_OFF_SQES);
+    } catch (...) {
+        release();
+        throw;
+    }
+
+    m_sqHead = getRingField<uint32_t>(m_sqRing, params.sq_off.head);
+    m_sqTail = getRingField<uint32_t>(m_sqRing, params.sq_off.tail);
+    m_sqMask = *getRingField<uint32_t>(m_sqRing, params.sq_off.ring_mask);
+    m_sqArray = getRingField<uint32_t>(m_sqRing, params.sq_off.array);
+    m_sqEntries = params.sq_entries;
+    m_cqHead = getRingField<uint32_t>(m_cqRing, params.cq_off.head);
+    m_cqTail = getRingField<uint32_t>(m_cqRing, params.cq_off.tail);
+    m_cqMask = *getRingField<uint32_t>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = getRingField<void>(m_cqRing, params.cq_off.cqes);
+    m_pendingTail = *m_sqTail;
+}
+
+IoUring::~IoUring() {
+    release();
+}
+
+void IoUring::release() {
+    if (m_entries) {
+        munmap(m_entries, m_entriesSize);
+        m_entries = nullptr;
+    }
+    if (m_cqRing) {
+        munmap(m_cqRing, m_cqRingSize);
+        m_cqRing = nullptr;
+    }
+    if (m_sqRing) {
+        munmap(m_sqRing, m_sqRingSize);
+        m_sqRing = nullptr;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void *IoUring::getEntry() {
+    uint32_t head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (m_pendingTail - head >= m_sqEntries) {
+        return nullptr;
+    }
+
+    uint32_t index = m_pendingTail & m_sqMask;
+    auto *sqe = static_cast<struct io_uring_sqe *>(m_entries) + index;
+
+    memset(sqe, 0, sizeof(*sqe));
+    m_sqArray[index] = index;
+    m_pendingTail++;
+
+    return sqe;
+}
+
+static bool prepareVectored(void *entry,
+                            uint8_t opcode,
+                            int fd,
+                            const struct iovec *iov,
+                            uint64_t offset,
+                            uint64_t userData) {
+    auto *sqe = static_cast<struct io_uring_sqe *>(entry);
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepareRead(int fd,
+                          const struct iovec *iov,
+                          uint64_t offset,
+                          uint64_t userData) {
+    return prepareVectored(getEntry(), IORING_OP_READV, fd, iov, offset,
+                           userData);
+}
+
+bool IoUring::prepareWrite(int fd,
+                           const struct iovec *iov,
+                           uint64_t offset,
+                           uint64_t userData) {
+    return prepareVectored(getEntry(), IORING_OP_WRITEV, fd, iov, offset,
+                           userData);
+}
+
+bool IoUring::prepareFsync(int fd, uint64_t userData) {
+    auto *sqe = static_cast<struct io_uring_sqe *>(getEntry());
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd;
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepareTimeout(uint64_t timeout, uint64_t userData) {
+    auto *sqe = static_cast<struct io_uring_sqe *>(getEntry());
+    if (!sqe) {
+        return false;
+    }
+
+    // Same layout as struct __kernel_timespec
+    m_timeout[0] = timeout / NS_IN_SEC;
+    m_timeout[1] = timeout % NS_IN_SEC;
+
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(m_timeout);
+    sqe->len = 1;
+    // Complete on the first completion of any other entry too
+    sqe->off = 1;
+    sqe->user_data = userData;
+    return true;
+}
+
+void IoUring::submit(uint32_t waitCount) {
+    uint32_t tail = *m_sqTail;
+    uint32_t count = m_pendingTail - tail;
+    __atomic_store_n(m_sqTail, m_pendingTail, __ATOMIC_RELEASE);
+
+    while (count || waitCount) {
+        int result = syscall(__NR_io_uring_enter, m_fd, count, waitCount,
+                             waitCount ? IORING_ENTER_GETEVENTS : 0, nullptr,
+                             0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Entries not taken by the kernel stay prepared for next submit
+            __atomic_store_n(m_sqTail, m_pendingTail - count, __ATOMIC_RELEASE);
+            throw Exception("Cannot submit to io_uring: " +
+                            std::string(strerror(errno)));
+        }
+
+        count -= std::min<uint32_t>(count, result);
+        waitCount = 0;
+    }
+}
+
+bool IoUring::reap(uint64_t &userData, int32_t &result) {
+    uint32_t head = *m_cqHead;
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    const auto *cqe =
+            static_cast<struct io_uring_cqe *>(m_cqes) + (head & m_cqMask);
+    userData = cqe->user_data;
+    result = cqe->res;
+
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+}  // namespace octf
+
+#else
+
+namespace octf {
+
+IoUring::IoUring(uint32_t entries) {
+    (void) entries;
+    throw Exception("io_uring is not supported by this build");
+}
+
+IoUring::~IoUring() {}
+
+void IoUring::release() {}
+
+bool IoUring::prepareRead(int, const struct iovec *, uint64_t, uint64_t) {
+    return false;
+}
+
+bool IoUring::prepareWrite(int, const struct iovec *, uint64_t, uint64_t) {
+    return false;
+}
+
+bool IoUring::prepareFsync(int, uint64_t) {
+    return false;
+}
+
+bool IoUring::prepareTimeout(uint64_t, uint64_t) {
+    return false;
+}
+
+void IoUring::submit(uint32_t) {}
+
+bool IoUring::reap(uint64_t &, int32_t &) {
+    return false;
+}
+
+}  // namespace octf
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_IOURING_H
+#define SOURCE_USERSPACE_ANALYTICS_IOURING_H
+
+#include <sys/uio.h>
+#include <cstdint>
+
+namespace octf {
+
+/**
+ * @brief Minimal io_uring instance driven by raw system calls
+ *
+ * Only operations needed to replay block IO are supported. Entries are
+ * prepared in the submission queue and handed to the kernel by submit(),
+ * completions are reaped without system calls.
+ *
+ * @note Requires Linux 5.4 or newer, and a build with io_uring headers
+ * (IOTRACE_HAS_IO_URING)
+ */
+class IoUring {
+public:
+    /**
+     * @param entries Number of submission queue entries
+     *
+     * @throw Exception when io_uring is not supported
+     */
+    explicit IoUring(uint32_t entries);
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    /**
+     * @retval false Submission queue full
+     */
+    bool prepareRead(int fd,
+                     const struct iovec *iov,
+                     uint64_t offset,
+                     uint64_t userData);
+
+    /**
+     * @retval false Submission queue full
+     */
+    bool prepareWrite(int fd,
+                      const struct iovec *iov,
+                      uint64_t offset,
+                      uint64_t userData);
+
+    /**
+     * @retval false Submission queue full
+     */
+    bool prepareFsync(int fd, uint64_t userData);
+
+    /**
+     * @brief Prepares timeout which completes after given time, or as soon
+     * as any other entry completes
+     *
+     * @retval false Submission queue full
+     */
+    bool prepareTimeout(uint64_t timeout, uint64_t userData);
+
+    /**
+     * @brief Submits prepared entries
+     *
+     * @param waitCount Number of completions to wait for
+     *
+     * @throw Exception when submission fails, entries not submitted stay
+     * prepared
+     */
+    void submit(uint32_t waitCount);
+
+    /**
+     * @param[out] userData User data of completed entry
+     * @param[out] result Result of completed entry, negative errno on error
+     *
+     * @retval true Completion reaped
+     * @retval false No completion available
+     */
+    bool reap(uint64_t &userData, int32_t &result);
+
+private:
+    void *getEntry();
+
+    void release();
+
+    int m_fd;
+    void *m_sqRing;
+    uint64_t m_sqRingSize;
+    void *m_cqRing;
+    uint64_t m_cqRingSize;
+    void *m_entries;
+    uint64_t m_entriesSize;
+    uint32_t *m_sqHead;
+    uint32_t *m_sqTail;
+    uint32_t m_sqMask;
+    uint32_t *m_sqArray;
+    uint32_t m_sqEntries;
+    uint32_t *m_cqHead;
+    uint32_t *m_cqTail;
+    uint32_t m_cqMask;
+    void *m_cqes;
+    /** Tail of prepared, not yet submitted entries */
+    uint32_t m_pendingTail;
+    /** Timespec of the prepared timeout, read by the kernel on submit */
+    int64_t m_timeout[2];
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_IOURING_H
@@ -0,0 +1,194 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint32_t LatencyHistogram::MIN_PRECISION;
+constexpr uint32_t LatencyHistogram::MAX_PRECISION;
+
+LatencyHistogram::LatencyHistogram(uint32_t precision)
+        : m_precision(precision)
+        , m_bits(0)
+        , m_subBuckets(1)
+        , m_counts()
+        , m_count(0)
+        , m_min(0)
+        , m_max(0)
+        , m_sum(0) {
+    if (precision < MIN_PRECISION || precision > MAX_PRECISION) {
+        throw Exception("Invalid latency histogram precision");
+    }
+
+    // Smallest power of two sub-bucket count giving requested precision
+    uint64_t required = 1;
+    for (uint32_t i = 0; i < precision; i++) {
+        required *= 10;
+    }
+    while (m_subBuckets < required) {
+        m_subBuckets <<= 1;
+        m_bits++;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    if (other.m_precision != m_precision) {
+        throw Exception("Cannot merge latency histograms of different "
+                        "precision");
+    }
+
+    if (!other.m_count) {
+        return;
+    }
+
+    if (other.m_counts.size() > m_counts.size()) {
+        m_counts.resize(other.m_counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.m_counts.size(); i++) {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_min = m_count ? std::min(m_min, other.m_min) : other.m_min;
+    m_max = std::max(m_max, other.m_max);
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (!m_count) {
+        return 0;
+    }
+
+    percentile = std::min(100.0, std::max(0.0, percentile));
+    uint64_t rank = static_cast<uint64_t>(
+            std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < m_counts.size(); i++) {
+        total += m_counts[i];
+
+        if (total >= rank) {
+            return std::min(highestEquivalentValue(i), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return m_count;
+}
+
+uint64_t LatencyHistogram::getMin() const {
+    return m_min;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return m_max;
+}
+
+double LatencyHistogram::getMean() const {
+    return m_count ? m_sum / m_count : 0.0;
+}
+
+uint32_t LatencyHistogram::getPrecision() const {
+    return m_precision;
+}
+
+double LatencyHistogram::getSum() const {
+    return m_sum;
+}
+
+const std::vector<uint64_t> &LatencyHistogram::getCounts() const {
+    return m_counts;
+}
+
+void LatencyHistogram::restore(const std::vector<uint64_t> &counts,
+                               uint64_t min,
+                               uint64_t max,
+                               double sum) {
+    if (counts.size() > indexOf(~0ULL) + 1) {
+        throw Exception("Invalid latency histogram counters");
+    }
+
+    uint64_t count = 0;
+    for (auto value : counts) {
+        count += value;
+    }
+
+    if (count && (min > max || indexOf(max) >= counts.size())) {
+        throw Exception("Invalid latency histogram range");
+    }
+
+    m_counts = counts;
+    m_count = count;
+    m_min = count ? min : 0;
+    m_max = count ? max : 0;
+    m_sum = count ? sum : 0;
+}
+
+double LatencyHistogram::getDistance(const LatencyHistogram &other) const {
+    if (other.m_precision != m_precision) {
+        throw Exception("Cannot compare latency histograms of different "
+                        "precision");
+    }
+
+    if (!m_count || !other.m_count) {
+        return 0.0;
+    }
+
+    size_t size = std::max(m_counts.size(), other.m_counts.size());
+    uint64_t total = 0, otherTotal = 0;
+    double distance = 0.0;
+
+    for (size_t i = 0; i < size; i++) {
+        total += i < m_counts.size() ? m_counts[i] : 0;
+        otherTotal += i < other.m_counts.size() ? other.m_counts[i] : 0;
+
+        double difference =
+                static_cast<double>(total) / m_count -
+                static_cast<double>(otherTotal) / other.m_count;
+        distance = std::max(distance, std::fabs(difference));
+    }
+
+    return distance;
+}
+
+double LatencyHistogram::getCriticalDistance(uint64_t count,
+                                             uint64_t otherCount) {
+    // Coefficient of the asymptotic Kolmogorov distribution for alpha = 0.01
+    static constexpr double COEFFICIENT = 1.628;
+
+    if (!count || !otherCount) {
+        return 1.0;
+    }
+
+    double n = static_cast<double>(count);
+    double m = static_cast<double>(otherCount);
+    return std::min(1.0, COEFFICIENT * std::sqrt((n + m) / (n * m)));
+}
+
+uint64_t LatencyHistogram::getMemoryUsage() const {
+    return m_counts.size() * sizeof(m_counts[0]);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(uint64_t index) const {
+    if (index < m_subBuckets) {
+        return index;
+    }
+
+    uint64_t shift = index / m_subBuckets - 1;
+    uint64_t sub = index % m_subBuckets;
+    uint64_t low = (m_subBuckets + sub) << shift;
+
+    return low + ((1ULL << shift) - 1);
+}
+
+}  // namespace octf
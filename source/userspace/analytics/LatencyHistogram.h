@@ -0,0 +1,145 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_LATENCYHISTOGRAM_H
+#define SOURCE_USERSPACE_ANALYTICS_LATENCYHISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief High dynamic range histogram with log-linear buckets
+ *
+ * Values lower than 2^bits are counted exactly. Every next power of two
+ * range is split into 2^bits equal buckets, so the relative width of any
+ * bucket is at most 2^-bits, which bounds the relative error of reported
+ * percentiles. The whole 64-bit range is covered, counters are allocated
+ * only up to the biggest recorded value.
+ *
+ * Histograms of the same precision merge exactly: the merged histogram is
+ * identical to the one built from all values, so values can be recorded by
+ * independent workers.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t MIN_PRECISION = 1;
+    static constexpr uint32_t MAX_PRECISION = 5;
+
+    /**
+     * @param precision Number of significant decimal digits kept,
+     * relative error is lower than 10^-precision
+     */
+    explicit LatencyHistogram(uint32_t precision);
+
+    void record(uint64_t value) {
+        uint64_t index = indexOf(value);
+
+        if (index >= m_counts.size()) {
+            m_counts.resize(index + 1, 0);
+        }
+        m_counts[index]++;
+
+        if (!m_count || value < m_min) {
+            m_min = value;
+        }
+        if (value > m_max) {
+            m_max = value;
+        }
+        m_count++;
+        m_sum += value;
+    }
+
+    /**
+     * @throw Exception when precisions differ
+     */
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * @param percentile Percentile in range 0..100
+     *
+     * @return The highest value equivalent to the value at percentile
+     */
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    uint64_t getCount() const;
+
+    uint64_t getMin() const;
+
+    uint64_t getMax() const;
+
+    double getMean() const;
+
+    uint32_t getPrecision() const;
+
+    double getSum() const;
+
+    /**
+     * @return Bucket counters, together with min, max and sum they allow
+     * to persist the histogram
+     */
+    const std::vector<uint64_t> &getCounts() const;
+
+    /**
+     * @brief Restores persisted histogram of the same precision
+     *
+     * @throw Exception when counters do not match the precision
+     */
+    void restore(const std::vector<uint64_t> &counts,
+                 uint64_t min,
+                 uint64_t max,
+                 double sum);
+
+    /**
+     * @brief Two-sample Kolmogorov-Smirnov distance to other histogram
+     *
+     * Histograms of the same precision share bucket boundaries, so the
+     * greatest difference of the cumulative distributions is evaluated
+     * exactly at bucket granularity.
+     *
+     * @return Distance in range 0..1, 0 when either histogram is empty
+     *
+     * @throw Exception when precisions differ
+     */
+    double getDistance(const LatencyHistogram &other) const;
+
+    /**
+     * @brief Distance above which two samples of given sizes come from
+     * different distributions at 1% significance level
+     */
+    static double getCriticalDistance(uint64_t count, uint64_t otherCount);
+
+    /**
+     * @return Number of bytes occupied by counters
+     */
+    uint64_t getMemoryUsage() const;
+
+private:
+    uint64_t indexOf(uint64_t value) const {
+        if (value < m_subBuckets) {
+            return value;
+        }
+
+        uint32_t shift = 63 - __builtin_clzll(value) - m_bits;
+        return (static_cast<uint64_t>(shift) + 1) * m_subBuckets +
+               ((value >> shift) - m_subBuckets);
+    }
+
+    uint64_t highestEquivalentValue(uint64_t index) const;
+
+    uint32_t m_precision;
+    uint32_t m_bits;
+    uint64_t m_subBuckets;
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count;
+    uint64_t m_min;
+    uint64_t m_max;
+    double m_sum;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_LATENCYHISTOGRAM_H
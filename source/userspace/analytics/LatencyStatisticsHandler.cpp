@@ -0,0 +1,98 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "LatencyStatisticsHandler.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+const char *getLatencyOperationName(LatencyOperation operation) {
+    switch (operation) {
+    case LatencyOperation::Read:
+        return "read";
+    case LatencyOperation::Write:
+        return "write";
+    case LatencyOperation::Discard:
+        return "discard";
+    case LatencyOperation::Flush:
+        return "flush";
+    default:
+        return "unknown";
+    }
+}
+
+bool getLatencyOperation(const proto::trace::ParsedEvent &io,
+                         LatencyOperation &operation) {
+    const auto &pbIo = io.io();
+
+    if (pbIo.error()) {
+        return false;
+    }
+
+    if (pbIo.flush() && !pbIo.len()) {
+        operation = LatencyOperation::Flush;
+        return true;
+    }
+
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+        operation = LatencyOperation::Read;
+        return true;
+    case proto::trace::IoType::Write:
+        operation = LatencyOperation::Write;
+        return true;
+    case proto::trace::IoType::Discard:
+        operation = LatencyOperation::Discard;
+        return true;
+    default:
+        return false;
+    }
+}
+
+LatencyStatisticsHandler::LatencyStatisticsHandler(
+        const std::string &tracePath,
+        uint32_t precision)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_precision(precision)
+        , m_histograms()
+        , m_deviceNames() {
+    if (precision < LatencyHistogram::MIN_PRECISION ||
+        precision > LatencyHistogram::MAX_PRECISION) {
+        throw Exception("Invalid latency histogram precision");
+    }
+}
+
+void LatencyStatisticsHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    LatencyOperation operation;
+    if (!getLatencyOperation(io, operation)) {
+        return;
+    }
+
+    uint64_t deviceId = io.device().id();
+    auto histograms = m_histograms.find(deviceId);
+    if (histograms == m_histograms.end()) {
+        std::vector<LatencyHistogram> empty(
+                static_cast<size_t>(LatencyOperation::Count),
+                LatencyHistogram(m_precision));
+
+        histograms = m_histograms.insert(std::make_pair(deviceId, empty)).first;
+        m_deviceNames[deviceId] = io.device().name();
+    }
+
+    histograms->second[static_cast<size_t>(operation)].record(
+            io.io().latency());
+}
+
+const std::map<uint64_t, std::vector<LatencyHistogram>>
+        &LatencyStatisticsHandler::getHistograms() const {
+    return m_histograms;
+}
+
+const std::map<uint64_t, std::string>
+        &LatencyStatisticsHandler::getDeviceNames() const {
+    return m_deviceNames;
+}
+
+}  // namespace octf
@@ -0,0 +1,71 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_LATENCYSTATISTICSHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_LATENCYSTATISTICSHANDLER_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "LatencyHistogram.h"
+
+namespace octf {
+
+enum class LatencyOperation {
+    Read = 0,
+    Write,
+    Discard,
+    Flush,
+    Count,
+};
+
+const char *getLatencyOperationName(LatencyOperation operation);
+
+/**
+ * @brief Classifies parsed IO, flushes without data are reported separately
+ *
+ * @param io Parsed IO
+ * @param[out] operation Operation of the IO
+ *
+ * @retval true IO classified
+ * @retval false IO failed or of unknown operation
+ */
+bool getLatencyOperation(const proto::trace::ParsedEvent &io,
+                         LatencyOperation &operation);
+
+/**
+ * @brief Parsed IO handler collecting HDR latency histograms per device
+ * and operation
+ */
+class LatencyStatisticsHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param precision Number of significant decimal digits of histograms
+     */
+    LatencyStatisticsHandler(const std::string &tracePath,
+                             uint32_t precision);
+    virtual ~LatencyStatisticsHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @return Histograms indexed by LatencyOperation, by device id
+     */
+    const std::map<uint64_t, std::vector<LatencyHistogram>> &getHistograms()
+            const;
+
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+private:
+    const uint32_t m_precision;
+    std::map<uint64_t, std::vector<LatencyHistogram>> m_histograms;
+    std::map<uint64_t, std::string> m_deviceNames;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_LATENCYSTATISTICSHANDLER_H
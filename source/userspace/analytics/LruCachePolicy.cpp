@@ -0,0 +1,84 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "LruCachePolicy.h"
+
+namespace octf {
+
+constexpr const char *LruCachePolicy::NAME;
+
+LruCachePolicy::LruCachePolicy(uint64_t capacity, CacheMode mode)
+        : CachePolicy(capacity, mode)
+        , m_table(capacity)
+        , m_pool(capacity)
+        , m_lru() {}
+
+bool LruCachePolicy::reference(uint64_t key, bool dirty) {
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        m_pool.moveToFront(m_lru, index);
+        m_pool[index].dirty |= dirty;
+        return true;
+    }
+
+    if (m_lru.size >= m_capacity) {
+        uint32_t victim = m_lru.tail;
+
+        evicted(m_pool[victim].dirty);
+        m_table.erase(m_pool[victim].key);
+        m_pool.remove(m_lru, victim);
+        m_pool.release(victim);
+    }
+
+    index = m_pool.allocate(key);
+    m_pool[index].dirty = dirty;
+    m_pool.pushFront(m_lru, 0, index);
+    m_table.insert(key, index);
+
+    return false;
+}
+
+void LruCachePolicy::drop(uint32_t index) {
+    m_table.erase(m_pool[index].key);
+    m_pool.remove(m_lru, index);
+    m_pool.release(index);
+}
+
+void LruCachePolicy::invalidate(uint64_t key) {
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        drop(index);
+    }
+}
+
+uint64_t LruCachePolicy::getTrackedCount() const {
+    return m_table.size();
+}
+
+void LruCachePolicy::invalidateTracked(uint64_t first, uint64_t last) {
+    uint32_t index = m_lru.head;
+
+    while (index != CacheNodePool::NONE) {
+        uint32_t next = m_pool[index].next;
+        uint64_t key = m_pool[index].key;
+
+        if (key >= first && key <= last) {
+            drop(index);
+        }
+        index = next;
+    }
+}
+
+const char *LruCachePolicy::getName() const {
+    return NAME;
+}
+
+uint64_t LruCachePolicy::getMemoryUsage() const {
+    return m_table.getMemoryUsage() + m_pool.getMemoryUsage();
+}
+
+}  // namespace octf
@@ -0,0 +1,46 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_LRUCACHEPOLICY_H
+#define SOURCE_USERSPACE_ANALYTICS_LRUCACHEPOLICY_H
+
+#include "CachePolicy.h"
+
+namespace octf {
+
+/**
+ * @brief Least recently used eviction policy
+ */
+class LruCachePolicy : public CachePolicy {
+public:
+    static constexpr const char *NAME = "lru";
+
+    LruCachePolicy(uint64_t capacity, CacheMode mode);
+    virtual ~LruCachePolicy() = default;
+
+    void invalidate(uint64_t key) override;
+
+    const char *getName() const override;
+
+    uint64_t getMemoryUsage() const override;
+
+protected:
+    bool reference(uint64_t key, bool dirty) override;
+
+    uint64_t getTrackedCount() const override;
+
+    void invalidateTracked(uint64_t first, uint64_t last) override;
+
+private:
+    void drop(uint32_t index);
+
+    CacheLineTable m_table;
+    CacheNodePool m_pool;
+    CacheNodePool::List m_lru;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_LRUCACHEPOLICY_H
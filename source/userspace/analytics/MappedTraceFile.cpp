@@ -0,0 +1,65 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "MappedTraceFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+MappedTraceFile::MappedTraceFile(const std::string &path)
+        : m_fd(-1)
+        , m_data(nullptr)
+        , m_size(0) {
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw Exception("Cannot open trace file " + path);
+    }
+
+    struct stat info;
+    if (fstat(m_fd, &info)) {
+        close(m_fd);
+        throw Exception("Cannot get size of trace file " + path);
+    }
+
+    m_size = info.st_size;
+    if (!m_size) {
+        // Nothing to map, e.g. queue without any event
+        return;
+    }
+
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close(m_fd);
+        throw Exception("Cannot map trace file " + path);
+    }
+    m_data = static_cast<uint8_t *>(data);
+
+    // Hints only, failures do not matter
+    madvise(m_data, m_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(m_data, m_size, MADV_HUGEPAGE);
+#endif
+}
+
+MappedTraceFile::~MappedTraceFile() {
+    if (m_data) {
+        munmap(m_data, m_size);
+    }
+    close(m_fd);
+}
+
+const uint8_t *MappedTraceFile::getData() const {
+    return m_data;
+}
+
+uint64_t MappedTraceFile::getSize() const {
+    return m_size;
+}
+
+}  // namespace octf
@@ -0,0 +1,44 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEFILE_H
+#define SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEFILE_H
+
+#include <cstdint>
+#include <string>
+
+namespace octf {
+
+/**
+ * @brief Read-only memory mapping of a whole trace file
+ *
+ * The kernel is advised that the mapping is read sequentially, so it reads
+ * ahead aggressively and drops pages behind the reader. Huge pages are
+ * requested where the file system supports them.
+ */
+class MappedTraceFile {
+public:
+    /**
+     * @throw Exception when the file cannot be mapped
+     */
+    explicit MappedTraceFile(const std::string &path);
+    ~MappedTraceFile();
+
+    MappedTraceFile(const MappedTraceFile &) = delete;
+    MappedTraceFile &operator=(const MappedTraceFile &) = delete;
+
+    const uint8_t *getData() const;
+
+    uint64_t getSize() const;
+
+private:
+    int m_fd;
+    uint8_t *m_data;
+    uint64_t m_size;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEFILE_H
@@ -0,0 +1,129 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "MappedTraceReader.h"
+#include <unistd.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+
+namespace octf {
+
+static constexpr auto TRACE_FILE_PREFIX = "octf.trace.";
+
+MappedTraceReader::MappedTraceReader(const std::string &tracePath)
+        : m_queues()
+        , m_heads()
+        , m_size(0) {
+    std::string dir =
+            getFrameworkConfiguration().getTraceRepositoryPath() + "/" +
+            tracePath + "/";
+
+    // Queue files are numbered from zero
+    for (uint32_t i = 0;; i++) {
+        std::string path = dir + TRACE_FILE_PREFIX + std::to_string(i);
+        if (access(path.c_str(), F_OK)) {
+            break;
+        }
+
+        m_queues.emplace_back();
+        m_queues.back().file.reset(new MappedTraceFile(path));
+        m_queues.back().offset = 0;
+        m_size += m_queues.back().file->getSize();
+    }
+
+    if (m_queues.empty()) {
+        throw Exception("No trace files found, trace path " + tracePath);
+    }
+
+    for (uint32_t i = 0; i < m_queues.size(); i++) {
+        auto &queue = m_queues[i];
+        if (advance(queue)) {
+            m_heads.emplace(queue.head->header().timestamp(),
+                            queue.head->header().sid(), i);
+        }
+    }
+}
+
+bool MappedTraceReader::read(std::shared_ptr<proto::trace::Event> &event) {
+    if (m_heads.empty()) {
+        return false;
+    }
+
+    uint32_t index = std::get<2>(m_heads.top());
+    m_heads.pop();
+
+    // Hand the head over, the caller's previous message returns to its pool
+    auto &queue = m_queues[index];
+    event = std::move(queue.head);
+
+    if (advance(queue)) {
+        m_heads.emplace(queue.head->header().timestamp(),
+                        queue.head->header().sid(), index);
+    }
+
+    return true;
+}
+
+uint64_t MappedTraceReader::getSize() const {
+    return m_size;
+}
+
+uint32_t MappedTraceReader::getQueueCount() const {
+    return m_queues.size();
+}
+
+uint64_t MappedTraceReader::getAllocationCount() const {
+    uint64_t count = 0;
+    for (const auto &queue : m_queues) {
+        count += queue.pool.getAllocationCount();
+    }
+    return count;
+}
+
+bool MappedTraceReader::advance(Queue &queue) {
+    const uint8_t *data = queue.file->getData();
+    uint64_t size = queue.file->getSize();
+
+    if (queue.offset >= size) {
+        return false;
+    }
+
+    // Message length as varint32
+    uint64_t length = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        if (queue.offset >= size || shift > 28) {
+            throw Exception("Invalid trace file, corrupted message length");
+        }
+
+        uint8_t byte = data[queue.offset++];
+        length |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+
+    if (length > size - queue.offset) {
+        throw Exception("Invalid trace file, truncated message");
+    }
+
+    // Merge into a recycled message of the same type, parsing would clear
+    // the message and free its event type member
+    const uint8_t *message = data + queue.offset;
+    queue.head = queue.pool.get(
+            EventMessagePool::peekEventType(message, length));
+
+    google::protobuf::io::CodedInputStream input(message,
+                                                 static_cast<int>(length));
+    if (!queue.head->MergeFromCodedStream(&input) ||
+        !input.ConsumedEntireMessage()) {
+        throw Exception("Invalid trace file, cannot parse event");
+    }
+    queue.offset += length;
+
+    return true;
+}
+
+}  // namespace octf
@@ -0,0 +1,93 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEREADER_H
+#define SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEREADER_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <octf/proto/trace.pb.h>
+#include "EventMessagePool.h"
+#include "MappedTraceFile.h"
+
+namespace octf {
+
+/**
+ * @brief Reads raw trace events directly from memory mapped trace files
+ *
+ * Each trace queue (one per CPU) is stored in its own file as a sequence
+ * of length delimited event messages. Messages are parsed in place from
+ * the mapping, without copying the file through read buffers, and queues
+ * are merged by event timestamp.
+ *
+ * Event messages are recycled from per queue pools once the caller drops
+ * them, so no message is allocated per event in steady state.
+ */
+class MappedTraceReader {
+public:
+    /**
+     * @param tracePath Path of the trace in trace repository
+     *
+     * @throw Exception when the trace cannot be opened
+     */
+    explicit MappedTraceReader(const std::string &tracePath);
+
+    /**
+     * @brief Reads the next event in timestamp order
+     *
+     * @param[out] event Event read, the message previously held by the caller
+     * is released for recycling
+     *
+     * @retval true Event read
+     * @retval false End of trace
+     *
+     * @throw Exception when trace file is corrupted
+     */
+    bool read(std::shared_ptr<proto::trace::Event> &event);
+
+    /**
+     * @return Total size of trace files in bytes
+     */
+    uint64_t getSize() const;
+
+    uint32_t getQueueCount() const;
+
+    /**
+     * @return Number of event messages allocated while reading
+     */
+    uint64_t getAllocationCount() const;
+
+private:
+    struct Queue {
+        std::unique_ptr<MappedTraceFile> file;
+        uint64_t offset;
+        EventMessagePool pool;
+        std::shared_ptr<proto::trace::Event> head;
+    };
+
+    /**
+     * @brief Parses next event of the queue into its head
+     *
+     * @retval false No more events in queue
+     */
+    bool advance(Queue &queue);
+
+    /** Timestamp, sid and index of queue with the head event */
+    typedef std::tuple<uint64_t, uint64_t, uint32_t> HeadKey;
+
+    std::vector<Queue> m_queues;
+    std::priority_queue<HeadKey, std::vector<HeadKey>, std::greater<HeadKey>>
+            m_heads;
+    uint64_t m_size;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_MAPPEDTRACEREADER_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "MarkerStatisticsHandler.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+#include "LatencyStatisticsHandler.h"
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+MarkerStatisticsHandler::DeviceStatistics::DeviceStatistics(
+        uint32_t precision)
+        : histograms(static_cast<size_t>(LatencyOperation::Count),
+                     LatencyHistogram(precision))
+        , bytes(static_cast<size_t>(LatencyOperation::Count), 0) {}
+
+MarkerStatisticsHandler::MarkerStatisticsHandler(
+        const std::string &tracePath,
+        const proto::TraceMarkers &markers,
+        uint32_t precision)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_precision(precision)
+        , m_markerSids()
+        , m_intervals(markers.marker_size() + 1)
+        , m_deviceNames() {
+    if (precision < LatencyHistogram::MIN_PRECISION ||
+        precision > LatencyHistogram::MAX_PRECISION) {
+        throw Exception("Invalid latency histogram precision");
+    }
+
+    for (const auto &marker : markers.marker()) {
+        if (!m_markerSids.empty() && marker.sid() <= m_markerSids.back()) {
+            throw Exception("Trace markers are not ordered");
+        }
+        m_markerSids.push_back(marker.sid());
+    }
+}
+
+void MarkerStatisticsHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    LatencyOperation operation;
+    if (!getLatencyOperation(io, operation)) {
+        return;
+    }
+
+    size_t index = std::upper_bound(m_markerSids.begin(), m_markerSids.end(),
+                                    io.header().sid()) -
+                   m_markerSids.begin();
+    auto &interval = m_intervals[index];
+
+    uint64_t deviceId = io.device().id();
+    auto device = interval.find(deviceId);
+    if (device == interval.end()) {
+        device = interval
+                         .insert(std::make_pair(deviceId,
+                                                DeviceStatistics(m_precision)))
+                         .first;
+        m_deviceNames[deviceId] = io.device().name();
+    }
+
+    auto i = static_cast<size_t>(operation);
+    device->second.histograms[i].record(io.io().latency());
+    device->second.bytes[i] += io.io().len() * SECTOR_SIZE;
+}
+
+const std::vector<MarkerStatisticsHandler::Interval>
+        &MarkerStatisticsHandler::getIntervals() const {
+    return m_intervals;
+}
+
+const std::map<uint64_t, std::string>
+        &MarkerStatisticsHandler::getDeviceNames() const {
+    return m_deviceNames;
+}
+
+}  // namespace octf
@@ -0,0 +1,70 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_MARKERSTATISTICSHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_MARKERSTATISTICSHANDLER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "InterfaceTraceAnalytics.pb.h"
+#include "LatencyHistogram.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler collecting statistics of intervals between user
+ * markers of the trace
+ *
+ * Markers share the sequence of trace events, an IO belongs to the interval
+ * of the latest marker written before the IO was queued. Interval 0 holds
+ * IOs queued before the first marker.
+ */
+class MarkerStatisticsHandler : public ParsedIoTraceEventHandler {
+public:
+    /** Statistics of a device within an interval */
+    struct DeviceStatistics {
+        explicit DeviceStatistics(uint32_t precision);
+
+        /** Histograms of latency, indexed by LatencyOperation */
+        std::vector<LatencyHistogram> histograms;
+
+        /** Transferred bytes, indexed by LatencyOperation */
+        std::vector<uint64_t> bytes;
+    };
+
+    typedef std::map<uint64_t, DeviceStatistics> Interval;
+
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param markers Markers of the trace in order of sid
+     * @param precision Number of significant decimal digits of histograms
+     */
+    MarkerStatisticsHandler(const std::string &tracePath,
+                            const proto::TraceMarkers &markers,
+                            uint32_t precision);
+    virtual ~MarkerStatisticsHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @return Statistics by device id, one more interval than markers
+     */
+    const std::vector<Interval> &getIntervals() const;
+
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+private:
+    const uint32_t m_precision;
+    std::vector<uint64_t> m_markerSids;
+    std::vector<Interval> m_intervals;
+    std::map<uint64_t, std::string> m_deviceNames;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_MARKERSTATISTICSHANDLER_H
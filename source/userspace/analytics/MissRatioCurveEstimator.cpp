@@ -0,0 +1,189 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "MissRatioCurveEstimator.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint64_t MissRatioCurveEstimator::SAMPLING_MODULUS;
+
+MissRatioCurveEstimator::MissRatioCurveEstimator(uint32_t sampleLimit,
+                                                 uint64_t binLines,
+                                                 uint32_t binCount)
+        : m_sampleLimit(sampleLimit)
+        , m_binLines(binLines)
+        , m_lastAccess(static_cast<uint64_t>(sampleLimit) + 1)
+        , m_timeKeys(2 * static_cast<uint64_t>(sampleLimit),
+                     CacheLineTable::EMPTY_KEY)
+        , m_tree(m_timeKeys.size() + 1, 0)
+        , m_time(0)
+        , m_samples()
+        , m_threshold(SAMPLING_MODULUS)
+        , m_histogram(binCount + 1, 0.0)
+        , m_accessCount(0)
+        , m_sampledCount(0) {
+    if (!m_sampleLimit || !m_binLines || !binCount) {
+        throw Exception("Invalid miss ratio curve estimator parameters");
+    }
+}
+
+void MissRatioCurveEstimator::access(uint64_t key) {
+    m_accessCount++;
+
+    uint64_t hash = samplingHash(key);
+    if (hash >= m_threshold) {
+        return;
+    }
+
+    m_sampledCount++;
+    double weight = static_cast<double>(SAMPLING_MODULUS) / m_threshold;
+
+    if (m_time == m_timeKeys.size()) {
+        compact();
+    }
+    uint32_t now = m_time++;
+
+    uint32_t last = m_lastAccess.find(key);
+    if (last == CacheLineTable::INVALID_VALUE) {
+        // Cold miss
+        m_histogram.back() += weight;
+        m_samples.push(std::make_pair(hash, key));
+    } else {
+        // Count distinct lines referenced in between
+        uint64_t distance = prefix(now) - prefix(last);
+        uint64_t bin = static_cast<uint64_t>(distance * weight) / m_binLines;
+
+        if (bin < m_histogram.size() - 1) {
+            m_histogram[bin] += weight;
+        } else {
+            m_histogram.back() += weight;
+        }
+
+        mark(last, -1);
+        m_timeKeys[last] = CacheLineTable::EMPTY_KEY;
+    }
+
+    mark(now, 1);
+    m_timeKeys[now] = key;
+    m_lastAccess.insert(key, now);
+
+    if (m_lastAccess.size() > m_sampleLimit) {
+        dropSamples();
+    }
+}
+
+std::vector<MissRatioPoint> MissRatioCurveEstimator::getCurve() const {
+    std::vector<MissRatioPoint> curve(m_histogram.size() - 1);
+
+    double weighted = 0;
+    for (auto value : m_histogram) {
+        weighted += value;
+    }
+
+    // SHARDS adjustment - the difference between the real and estimated
+    // number of references is attributed to the smallest reuse distances
+    double hits = static_cast<double>(m_accessCount) - weighted;
+
+    for (size_t i = 0; i < curve.size(); i++) {
+        hits += m_histogram[i];
+
+        curve[i].cacheLines = m_binLines * (i + 1);
+        if (m_accessCount) {
+            double ratio = 1.0 - hits / m_accessCount;
+            curve[i].missRatio = std::min(1.0, std::max(0.0, ratio));
+        } else {
+            curve[i].missRatio = 0.0;
+        }
+    }
+
+    return curve;
+}
+
+uint64_t MissRatioCurveEstimator::getAccessCount() const {
+    return m_accessCount;
+}
+
+uint64_t MissRatioCurveEstimator::getSampledAccessCount() const {
+    return m_sampledCount;
+}
+
+double MissRatioCurveEstimator::getSamplingRate() const {
+    return static_cast<double>(m_threshold) / SAMPLING_MODULUS;
+}
+
+uint64_t MissRatioCurveEstimator::getMemoryUsage() const {
+    return m_lastAccess.getMemoryUsage() +
+           m_timeKeys.size() * sizeof(m_timeKeys[0]) +
+           m_tree.size() * sizeof(m_tree[0]) +
+           m_samples.size() * sizeof(std::pair<uint64_t, uint64_t>) +
+           m_histogram.size() * sizeof(m_histogram[0]);
+}
+
+void MissRatioCurveEstimator::mark(uint32_t time, int32_t delta) {
+    for (uint64_t i = time + 1ULL; i < m_tree.size(); i += i & (~i + 1)) {
+        m_tree[i] += delta;
+    }
+}
+
+int64_t MissRatioCurveEstimator::prefix(uint32_t time) const {
+    int64_t sum = 0;
+    for (uint64_t i = time + 1ULL; i > 0; i -= i & (~i + 1)) {
+        sum += m_tree[i];
+    }
+    return sum;
+}
+
+void MissRatioCurveEstimator::compact() {
+    // Renumber latest references preserving their order
+    uint32_t count = 0;
+    for (uint32_t time = 0; time < m_time; time++) {
+        uint64_t key = m_timeKeys[time];
+        if (key != CacheLineTable::EMPTY_KEY) {
+            m_timeKeys[count] = key;
+            m_lastAccess.insert(key, count);
+            count++;
+        }
+    }
+
+    std::fill(m_timeKeys.begin() + count, m_timeKeys.end(),
+              CacheLineTable::EMPTY_KEY);
+    m_time = count;
+
+    // Rebuild the tree in linear time
+    std::fill(m_tree.begin(), m_tree.end(), 0);
+    for (uint64_t i = 1; i < m_tree.size(); i++) {
+        if (i <= count) {
+            m_tree[i] += 1;
+        }
+
+        uint64_t parent = i + (i & (~i + 1));
+        if (parent < m_tree.size()) {
+            m_tree[parent] += m_tree[i];
+        }
+    }
+}
+
+void MissRatioCurveEstimator::dropSamples() {
+    while (m_lastAccess.size() > m_sampleLimit) {
+        uint64_t threshold = m_samples.top().first;
+
+        // Drop all lines having hash at or above new threshold
+        while (!m_samples.empty() && m_samples.top().first >= threshold) {
+            uint64_t key = m_samples.top().second;
+            m_samples.pop();
+
+            uint32_t time = m_lastAccess.find(key);
+            mark(time, -1);
+            m_timeKeys[time] = CacheLineTable::EMPTY_KEY;
+            m_lastAccess.erase(key);
+        }
+
+        m_threshold = threshold;
+    }
+}
+
+}  // namespace octf
@@ -0,0 +1,133 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEESTIMATOR_H
+#define SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEESTIMATOR_H
+
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+/**
+ * @brief Single point of miss ratio curve
+ */
+struct MissRatioPoint {
+    /** Cache size in cache lines */
+    uint64_t cacheLines;
+
+    /** Estimated LRU miss ratio, 0..1 */
+    double missRatio;
+};
+
+/**
+ * @brief Estimates LRU miss ratio curve from sampled reuse distances
+ *
+ * Implementation of fixed-size SHARDS (Spatially Hashed Approximate Reuse
+ * Distance Sampling). A cache line is sampled when its hash is below
+ * the threshold, which gives the sampling rate R = threshold / modulus.
+ * Reuse distances of sampled lines are computed exactly within the sample
+ * set and scaled by 1/R.
+ *
+ * Memory is bounded by the sample limit. When more lines are sampled,
+ * the ones with the highest hash are dropped and the threshold is lowered
+ * to the dropped hash, so they will not be sampled anymore.
+ *
+ * Reuse distance is the number of distinct lines referenced since the last
+ * reference of the line. It is counted with Fenwick tree over logical
+ * timestamps of sampled references, where only the most recent reference
+ * of each line is marked. Timestamps are renumbered when the tree is full.
+ */
+class MissRatioCurveEstimator {
+public:
+    /**
+     * @param sampleLimit Maximum number of lines tracked at once
+     * @param binLines Histogram bin width in cache lines
+     * @param binCount Number of histogram bins, reuse distances beyond
+     * binLines * binCount are counted as misses
+     */
+    MissRatioCurveEstimator(uint32_t sampleLimit,
+                            uint64_t binLines,
+                            uint32_t binCount);
+
+    /**
+     * @brief Accounts reference of the cache line
+     *
+     * @param key Cache line key, key ~0 is reserved
+     */
+    void access(uint64_t key);
+
+    /**
+     * @return Miss ratio for cache sizes of binLines * (i + 1)
+     */
+    std::vector<MissRatioPoint> getCurve() const;
+
+    /**
+     * @return Number of all (sampled and not sampled) references
+     */
+    uint64_t getAccessCount() const;
+
+    /**
+     * @return Number of references which passed sampling filter
+     */
+    uint64_t getSampledAccessCount() const;
+
+    /**
+     * @return Current sampling rate
+     */
+    double getSamplingRate() const;
+
+    /**
+     * @return Number of bytes occupied by estimator's metadata
+     */
+    uint64_t getMemoryUsage() const;
+
+    static constexpr uint64_t SAMPLING_MODULUS = 1ULL << 24;
+
+private:
+    uint64_t samplingHash(uint64_t key) const {
+        return (hashMix64(key) >> 32) & (SAMPLING_MODULUS - 1);
+    }
+
+    void mark(uint32_t time, int32_t delta);
+
+    /**
+     * @return Number of marked timestamps lower or equal to time
+     */
+    int64_t prefix(uint32_t time) const;
+
+    void compact();
+
+    void dropSamples();
+
+    const uint32_t m_sampleLimit;
+    const uint64_t m_binLines;
+
+    /** Maps sampled line to the timestamp of its last reference */
+    CacheLineTable m_lastAccess;
+
+    /** Line referenced at given timestamp, ~0 if not latest reference */
+    std::vector<uint64_t> m_timeKeys;
+
+    /** Fenwick tree of latest references, 1-based */
+    std::vector<int32_t> m_tree;
+    uint32_t m_time;
+
+    /** Sampled lines ordered by hash, for dropping the highest ones */
+    std::priority_queue<std::pair<uint64_t, uint64_t>> m_samples;
+    uint64_t m_threshold;
+
+    /** Scaled reuse distance histogram, last bin counts cold misses */
+    std::vector<double> m_histogram;
+    uint64_t m_accessCount;
+    uint64_t m_sampledCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEESTIMATOR_H
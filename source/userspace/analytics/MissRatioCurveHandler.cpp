@@ -0,0 +1,105 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "MissRatioCurveHandler.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+/** Lines of different devices are told apart by device index in high bits */
+static constexpr uint64_t DEVICE_INDEX_SHIFT = 48;
+
+MissRatioCurveHandler::MissRatioCurveHandler(const std::string &tracePath,
+                                             uint64_t cacheLineSize,
+                                             uint32_t sampleLimit,
+                                             uint64_t binLines,
+                                             uint32_t binCount)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_lineSectors(cacheLineSize / SECTOR_SIZE)
+        , m_sampleLimit(sampleLimit)
+        , m_binLines(binLines)
+        , m_binCount(binCount)
+        , m_devices()
+        , m_deviceNames()
+        , m_ioClasses()
+        , m_deviceIndexes() {
+    if (!m_lineSectors || cacheLineSize % SECTOR_SIZE) {
+        throw Exception("Invalid cache line size");
+    }
+}
+
+void MissRatioCurveHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    const auto &pbIo = io.io();
+
+    if (pbIo.error() || !pbIo.len()) {
+        return;
+    }
+
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+    case proto::trace::IoType::Write:
+        break;
+    default:
+        // Discards do not reference data
+        return;
+    }
+
+    uint64_t deviceId = io.device().id();
+    auto &device = getEstimator(m_devices, deviceId);
+    auto &ioClass = getEstimator(m_ioClasses, pbIo.ioclass());
+
+    auto index = m_deviceIndexes.find(deviceId);
+    if (index == m_deviceIndexes.end()) {
+        index = m_deviceIndexes
+                        .insert(std::make_pair(deviceId,
+                                               m_deviceIndexes.size()))
+                        .first;
+        m_deviceNames[deviceId] = io.device().name();
+    }
+
+    // IO class may span many devices, so its lines include device index
+    uint64_t deviceKey = index->second << DEVICE_INDEX_SHIFT;
+    uint64_t first = pbIo.lba() / m_lineSectors;
+    uint64_t last = (pbIo.lba() + pbIo.len() - 1) / m_lineSectors;
+
+    for (uint64_t line = first; line <= last; line++) {
+        uint64_t key = line & ((1ULL << DEVICE_INDEX_SHIFT) - 1);
+
+        device.access(key);
+        ioClass.access(deviceKey | key);
+    }
+}
+
+const std::map<uint64_t, MissRatioCurveHandler::EstimatorPtr>
+        &MissRatioCurveHandler::getDeviceCurves() const {
+    return m_devices;
+}
+
+const std::map<uint64_t, std::string> &MissRatioCurveHandler::getDeviceNames()
+        const {
+    return m_deviceNames;
+}
+
+const std::map<uint64_t, MissRatioCurveHandler::EstimatorPtr>
+        &MissRatioCurveHandler::getIoClassCurves() const {
+    return m_ioClasses;
+}
+
+MissRatioCurveEstimator &MissRatioCurveHandler::getEstimator(
+        std::map<uint64_t, EstimatorPtr> &estimators,
+        uint64_t id) {
+    auto &estimator = estimators[id];
+
+    if (!estimator) {
+        estimator.reset(new MissRatioCurveEstimator(m_sampleLimit, m_binLines,
+                                                    m_binCount));
+    }
+
+    return *estimator;
+}
+
+}  // namespace octf
@@ -0,0 +1,76 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEHANDLER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "MissRatioCurveEstimator.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler estimating miss ratio curves in a single pass
+ *
+ * Separate curves are estimated for every device and for every IO class.
+ * Each curve has its own estimator, so memory is bounded by the sample limit
+ * times number of devices and IO classes.
+ */
+class MissRatioCurveHandler : public ParsedIoTraceEventHandler {
+public:
+    typedef std::unique_ptr<MissRatioCurveEstimator> EstimatorPtr;
+
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param cacheLineSize Cache line size in bytes
+     * @param sampleLimit Maximum number of lines tracked by single estimator
+     * @param binLines Distance between curve points in cache lines
+     * @param binCount Number of curve points
+     */
+    MissRatioCurveHandler(const std::string &tracePath,
+                          uint64_t cacheLineSize,
+                          uint32_t sampleLimit,
+                          uint64_t binLines,
+                          uint32_t binCount);
+    virtual ~MissRatioCurveHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @return Estimators by device id
+     */
+    const std::map<uint64_t, EstimatorPtr> &getDeviceCurves() const;
+
+    /**
+     * @return Device names by device id
+     */
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+    /**
+     * @return Estimators by IO class
+     */
+    const std::map<uint64_t, EstimatorPtr> &getIoClassCurves() const;
+
+private:
+    MissRatioCurveEstimator &getEstimator(
+            std::map<uint64_t, EstimatorPtr> &estimators,
+            uint64_t id);
+
+    const uint64_t m_lineSectors;
+    const uint32_t m_sampleLimit;
+    const uint64_t m_binLines;
+    const uint32_t m_binCount;
+    std::map<uint64_t, EstimatorPtr> m_devices;
+    std::map<uint64_t, std::string> m_deviceNames;
+    std::map<uint64_t, EstimatorPtr> m_ioClasses;
+    std::map<uint64_t, uint64_t> m_deviceIndexes;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_MISSRATIOCURVEHANDLER_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "RollingStatistics.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+RollingDeviceStatistics::RollingDeviceStatistics(uint32_t precision)
+        : count(static_cast<size_t>(LatencyOperation::Count), 0)
+        , bytes(static_cast<size_t>(LatencyOperation::Count), 0)
+        , latency(precision) {}
+
+void RollingDeviceStatistics::merge(const RollingDeviceStatistics &other) {
+    for (size_t i = 0; i < count.size(); i++) {
+        count[i] += other.count[i];
+        bytes[i] += other.bytes[i];
+    }
+    latency.merge(other.latency);
+}
+
+RollingStatistics::RollingStatistics(uint64_t window,
+                                     uint64_t bucketSize,
+                                     uint32_t precision)
+        : m_bucketSize(bucketSize)
+        , m_bucketCount(bucketSize ? (window + bucketSize - 1) / bucketSize
+                                   : 0)
+        , m_precision(precision)
+        , m_buckets() {
+    if (!m_bucketSize || !m_bucketCount) {
+        throw Exception("Invalid rolling statistics window");
+    }
+}
+
+void RollingStatistics::record(uint64_t deviceId,
+                               uint64_t timestamp,
+                               LatencyOperation operation,
+                               uint64_t bytes,
+                               uint64_t latency) {
+    uint64_t index = timestamp / m_bucketSize;
+    if (!m_buckets.empty() && index + m_bucketCount <= m_buckets.back().index) {
+        // Already out of the window
+        return;
+    }
+
+    auto &devices = getBucket(index).devices;
+    auto device = devices.find(deviceId);
+    if (device == devices.end()) {
+        device = devices.insert(std::make_pair(
+                                        deviceId,
+                                        RollingDeviceStatistics(m_precision)))
+                         .first;
+    }
+
+    auto &statistics = device->second;
+    statistics.count[static_cast<size_t>(operation)]++;
+    statistics.bytes[static_cast<size_t>(operation)] += bytes;
+    statistics.latency.record(latency);
+}
+
+std::map<uint64_t, RollingDeviceStatistics> RollingStatistics::getStatistics()
+        const {
+    std::map<uint64_t, RollingDeviceStatistics> result;
+
+    for (const auto &bucket : m_buckets) {
+        for (const auto &device : bucket.devices) {
+            auto iter = result.find(device.first);
+            if (iter == result.end()) {
+                result.insert(device);
+            } else {
+                iter->second.merge(device.second);
+            }
+        }
+    }
+
+    return result;
+}
+
+uint64_t RollingStatistics::getWindowStart() const {
+    uint64_t end = getWindowEnd();
+    uint64_t window = m_bucketCount * m_bucketSize;
+    return end > window ? end - window : 0;
+}
+
+uint64_t RollingStatistics::getWindowEnd() const {
+    if (m_buckets.empty()) {
+        return 0;
+    }
+    return (m_buckets.back().index + 1) * m_bucketSize;
+}
+
+RollingStatistics::Bucket &RollingStatistics::getBucket(uint64_t index) {
+    if (m_buckets.empty() || index > m_buckets.back().index) {
+        m_buckets.push_back(Bucket{index, {}});
+
+        // Drop buckets which fell out of the window
+        while (m_buckets.front().index + m_bucketCount <= index) {
+            m_buckets.pop_front();
+        }
+        return m_buckets.back();
+    }
+
+    // IO older than the latest one, buckets are sorted by index
+    for (auto iter = m_buckets.rbegin(); iter != m_buckets.rend(); iter++) {
+        if (iter->index == index) {
+            return *iter;
+        } else if (iter->index < index) {
+            return *m_buckets.insert(iter.base(), Bucket{index, {}});
+        }
+    }
+    return *m_buckets.insert(m_buckets.begin(), Bucket{index, {}});
+}
+
+}  // namespace octf
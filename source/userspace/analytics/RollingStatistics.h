@@ -0,0 +1,88 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_ROLLINGSTATISTICS_H
+#define SOURCE_USERSPACE_ANALYTICS_ROLLINGSTATISTICS_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+#include "LatencyHistogram.h"
+#include "LatencyStatisticsHandler.h"
+
+namespace octf {
+
+/**
+ * @brief IO statistics of a single device
+ */
+struct RollingDeviceStatistics {
+    explicit RollingDeviceStatistics(uint32_t precision);
+
+    void merge(const RollingDeviceStatistics &other);
+
+    /** Number of IOs indexed by LatencyOperation */
+    std::vector<uint64_t> count;
+
+    /** Number of bytes indexed by LatencyOperation */
+    std::vector<uint64_t> bytes;
+
+    LatencyHistogram latency;
+};
+
+/**
+ * @brief Per device IO statistics over a sliding time window
+ *
+ * IOs are accounted in fixed time buckets, buckets which fall out of the
+ * window are dropped, so memory is bounded by the window length and not by
+ * the length of the trace. The window ends at the latest IO seen.
+ */
+class RollingStatistics {
+public:
+    /**
+     * @param window Length of the window in ns
+     * @param bucketSize Length of a single bucket in ns
+     * @param precision Precision of latency histograms
+     */
+    RollingStatistics(uint64_t window, uint64_t bucketSize, uint32_t precision);
+
+    void record(uint64_t deviceId,
+                uint64_t timestamp,
+                LatencyOperation operation,
+                uint64_t bytes,
+                uint64_t latency);
+
+    /**
+     * @return Statistics aggregated over the window, by device id
+     */
+    std::map<uint64_t, RollingDeviceStatistics> getStatistics() const;
+
+    /**
+     * @return Start of the window in ns
+     */
+    uint64_t getWindowStart() const;
+
+    /**
+     * @return End of the window in ns
+     */
+    uint64_t getWindowEnd() const;
+
+private:
+    struct Bucket {
+        uint64_t index;
+        std::map<uint64_t, RollingDeviceStatistics> devices;
+    };
+
+    Bucket &getBucket(uint64_t index);
+
+    const uint64_t m_bucketSize;
+    const uint64_t m_bucketCount;
+    const uint32_t m_precision;
+    std::deque<Bucket> m_buckets;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_ROLLINGSTATISTICS_H
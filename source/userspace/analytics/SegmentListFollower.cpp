@@ -0,0 +1,41 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "SegmentListFollower.h"
+#include <fstream>
+#include <iterator>
+
+namespace octf {
+
+SegmentListFollower::SegmentListFollower(const std::string &path)
+        : m_path(path)
+        , m_offset(0) {}
+
+std::vector<std::string> SegmentListFollower::poll() {
+    std::vector<std::string> segments;
+
+    std::ifstream file(m_path, std::ios_base::in | std::ios_base::binary);
+    if (!file.good()) {
+        return segments;
+    }
+
+    file.seekg(m_offset);
+    std::string text((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+
+    size_t begin = 0;
+    size_t end;
+    while ((end = text.find('\n', begin)) != std::string::npos) {
+        if (end > begin) {
+            segments.push_back(text.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    m_offset += begin;
+
+    return segments;
+}
+
+}  // namespace octf
@@ -0,0 +1,43 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_SEGMENTLISTFOLLOWER_H
+#define SOURCE_USERSPACE_ANALYTICS_SEGMENTLISTFOLLOWER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Follows list of sealed trace segments appended during capture
+ *
+ * The list is a text file with one trace path per line. Only complete
+ * lines are returned, a line being written is read by the next poll.
+ */
+class SegmentListFollower {
+public:
+    /**
+     * @param path Path of the segment list file, it does not need to exist
+     * yet
+     */
+    explicit SegmentListFollower(const std::string &path);
+
+    /**
+     * @brief Reads trace paths appended since the previous poll
+     *
+     * @return Paths of newly sealed segments in order of capture
+     */
+    std::vector<std::string> poll();
+
+private:
+    const std::string m_path;
+    uint64_t m_offset;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_SEGMENTLISTFOLLOWER_H
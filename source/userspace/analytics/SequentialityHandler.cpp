@@ -0,0 +1,126 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "SequentialityHandler.h"
+
+namespace octf {
+
+constexpr uint32_t SequentialityHandler::FILE_TABLE_SIZE;
+
+SequentialityHandler::SequentialityHandler(const std::string &tracePath,
+                                           uint32_t tableSize,
+                                           uint64_t idleTimeout,
+                                           uint32_t fileCount)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_tableSize(tableSize)
+        , m_idleTimeout(idleTimeout)
+        , m_fileCount(fileCount)
+        , m_devices()
+        , m_deviceNames()
+        , m_files()
+        , m_order() {}
+
+void SequentialityHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    const auto &pbIo = io.io();
+    StreamDetector::Operation operation;
+
+    if (pbIo.error() || !pbIo.len()) {
+        return;
+    }
+
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+        operation = StreamDetector::Read;
+        break;
+    case proto::trace::IoType::Write:
+        operation = StreamDetector::Write;
+        break;
+    default:
+        return;
+    }
+
+    uint64_t timestamp = io.header().timestamp();
+    uint64_t deviceId = io.device().id();
+
+    auto &device = m_devices[deviceId];
+    if (!device) {
+        device.reset(new StreamDetector(m_tableSize, m_idleTimeout));
+        m_deviceNames[deviceId] = io.device().name();
+    }
+    device->account(timestamp, pbIo.lba(), pbIo.len(), operation);
+
+    if (io.file().id() && m_fileCount) {
+        FileSequentiality &file = getFile(io);
+        file.detector->account(timestamp, io.file().offset(), pbIo.len(),
+                               operation);
+    }
+}
+
+void SequentialityHandler::finish() {
+    for (auto &device : m_devices) {
+        device.second->finish();
+    }
+    for (auto &file : m_files) {
+        file.second.detector->finish();
+    }
+}
+
+const std::map<uint64_t, std::unique_ptr<StreamDetector>>
+        &SequentialityHandler::getDevices() const {
+    return m_devices;
+}
+
+const std::map<uint64_t, std::string> &SequentialityHandler::getDeviceNames()
+        const {
+    return m_deviceNames;
+}
+
+std::vector<SequentialityHandler::FileSequentiality>
+SequentialityHandler::getFiles() const {
+    std::vector<FileSequentiality> files;
+
+    for (auto iter = m_order.rbegin(); iter != m_order.rend(); ++iter) {
+        files.push_back(m_files.at(iter->second));
+    }
+
+    return files;
+}
+
+SequentialityHandler::FileSequentiality &SequentialityHandler::getFile(
+        const proto::trace::ParsedEvent &io) {
+    FileKey key(io.device().id(), io.file().id());
+    uint64_t rank = 0;
+
+    auto iter = m_files.find(key);
+    if (iter == m_files.end()) {
+        if (m_files.size() >= m_fileCount) {
+            // Replace the least accessed file, inheriting its rank
+            auto victim = m_order.begin();
+            rank = victim->first;
+            m_files.erase(victim->second);
+            m_order.erase(victim);
+        }
+
+        FileSequentiality file;
+        file.key = key;
+        file.rank = rank;
+        file.detector = std::make_shared<StreamDetector>(FILE_TABLE_SIZE,
+                                                         m_idleTimeout);
+        iter = m_files.emplace(key, file).first;
+    } else {
+        m_order.erase(std::make_pair(iter->second.rank, key));
+    }
+
+    FileSequentiality &file = iter->second;
+    file.rank++;
+    if (file.path.empty()) {
+        file.path = io.file().path();
+    }
+    m_order.emplace(file.rank, key);
+
+    return file;
+}
+
+}  // namespace octf
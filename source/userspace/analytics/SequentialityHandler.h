@@ -0,0 +1,92 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_SEQUENTIALITYHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_SEQUENTIALITYHANDLER_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "StreamDetector.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler detecting sequential streams per device and file
+ *
+ * Devices are detected by LBA, files by file offset. Memory is bounded:
+ * only a fixed number of the most accessed files is tracked, selected with
+ * the space-saving algorithm. File which replaces the least accessed one
+ * inherits its access count as rank, so that a file becoming hot late is
+ * not evicted right away; its statistics start from scratch.
+ */
+class SequentialityHandler : public ParsedIoTraceEventHandler {
+public:
+    /** Device id and file id */
+    typedef std::pair<uint64_t, uint64_t> FileKey;
+
+    struct FileSequentiality {
+        FileKey key;
+        std::string path;
+
+        /** Space-saving estimate of the number of IOs to the file */
+        uint64_t rank;
+
+        std::shared_ptr<StreamDetector> detector;
+    };
+
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param tableSize Maximum number of streams tracked per device
+     * @param idleTimeout Time after which idle stream is closed, in ns
+     * @param fileCount Maximum number of tracked files
+     */
+    SequentialityHandler(const std::string &tracePath,
+                         uint32_t tableSize,
+                         uint64_t idleTimeout,
+                         uint32_t fileCount);
+    virtual ~SequentialityHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @brief Closes all streams, call after processing
+     */
+    void finish();
+
+    const std::map<uint64_t, std::unique_ptr<StreamDetector>> &getDevices()
+            const;
+
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+    /**
+     * @return Tracked files in descending order of rank
+     */
+    std::vector<FileSequentiality> getFiles() const;
+
+private:
+    /** Files see fewer concurrent streams than devices */
+    static constexpr uint32_t FILE_TABLE_SIZE = 4;
+
+    FileSequentiality &getFile(const proto::trace::ParsedEvent &io);
+
+    const uint32_t m_tableSize;
+    const uint64_t m_idleTimeout;
+    const uint32_t m_fileCount;
+    std::map<uint64_t, std::unique_ptr<StreamDetector>> m_devices;
+    std::map<uint64_t, std::string> m_deviceNames;
+    std::map<FileKey, FileSequentiality> m_files;
+
+    /** Tracked files ordered by (rank, key) */
+    std::set<std::pair<uint64_t, FileKey>> m_order;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_SEQUENTIALITYHANDLER_H
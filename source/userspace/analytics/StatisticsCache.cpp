@@ -0,0 +1,204 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "StatisticsCache.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+#include <octf/utils/Log.h>
+
+namespace octf {
+
+constexpr uint32_t StatisticsCache::VERSION;
+
+static constexpr auto CACHE_FILE_NAME = "iotrace-statistics.cache";
+
+StatisticsCache::StatisticsCache(const std::string &tracePath)
+        : m_traceDir(getFrameworkConfiguration().getTraceRepositoryPath() +
+                     "/" + tracePath)
+        , m_cachePath(m_traceDir + "/" + CACHE_FILE_NAME)
+        , m_data() {
+    load();
+}
+
+bool StatisticsCache::getLatency(uint32_t precision,
+                                 DeviceHistograms &histograms,
+                                 std::map<uint64_t, std::string> &names) const {
+    for (const auto &latency : m_data.latency()) {
+        if (latency.precision() != precision) {
+            continue;
+        }
+
+        histograms.clear();
+        names.clear();
+
+        for (const auto &device : latency.device()) {
+            std::vector<LatencyHistogram> operations;
+
+            for (const auto &data : device.operation()) {
+                std::vector<uint64_t> counts(data.counts().begin(),
+                                             data.counts().end());
+
+                operations.emplace_back(precision);
+                try {
+                    operations.back().restore(counts, data.min(), data.max(),
+                                              data.sum());
+                } catch (Exception &e) {
+                    log::verbose << "Ignoring invalid statistics cache "
+                                 << m_cachePath << std::endl;
+                    return false;
+                }
+            }
+
+            histograms.insert(std::make_pair(device.id(), operations));
+            names[device.id()] = device.name();
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void StatisticsCache::putLatency(
+        uint32_t precision,
+        const DeviceHistograms &histograms,
+        const std::map<uint64_t, std::string> &names) {
+    proto::LatencyAggregates *latency = nullptr;
+    for (auto &entry : *m_data.mutable_latency()) {
+        if (entry.precision() == precision) {
+            latency = &entry;
+            break;
+        }
+    }
+
+    if (latency) {
+        latency->Clear();
+    } else {
+        latency = m_data.add_latency();
+    }
+    latency->set_precision(precision);
+
+    for (const auto &device : histograms) {
+        auto pbDevice = latency->add_device();
+        pbDevice->set_id(device.first);
+        pbDevice->set_name(names.at(device.first));
+
+        for (const auto &histogram : device.second) {
+            auto data = pbDevice->add_operation();
+            const auto &counts = histogram.getCounts();
+
+            data->set_min(histogram.getMin());
+            data->set_max(histogram.getMax());
+            data->set_sum(histogram.getSum());
+            data->mutable_counts()->Reserve(counts.size());
+            for (auto count : counts) {
+                data->add_counts(count);
+            }
+        }
+    }
+
+    store();
+}
+
+void StatisticsCache::load() {
+    std::ifstream file(m_cachePath, std::ios_base::in | std::ios_base::binary);
+    if (!file.good()) {
+        return;
+    }
+
+    proto::StatisticsCacheData data;
+    if (!data.ParseFromIstream(&file) || data.version() != VERSION) {
+        log::verbose << "Ignoring invalid statistics cache " << m_cachePath
+                     << std::endl;
+        return;
+    }
+
+    uint64_t size;
+    int64_t modified;
+    if (!getFingerprint(size, modified) || data.tracesize() != size ||
+        data.tracemodified() != modified) {
+        log::verbose << "Ignoring outdated statistics cache " << m_cachePath
+                     << std::endl;
+        return;
+    }
+
+    m_data.Swap(&data);
+}
+
+void StatisticsCache::store() {
+    uint64_t size;
+    int64_t modified;
+    if (!getFingerprint(size, modified)) {
+        log::verbose << "Cannot access trace directory " << m_traceDir
+                     << std::endl;
+        return;
+    }
+
+    m_data.set_version(VERSION);
+    m_data.set_tracesize(size);
+    m_data.set_tracemodified(modified);
+
+    // Write to temporary file and rename, readers never see partial cache
+    std::string tmpPath = m_cachePath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios_base::out |
+                                            std::ios_base::binary |
+                                            std::ios_base::trunc);
+        if (file.good() && m_data.SerializeToOstream(&file)) {
+            file.close();
+        } else {
+            file.close();
+            std::remove(tmpPath.c_str());
+            log::verbose << "Cannot store statistics cache " << m_cachePath
+                         << std::endl;
+            return;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), m_cachePath.c_str())) {
+        std::remove(tmpPath.c_str());
+        log::verbose << "Cannot store statistics cache " << m_cachePath
+                     << std::endl;
+    }
+}
+
+bool StatisticsCache::getFingerprint(uint64_t &size, int64_t &modified) const {
+    size = 0;
+    modified = 0;
+
+    DIR *dir = opendir(m_traceDir.c_str());
+    if (!dir) {
+        return false;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        std::string name = entry->d_name;
+        if (name.compare(0, std::string(CACHE_FILE_NAME).size(),
+                         CACHE_FILE_NAME) == 0) {
+            // Cache and its temporary file
+            continue;
+        }
+
+        struct stat info;
+        std::string path = m_traceDir + "/" + name;
+        if (stat(path.c_str(), &info) || !S_ISREG(info.st_mode)) {
+            continue;
+        }
+
+        size += info.st_size;
+        modified = std::max<int64_t>(modified, info.st_mtime);
+    }
+
+    closedir(dir);
+    return true;
+}
+
+}  // namespace octf
@@ -0,0 +1,79 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_STATISTICSCACHE_H
+#define SOURCE_USERSPACE_ANALYTICS_STATISTICSCACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "InterfaceTraceAnalytics.pb.h"
+#include "LatencyHistogram.h"
+
+namespace octf {
+
+/**
+ * @brief Aggregates of a trace persisted in the trace directory
+ *
+ * The first analysis of a trace stores its aggregates, later analyses
+ * are answered without parsing the trace again. Cached statistics are
+ * bound to the size and modification time of trace files, they are
+ * dropped when the trace changes. Each trace segment has its own cache,
+ * so statistics of a growing list of segments are computed incrementally.
+ */
+class StatisticsCache {
+public:
+    typedef std::map<uint64_t, std::vector<LatencyHistogram>> DeviceHistograms;
+
+    /**
+     * @param tracePath Path of the trace in trace repository
+     */
+    explicit StatisticsCache(const std::string &tracePath);
+
+    /**
+     * @param precision Precision of requested histograms
+     * @param[out] histograms Latency histograms indexed by LatencyOperation,
+     * by device id
+     * @param[out] names Device names by device id
+     *
+     * @retval true Histograms found in cache
+     * @retval false Histograms not cached
+     */
+    bool getLatency(uint32_t precision,
+                    DeviceHistograms &histograms,
+                    std::map<uint64_t, std::string> &names) const;
+
+    /**
+     * @brief Stores latency histograms, failure to persist them is not
+     * an error
+     */
+    void putLatency(uint32_t precision,
+                    const DeviceHistograms &histograms,
+                    const std::map<uint64_t, std::string> &names);
+
+    static constexpr uint32_t VERSION = 1;
+
+private:
+    void load();
+
+    void store();
+
+    /**
+     * @brief Computes total size and the latest modification time of trace
+     * files
+     *
+     * @retval false Trace directory not accessible
+     */
+    bool getFingerprint(uint64_t &size, int64_t &modified) const;
+
+    const std::string m_traceDir;
+    const std::string m_cachePath;
+    proto::StatisticsCacheData m_data;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_STATISTICSCACHE_H
@@ -0,0 +1,137 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "StreamDetector.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+constexpr uint32_t StreamStatistics::RUN_LENGTH_BUCKETS;
+
+StreamStatistics::StreamStatistics()
+        : ios(0)
+        , sequentialIos(0)
+        , sectors(0)
+        , sequentialSectors(0)
+        , streams(0)
+        , runLengths() {}
+
+StreamDetector::StreamDetector(uint32_t tableSize, uint64_t idleTimeout)
+        : m_idleTimeout(idleTimeout)
+        , m_streams(tableSize)
+        , m_statistics()
+        , m_activeStreams(0)
+        , m_peakStreams(0) {
+    if (!tableSize) {
+        throw Exception("Stream table cannot be empty");
+    }
+
+    for (auto &stream : m_streams) {
+        stream.open = false;
+    }
+}
+
+bool StreamDetector::account(uint64_t timestamp,
+                             uint64_t position,
+                             uint32_t len,
+                             Operation operation) {
+    Stream *match = nullptr;
+    Stream *victim = &m_streams.front();
+
+    // The table is small, search it linearly closing idle streams on the way
+    for (auto &stream : m_streams) {
+        if (stream.open && timestamp > stream.lastTime + m_idleTimeout) {
+            close(stream);
+        }
+
+        if (!stream.open) {
+            if (victim->open) {
+                victim = &stream;
+            }
+            continue;
+        }
+
+        if (!match && stream.next == position &&
+            stream.operation == operation) {
+            match = &stream;
+        }
+        if (victim->open && stream.lastTime < victim->lastTime) {
+            victim = &stream;
+        }
+    }
+
+    StreamStatistics &statistics = m_statistics[operation];
+    statistics.ios++;
+    statistics.sectors += len;
+
+    if (match) {
+        statistics.sequentialIos++;
+        statistics.sequentialSectors += len;
+
+        match->ios++;
+        match->next = position + len;
+        if (timestamp > match->lastTime) {
+            match->lastTime = timestamp;
+        }
+
+        if (match->ios == 2) {
+            statistics.streams++;
+            m_activeStreams++;
+            if (m_activeStreams > m_peakStreams) {
+                m_peakStreams = m_activeStreams;
+            }
+        }
+
+        return true;
+    }
+
+    if (victim->open) {
+        close(*victim);
+    }
+
+    victim->next = position + len;
+    victim->lastTime = timestamp;
+    victim->ios = 1;
+    victim->operation = operation;
+    victim->open = true;
+
+    return false;
+}
+
+void StreamDetector::finish() {
+    for (auto &stream : m_streams) {
+        if (stream.open) {
+            close(stream);
+        }
+    }
+}
+
+const StreamStatistics &StreamDetector::getStatistics(
+        Operation operation) const {
+    return m_statistics[operation];
+}
+
+uint32_t StreamDetector::getPeakStreams() const {
+    return m_peakStreams;
+}
+
+uint64_t StreamDetector::getRunLengthBucketStart(uint32_t bucket) {
+    return 1ULL << bucket;
+}
+
+void StreamDetector::close(Stream &stream) {
+    uint32_t bucket = 63 - __builtin_clzll(stream.ios);
+    if (bucket >= StreamStatistics::RUN_LENGTH_BUCKETS) {
+        bucket = StreamStatistics::RUN_LENGTH_BUCKETS - 1;
+    }
+    m_statistics[stream.operation].runLengths[bucket]++;
+
+    if (stream.ios >= 2) {
+        m_activeStreams--;
+    }
+    stream.open = false;
+}
+
+}  // namespace octf
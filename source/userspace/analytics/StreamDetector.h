@@ -0,0 +1,104 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_STREAMDETECTOR_H
+#define SOURCE_USERSPACE_ANALYTICS_STREAMDETECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Sequentiality statistics of one operation
+ */
+struct StreamStatistics {
+    /** Runs are bucketed by log2 of their number of IOs */
+    static constexpr uint32_t RUN_LENGTH_BUCKETS = 32;
+
+    uint64_t ios;
+    uint64_t sequentialIos;
+    uint64_t sectors;
+    uint64_t sequentialSectors;
+
+    /** Runs of at least two sequential IOs */
+    uint64_t streams;
+
+    /** Number of runs by bucket, random IO is a run of length 1 */
+    uint64_t runLengths[RUN_LENGTH_BUCKETS];
+
+    StreamStatistics();
+};
+
+/**
+ * @brief Detects sequential streams of IO in constant memory
+ *
+ * Recent streams are kept in a small table, each with the position where
+ * its next IO is expected. IO continuing a stream of the same operation is
+ * sequential, any other IO starts a new stream, replacing the least
+ * recently used one. Streams idle for longer than the timeout are closed,
+ * so that the number of concurrent streams is not overestimated.
+ *
+ * Positions are in sectors and may be LBAs as well as file offsets.
+ */
+class StreamDetector {
+public:
+    enum Operation { Read = 0, Write = 1, OperationCount = 2 };
+
+    /**
+     * @param tableSize Maximum number of tracked streams
+     * @param idleTimeout Time after which idle stream is closed, in ns
+     */
+    StreamDetector(uint32_t tableSize, uint64_t idleTimeout);
+    virtual ~StreamDetector() = default;
+
+    /**
+     * @retval true IO continues a stream
+     */
+    bool account(uint64_t timestamp,
+                 uint64_t position,
+                 uint32_t len,
+                 Operation operation);
+
+    /**
+     * @brief Closes all streams, call after processing
+     */
+    void finish();
+
+    const StreamStatistics &getStatistics(Operation operation) const;
+
+    /**
+     * @return Maximum number of streams open at the same time
+     */
+    uint32_t getPeakStreams() const;
+
+    /**
+     * @return Lower bound of the number of IOs in bucket of run lengths
+     */
+    static uint64_t getRunLengthBucketStart(uint32_t bucket);
+
+private:
+    struct Stream {
+        uint64_t next;
+        uint64_t lastTime;
+        uint64_t ios;
+        Operation operation;
+        bool open;
+    };
+
+    void close(Stream &stream);
+
+    const uint64_t m_idleTimeout;
+    std::vector<Stream> m_streams;
+    StreamStatistics m_statistics[OperationCount];
+
+    /** Open streams with at least two IOs */
+    uint32_t m_activeStreams;
+    uint32_t m_peakStreams;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_STREAMDETECTOR_H
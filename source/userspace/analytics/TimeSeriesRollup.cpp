@@ -0,0 +1,470 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TimeSeriesRollup.h"
+#include <algorithm>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/util/delimited_message_util.h>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+#include <octf/utils/Log.h>
+
+namespace octf {
+
+constexpr uint32_t TimeSeriesRollup::VERSION;
+constexpr size_t TimeSeriesRecorder::BATCH_SIZE;
+
+static constexpr auto TIME_SERIES_FILE_NAME = "octf.timeseries";
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+static constexpr uint32_t ROLLUP_PRECISION = 2;
+
+/** Shortest period of the recorder flush timer, in ns */
+static constexpr uint64_t MIN_FLUSH_PERIOD = 10ULL * 1000000ULL;
+
+static constexpr uint32_t MAX_IN_FLIGHT = 1 << 20;
+
+static constexpr uint64_t IN_FLIGHT_TIMEOUT = 30ULL * 1000000000ULL;
+
+static constexpr size_t MAX_EARLY_COMPLETIONS = 65536;
+
+TimeSeriesRollup::TimeSeriesRollup(const std::string &filePath,
+                                   uint64_t interval)
+        : m_interval(interval)
+        , m_mutex()
+        , m_file()
+        , m_matcher(MAX_IN_FLIGHT, IN_FLIGHT_TIMEOUT)
+        , m_early()
+        , m_earlyOrder()
+        , m_open()
+        , m_nextIndex(0)
+        , m_sampleCount(0)
+        , m_lateCount(0)
+        , m_orphanCount(0)
+        , m_closed(false)
+        , m_queues()
+        , m_recordersMutex()
+        , m_recorders()
+        , m_flushPeriod(std::max(interval / 2, MIN_FLUSH_PERIOD))
+        , m_timerMutex()
+        , m_timerCv()
+        , m_timerStopped(false)
+        , m_timer() {
+    if (!interval) {
+        throw Exception("Invalid time series interval");
+    }
+
+    m_file.open(filePath, std::ios_base::out | std::ios_base::binary |
+                                  std::ios_base::trunc);
+    if (!m_file.good()) {
+        throw Exception("Cannot create time series file " + filePath);
+    }
+
+    proto::TimeSeriesRecord record;
+    record.mutable_header()->set_version(VERSION);
+    record.mutable_header()->set_interval(interval);
+    writeRecord(record);
+
+    m_timer = std::thread(&TimeSeriesRollup::tick, this);
+}
+
+TimeSeriesRollup::~TimeSeriesRollup() {
+    stopTimer();
+}
+
+void TimeSeriesRollup::addDevice(uint64_t id, const std::string &name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed) {
+        return;
+    }
+
+    proto::TimeSeriesRecord record;
+    record.mutable_device()->set_id(id);
+    record.mutable_device()->set_name(name);
+    writeRecord(record);
+}
+
+void TimeSeriesRollup::addRecorder(TimeSeriesRecorder &recorder) {
+    {
+        std::lock_guard<std::mutex> lock(m_recordersMutex);
+        m_recorders.push_back(&recorder);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Holds intervals open until it records, or a timer tick finds it idle
+    Queue queue = {0, false, false};
+    m_queues[&recorder] = queue;
+}
+
+void TimeSeriesRollup::removeRecorder(TimeSeriesRecorder &recorder) {
+    {
+        std::lock_guard<std::mutex> lock(m_recordersMutex);
+        m_recorders.erase(
+                std::remove(m_recorders.begin(), m_recorders.end(), &recorder),
+                m_recorders.end());
+    }
+
+    recorder.flush();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queues.erase(&recorder);
+    if (!m_closed) {
+        closeIntervals();
+    }
+}
+
+void TimeSeriesRollup::record(const TimeSeriesRecorder &recorder,
+                              const std::vector<RollupEvent> &events) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed) {
+        m_lateCount += events.size();
+        return;
+    }
+
+    auto &queue = m_queues[&recorder];
+    queue.recorded = true;
+    queue.idle = false;
+
+    for (const auto &event : events) {
+        queue.watermark = std::max(queue.watermark, event.timestamp);
+
+        if (event.completion) {
+            InFlightIo io;
+            EarlyCompletion completion = {event.timestamp, event.deviceId,
+                                          event.error};
+
+            if (m_matcher.complete(event.id, event.deviceId, event.timestamp,
+                                   io)) {
+                complete(io, completion);
+            } else if (m_early.insert(std::make_pair(event.id, completion))
+                               .second) {
+                m_earlyOrder.push_back(event.id);
+                if (m_earlyOrder.size() > MAX_EARLY_COMPLETIONS) {
+                    m_orphanCount += m_early.erase(m_earlyOrder.front());
+                    m_earlyOrder.pop_front();
+                }
+            }
+            continue;
+        }
+
+        InFlightIo io = {};
+        io.id = event.id;
+        io.timestamp = event.timestamp;
+        io.deviceId = event.deviceId;
+        io.len = event.len;
+        io.operation = static_cast<uint32_t>(event.operation);
+
+        auto early = m_early.find(event.id);
+        if (early != m_early.end()) {
+            complete(io, early->second);
+            m_early.erase(early);
+        } else {
+            m_matcher.queue(io);
+        }
+    }
+
+    closeIntervals();
+}
+
+void TimeSeriesRollup::complete(const InFlightIo &io,
+                                const EarlyCompletion &completion) {
+    if (completion.error) {
+        return;
+    }
+
+    uint64_t index = completion.timestamp / m_interval;
+    if (index < m_nextIndex) {
+        m_lateCount++;
+        return;
+    }
+
+    auto &devices = m_open[index];
+    auto device = devices.find(io.deviceId);
+    if (device == devices.end()) {
+        device = devices.insert(std::make_pair(io.deviceId,
+                                               RollingDeviceStatistics(
+                                                       ROLLUP_PRECISION)))
+                         .first;
+    }
+
+    auto &statistics = device->second;
+    statistics.count[io.operation]++;
+    statistics.bytes[io.operation] += io.len * SECTOR_SIZE;
+    statistics.latency.record(completion.timestamp > io.timestamp
+                                      ? completion.timestamp - io.timestamp
+                                      : 0);
+}
+
+void TimeSeriesRollup::closeIntervals() {
+    uint64_t watermark = UINT64_MAX;
+    uint64_t latest = 0;
+
+    for (const auto &queue : m_queues) {
+        latest = std::max(latest, queue.second.watermark);
+        if (!queue.second.idle) {
+            watermark = std::min(watermark, queue.second.watermark);
+        }
+    }
+
+    if (watermark == UINT64_MAX) {
+        // All queues are idle, keep the interval of the latest event open
+        watermark = latest;
+    }
+
+    uint64_t end = watermark / m_interval;
+    if (end > m_nextIndex) {
+        writeIntervals(end);
+    }
+}
+
+void TimeSeriesRollup::writeIntervals(uint64_t end) {
+    static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+
+    while (!m_open.empty() && m_open.begin()->first < end) {
+        const auto &interval = *m_open.begin();
+
+        for (const auto &device : interval.second) {
+            const auto &statistics = device.second;
+            proto::TimeSeriesRecord record;
+            auto sample = record.mutable_sample();
+
+            sample->set_start(interval.first * m_interval);
+            sample->set_deviceid(device.first);
+
+            for (size_t i = 0; i < statistics.count.size(); i++) {
+                if (!statistics.count[i]) {
+                    continue;
+                }
+
+                auto operation = sample->add_operation();
+                operation->set_operation(getLatencyOperationName(
+                        static_cast<LatencyOperation>(i)));
+                operation->set_count(statistics.count[i]);
+                operation->set_bytes(statistics.bytes[i]);
+            }
+
+            for (auto percentile : PERCENTILES) {
+                auto pbPercentile = sample->add_percentile();
+                pbPercentile->set_percentile(percentile);
+                pbPercentile->set_latency(
+                        statistics.latency.getValueAtPercentile(percentile));
+            }
+            sample->set_maxlatency(statistics.latency.getMax());
+            sample->set_meanlatency(statistics.latency.getMean());
+
+            writeRecord(record);
+            m_sampleCount++;
+        }
+
+        m_open.erase(m_open.begin());
+    }
+
+    m_nextIndex = std::max(m_nextIndex, end);
+    m_file.flush();
+}
+
+void TimeSeriesRollup::tick() {
+    std::unique_lock<std::mutex> lock(m_timerMutex);
+
+    while (!m_timerStopped) {
+        m_timerCv.wait_for(lock, m_flushPeriod,
+                           [this]() { return m_timerStopped; });
+        if (m_timerStopped) {
+            break;
+        }
+
+        lock.unlock();
+        flushRecorders();
+        lock.lock();
+    }
+}
+
+void TimeSeriesRollup::flushRecorders() {
+    {
+        std::lock_guard<std::mutex> lock(m_recordersMutex);
+        for (auto recorder : m_recorders) {
+            recorder->flush();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed) {
+        return;
+    }
+
+    // Queues which have not recorded anything since the previous tick have
+    // nothing buffered either, they no longer hold intervals open
+    for (auto &queue : m_queues) {
+        if (!queue.second.recorded) {
+            queue.second.idle = true;
+        }
+        queue.second.recorded = false;
+    }
+
+    closeIntervals();
+}
+
+void TimeSeriesRollup::stopTimer() {
+    {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        m_timerStopped = true;
+    }
+    m_timerCv.notify_all();
+
+    if (m_timer.joinable()) {
+        m_timer.join();
+    }
+}
+
+void TimeSeriesRollup::close() {
+    stopTimer();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed) {
+        return;
+    }
+
+    if (!m_open.empty()) {
+        writeIntervals(m_open.rbegin()->first + 1);
+    }
+
+    proto::TimeSeriesRecord record;
+    auto footer = record.mutable_footer();
+    footer->set_samples(m_sampleCount);
+    footer->set_latecompletions(m_lateCount);
+    footer->set_orphancompletions(m_orphanCount + m_early.size());
+    writeRecord(record);
+
+    m_file.close();
+    m_closed = true;
+}
+
+void TimeSeriesRollup::writeRecord(const proto::TimeSeriesRecord &record) {
+    if (!google::protobuf::util::SerializeDelimitedToOstream(record,
+                                                             &m_file)) {
+        // Capture goes on, only the time series is incomplete
+        log::cerr << "Cannot write time series record" << std::endl;
+    }
+}
+
+uint64_t TimeSeriesRollup::getInterval() const {
+    return m_interval;
+}
+
+uint64_t TimeSeriesRollup::getSampleCount() const {
+    return m_sampleCount;
+}
+
+uint64_t TimeSeriesRollup::getLateCount() const {
+    return m_lateCount;
+}
+
+std::string TimeSeriesRollup::getFilePath(const std::string &tracePath) {
+    return getFrameworkConfiguration().getTraceRepositoryPath() + "/" +
+           tracePath + "/" + TIME_SERIES_FILE_NAME;
+}
+
+void TimeSeriesRollup::read(const std::string &tracePath,
+                            uint64_t deviceId,
+                            proto::TimeSeries &series) {
+    std::string path = getFilePath(tracePath);
+    std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file.good()) {
+        throw Exception("Cannot open time series file " + path);
+    }
+
+    google::protobuf::io::IstreamInputStream input(&file);
+    std::map<uint64_t, proto::DeviceTimeSeries *> devices;
+    proto::TimeSeriesRecord record;
+    bool clean = false;
+
+    auto getDevice = [&devices, &series](uint64_t id) {
+        auto iter = devices.find(id);
+        if (iter == devices.end()) {
+            auto device = series.add_device();
+            device->set_id(id);
+            iter = devices.insert(std::make_pair(id, device)).first;
+        }
+        return iter->second;
+    };
+
+    while (google::protobuf::util::ParseDelimitedFromZeroCopyStream(
+            &record, &input, &clean)) {
+        switch (record.record_case()) {
+        case proto::TimeSeriesRecord::kHeader:
+            if (record.header().version() != VERSION) {
+                throw Exception("Unsupported time series version");
+            }
+            series.set_interval(record.header().interval());
+            break;
+
+        case proto::TimeSeriesRecord::kDevice:
+            if (!deviceId || record.device().id() == deviceId) {
+                getDevice(record.device().id())
+                        ->set_name(record.device().name());
+            }
+            break;
+
+        case proto::TimeSeriesRecord::kSample:
+            if (!deviceId || record.sample().deviceid() == deviceId) {
+                getDevice(record.sample().deviceid())
+                        ->add_sample()
+                        ->Swap(record.mutable_sample());
+            }
+            break;
+
+        case proto::TimeSeriesRecord::kFooter:
+            series.set_complete(true);
+            series.set_latecompletions(record.footer().latecompletions());
+            series.set_orphancompletions(record.footer().orphancompletions());
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (!clean) {
+        // Last record of the file is being written by ongoing capture
+        log::verbose << "Partial time series record ignored" << std::endl;
+    }
+}
+
+TimeSeriesRecorder::TimeSeriesRecorder(
+        std::shared_ptr<TimeSeriesRollup> rollup)
+        : m_rollup(rollup)
+        , m_maxBatchSpan(rollup->getInterval() / 2)
+        , m_mutex()
+        , m_events()
+        , m_batchStart(0) {
+    m_events.reserve(BATCH_SIZE);
+    m_rollup->addRecorder(*this);
+}
+
+TimeSeriesRecorder::~TimeSeriesRecorder() {
+    m_rollup->removeRecorder(*this);
+}
+
+void TimeSeriesRecorder::recordDevice(uint64_t id, const std::string &name) {
+    m_rollup->addDevice(id, name);
+}
+
+void TimeSeriesRecorder::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    recordBatch();
+}
+
+void TimeSeriesRecorder::recordBatch() {
+    if (m_events.empty()) {
+        return;
+    }
+
+    m_rollup->record(*this, m_events);
+    m_events.clear();
+}
+
+}  // namespace octf
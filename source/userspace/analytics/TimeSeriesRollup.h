@@ -0,0 +1,288 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TIMESERIESROLLUP_H
+#define SOURCE_USERSPACE_ANALYTICS_TIMESERIESROLLUP_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "InFlightIoMatcher.h"
+#include "InterfaceTraceAnalytics.pb.h"
+#include "LatencyStatisticsHandler.h"
+#include "RollingStatistics.h"
+
+namespace octf {
+
+/**
+ * @brief IO or completion recorded for time series rollups
+ */
+struct RollupEvent {
+    uint64_t timestamp;
+    /** Id of the IO, or of the completed IO */
+    uint64_t id;
+    uint64_t deviceId;
+    /** In sectors */
+    uint32_t len;
+    LatencyOperation operation;
+    bool completion;
+    bool error;
+};
+
+class TimeSeriesRecorder;
+
+/**
+ * @brief Per device, per interval IO statistics maintained while a trace
+ * is captured
+ *
+ * Events are recorded in batches by the recorders of all trace queues.
+ * Completions are matched with their IOs across queues. Every recorder
+ * keeps a watermark, the latest event time it recorded, and an interval is
+ * written to a time series file once the watermarks of all active
+ * recorders have passed it, so the file is readable while capture
+ * continues. Completions of already written intervals are counted as late.
+ *
+ * A timer flushes recorders every half interval. A recorder with nothing
+ * recorded since the previous tick is idle and does not hold intervals
+ * open until it records again.
+ *
+ * The file is a sequence of length delimited proto::TimeSeriesRecord
+ * messages: header, device descriptions and samples as intervals close,
+ * and a footer when the rollup is closed.
+ */
+class TimeSeriesRollup {
+public:
+    /**
+     * @param filePath Path of the time series file to be created
+     * @param interval Length of the interval in ns
+     *
+     * @throw Exception when the file cannot be created
+     */
+    TimeSeriesRollup(const std::string &filePath, uint64_t interval);
+
+    /**
+     * @note Stops the flush timer
+     */
+    ~TimeSeriesRollup();
+
+    TimeSeriesRollup(const TimeSeriesRollup &) = delete;
+    TimeSeriesRollup &operator=(const TimeSeriesRollup &) = delete;
+
+    /**
+     * @note Thread safe
+     */
+    void addDevice(uint64_t id, const std::string &name);
+
+    /**
+     * @brief Registers recorder of a trace queue, it is flushed on timer
+     * and its watermark holds open intervals until it is removed
+     *
+     * @note Thread safe
+     */
+    void addRecorder(TimeSeriesRecorder &recorder);
+
+    /**
+     * @brief Flushes and unregisters recorder of a trace queue
+     *
+     * @note Thread safe
+     */
+    void removeRecorder(TimeSeriesRecorder &recorder);
+
+    /**
+     * @brief Records a batch of events of a single queue, in order
+     *
+     * @param recorder Registered recorder of the queue
+     * @param events Events of the batch
+     *
+     * @note Thread safe
+     */
+    void record(const TimeSeriesRecorder &recorder,
+                const std::vector<RollupEvent> &events);
+
+    /**
+     * @brief Writes all remaining intervals and the footer, events recorded
+     * later are counted as late
+     *
+     * @note Thread safe
+     */
+    void close();
+
+    uint64_t getInterval() const;
+
+    uint64_t getSampleCount() const;
+
+    uint64_t getLateCount() const;
+
+    /**
+     * @return Path of the time series file in the directory of given trace
+     */
+    static std::string getFilePath(const std::string &tracePath);
+
+    /**
+     * @brief Reads time series file of a trace
+     *
+     * @param tracePath Path of the trace in trace repository
+     * @param deviceId Id of reported device, 0 - all devices
+     * @param[out] series Samples grouped by device
+     *
+     * @throw Exception when the file cannot be read
+     */
+    static void read(const std::string &tracePath,
+                     uint64_t deviceId,
+                     proto::TimeSeries &series);
+
+    static constexpr uint32_t VERSION = 1;
+
+private:
+    struct EarlyCompletion {
+        uint64_t timestamp;
+        uint64_t deviceId;
+        bool error;
+    };
+
+    struct Queue {
+        /** Latest event time recorded by the queue */
+        uint64_t watermark;
+        /** Queue recorded events since the previous timer tick */
+        bool recorded;
+        bool idle;
+    };
+
+    void complete(const InFlightIo &io, const EarlyCompletion &completion);
+
+    /**
+     * @brief Writes intervals passed by watermarks of all active queues
+     */
+    void closeIntervals();
+
+    void writeIntervals(uint64_t end);
+
+    void tick();
+
+    void flushRecorders();
+
+    void stopTimer();
+
+    void writeRecord(const proto::TimeSeriesRecord &record);
+
+    const uint64_t m_interval;
+    std::mutex m_mutex;
+    std::ofstream m_file;
+    InFlightIoMatcher m_matcher;
+    /**
+     * Completions consumed before their IO, which was queued on another
+     * CPU whose batch is not recorded yet, by IO id
+     */
+    std::unordered_map<uint64_t, EarlyCompletion> m_early;
+    std::deque<uint64_t> m_earlyOrder;
+    /** Open intervals by index, statistics by device id */
+    std::map<uint64_t, std::map<uint64_t, RollingDeviceStatistics>> m_open;
+    /** Index of the first interval not written yet */
+    uint64_t m_nextIndex;
+    uint64_t m_sampleCount;
+    uint64_t m_lateCount;
+    uint64_t m_orphanCount;
+    bool m_closed;
+    /** Watermarks of registered recorders, guarded by m_mutex */
+    std::unordered_map<const TimeSeriesRecorder *, Queue> m_queues;
+    /**
+     * Recorders flushed on timer, locked before a recorder and before
+     * m_mutex
+     */
+    std::mutex m_recordersMutex;
+    std::vector<TimeSeriesRecorder *> m_recorders;
+    const std::chrono::nanoseconds m_flushPeriod;
+    std::mutex m_timerMutex;
+    std::condition_variable m_timerCv;
+    bool m_timerStopped;
+    std::thread m_timer;
+};
+
+/**
+ * @brief Buffers events of one trace queue and records them into shared
+ * time series rollup in batches
+ *
+ * A batch is recorded when it is full, when it spans half an interval of
+ * event time, or on timer of the rollup, which keeps the shared rollup lock
+ * off the per event path. The lock of the recorder is contended only by
+ * the timer.
+ */
+class TimeSeriesRecorder {
+public:
+    explicit TimeSeriesRecorder(std::shared_ptr<TimeSeriesRollup> rollup);
+
+    /**
+     * @note Records buffered events
+     */
+    ~TimeSeriesRecorder();
+
+    TimeSeriesRecorder(const TimeSeriesRecorder &) = delete;
+    TimeSeriesRecorder &operator=(const TimeSeriesRecorder &) = delete;
+
+    void recordIo(uint64_t timestamp,
+                  uint64_t id,
+                  uint64_t deviceId,
+                  uint32_t len,
+                  LatencyOperation operation) {
+        RollupEvent event = {timestamp, id, deviceId, len, operation, false,
+                             false};
+        push(event);
+    }
+
+    void recordCompletion(uint64_t timestamp,
+                          uint64_t refId,
+                          uint64_t deviceId,
+                          bool error) {
+        RollupEvent event = {
+                timestamp, refId, deviceId, 0, LatencyOperation::Count, true,
+                error};
+        push(event);
+    }
+
+    void recordDevice(uint64_t id, const std::string &name);
+
+    /**
+     * @note Thread safe
+     */
+    void flush();
+
+    static constexpr size_t BATCH_SIZE = 4096;
+
+private:
+    void push(const RollupEvent &event) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_events.empty()) {
+            m_batchStart = event.timestamp;
+        }
+        m_events.push_back(event);
+
+        if (m_events.size() >= BATCH_SIZE ||
+            event.timestamp - m_batchStart >= m_maxBatchSpan) {
+            recordBatch();
+        }
+    }
+
+    void recordBatch();
+
+    std::shared_ptr<TimeSeriesRollup> m_rollup;
+    const uint64_t m_maxBatchSpan;
+    std::mutex m_mutex;
+    std::vector<RollupEvent> m_events;
+    uint64_t m_batchStart;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TIMESERIESROLLUP_H
@@ -0,0 +1,244 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceCompactor.h"
+#include <future>
+#include <limits>
+#include <memory>
+#include "CacheLineTable.h"
+#include "WorkerPool.h"
+
+namespace octf {
+
+constexpr uint32_t TraceCompactor::BLOCK_SIZE;
+
+static constexpr uint32_t SAMPLING_SCALE = 1000000;
+
+CompactionCriteria::CompactionCriteria()
+        : deviceId(0)
+        , lbaBegin(0)
+        , lbaEnd(std::numeric_limits<uint64_t>::max())
+        , timeBegin(0)
+        , timeEnd(std::numeric_limits<uint64_t>::max())
+        , samplingRate(SAMPLING_SCALE)
+        , samplingUnit(1) {}
+
+std::vector<std::string> CompactionCriteria::describe() const {
+    std::vector<std::string> description;
+
+    if (deviceId) {
+        description.push_back("device=" + std::to_string(deviceId));
+    }
+    if (lbaBegin || lbaEnd != std::numeric_limits<uint64_t>::max()) {
+        description.push_back("lba=" + std::to_string(lbaBegin) + "-" +
+                              std::to_string(lbaEnd));
+    }
+    if (timeBegin || timeEnd != std::numeric_limits<uint64_t>::max()) {
+        description.push_back("time_ns=" + std::to_string(timeBegin) + "-" +
+                              std::to_string(timeEnd));
+    }
+    if (samplingRate < SAMPLING_SCALE) {
+        description.push_back("sampling_ppm=" + std::to_string(samplingRate));
+        description.push_back("sampling_unit_sectors=" +
+                              std::to_string(samplingUnit));
+    }
+
+    return description;
+}
+
+/**
+ * @brief Block of kept events, encoded by a worker
+ */
+struct EncodedBlock {
+    std::string data;
+    uint64_t eventCount;
+    uint64_t firstTimestamp;
+    uint64_t lastTimestamp;
+};
+
+static EncodedBlock encodeBlock(
+        const std::vector<std::shared_ptr<proto::trace::Event>> &events) {
+    EncodedBlock block;
+    block.eventCount = events.size();
+    block.firstTimestamp = events.front()->header().timestamp();
+    block.lastTimestamp = events.back()->header().timestamp();
+
+    for (const auto &event : events) {
+        TraceWriter::appendEvent(*event, block.data);
+    }
+
+    return block;
+}
+
+TraceCompactor::TraceCompactor(const CompactionCriteria &criteria,
+                               uint32_t threads,
+                               uint32_t maxInFlight)
+        : m_criteria(criteria)
+        , m_threads(threads)
+        , m_maxInFlight(maxInFlight)
+        , m_inFlight()
+        , m_inFlightOrder()
+        , m_firstTimestamp(0)
+        , m_eventCount(0)
+        , m_ioCount(0)
+        , m_keptIoCount(0)
+        , m_evictedCount(0) {}
+
+void TraceCompactor::compact(MappedTraceReader &reader, TraceWriter &writer) {
+    typedef std::vector<std::shared_ptr<proto::trace::Event>> EventBlock;
+
+    std::deque<std::pair<std::unique_ptr<EventBlock>,
+                         std::future<EncodedBlock>>>
+            blocks;
+    std::unique_ptr<EventBlock> events(new EventBlock());
+    std::shared_ptr<proto::trace::Event> event;
+
+    // Destroyed first, waiting for workers still encoding blocks
+    WorkerPool pool(m_threads);
+
+    auto submit = [&pool, &blocks, &events]() {
+        // Events are released on this thread only, after encoding, as the
+        // reader recycles messages which are not referenced anymore
+        const EventBlock *block = events.get();
+        auto encoded = pool.submit([block]() { return encodeBlock(*block); });
+        blocks.emplace_back(std::move(events), std::move(encoded));
+        events.reset(new EventBlock());
+    };
+
+    auto writeBlock = [&writer, &blocks]() {
+        EncodedBlock block = blocks.front().second.get();
+        blocks.pop_front();
+        writer.writeBlock(block.data, block.eventCount, block.firstTimestamp,
+                          block.lastTimestamp);
+    };
+
+    while (reader.read(event)) {
+        if (!m_eventCount) {
+            m_firstTimestamp = event->header().timestamp();
+        }
+        m_eventCount++;
+
+        if (!isKept(*event)) {
+            continue;
+        }
+
+        events->push_back(std::move(event));
+        if (events->size() < BLOCK_SIZE) {
+            continue;
+        }
+
+        submit();
+
+        // Bound memory, keep just enough blocks to feed all workers
+        if (blocks.size() > 2 * pool.getThreadCount()) {
+            writeBlock();
+        }
+    }
+
+    if (!events->empty()) {
+        submit();
+    }
+    while (!blocks.empty()) {
+        writeBlock();
+    }
+}
+
+uint64_t TraceCompactor::getEventCount() const {
+    return m_eventCount;
+}
+
+uint64_t TraceCompactor::getIoCount() const {
+    return m_ioCount;
+}
+
+uint64_t TraceCompactor::getKeptIoCount() const {
+    return m_keptIoCount;
+}
+
+uint64_t TraceCompactor::getEvictedCount() const {
+    return m_evictedCount;
+}
+
+bool TraceCompactor::keepIo(const proto::trace::Event &event) {
+    const auto &io = event.io();
+    m_ioCount++;
+
+    if (m_criteria.deviceId && io.deviceid() != m_criteria.deviceId) {
+        return false;
+    }
+    if (io.lba() < m_criteria.lbaBegin || io.lba() >= m_criteria.lbaEnd) {
+        return false;
+    }
+
+    uint64_t timestamp = event.header().timestamp();
+    uint64_t time =
+            timestamp > m_firstTimestamp ? timestamp - m_firstTimestamp : 0;
+    if (time < m_criteria.timeBegin || time >= m_criteria.timeEnd) {
+        return false;
+    }
+
+    if (!isSampled(io.deviceid(), io.lba())) {
+        return false;
+    }
+
+    // Remember the IO, so that its completion and metadata are kept too
+    m_inFlight[io.id()] = event.header().sid();
+    m_inFlightOrder.emplace_back(io.id(), event.header().sid());
+    if (m_inFlightOrder.size() > m_maxInFlight) {
+        auto oldest = m_inFlightOrder.front();
+        m_inFlightOrder.pop_front();
+
+        auto iter = m_inFlight.find(oldest.first);
+        if (iter != m_inFlight.end() && iter->second == oldest.second) {
+            m_inFlight.erase(iter);
+            m_evictedCount++;
+        }
+    }
+
+    m_keptIoCount++;
+    return true;
+}
+
+bool TraceCompactor::isSampled(uint64_t deviceId, uint64_t lba) const {
+    if (m_criteria.samplingRate >= SAMPLING_SCALE) {
+        return true;
+    }
+
+    uint64_t unit = lba / m_criteria.samplingUnit;
+    uint64_t hash = hashMix64(hashMix64(deviceId) ^ unit);
+    return hash % SAMPLING_SCALE < m_criteria.samplingRate;
+}
+
+bool TraceCompactor::isKept(const proto::trace::Event &event) {
+    switch (event.EventType_case()) {
+    case proto::trace::Event::kDeviceDescription:
+        return !m_criteria.deviceId ||
+               event.devicedescription().id() == m_criteria.deviceId;
+
+    case proto::trace::Event::kIo:
+        return keepIo(event);
+
+    case proto::trace::Event::kIoCompletion: {
+        auto iter = m_inFlight.find(event.iocompletion().refid());
+        if (iter == m_inFlight.end()) {
+            return false;
+        }
+
+        // Entry in arrival order is dropped once it becomes the oldest
+        m_inFlight.erase(iter);
+        return true;
+    }
+
+    case proto::trace::Event::kFilesystemMeta:
+        // Metadata refers to the IO by its id
+        return m_inFlight.count(event.filesystemmeta().refsid());
+
+    default:
+        // File names are needed to resolve paths of kept IOs
+        return true;
+    }
+}
+
+}  // namespace octf
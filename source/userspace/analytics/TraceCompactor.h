@@ -0,0 +1,118 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACECOMPACTOR_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACECOMPACTOR_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "MappedTraceReader.h"
+#include "TraceWriter.h"
+
+namespace octf {
+
+/**
+ * @brief Criteria of IOs kept by trace compaction
+ */
+struct CompactionCriteria {
+    /** Device id, 0 matches all devices */
+    uint64_t deviceId;
+
+    /** LBA range [lbaBegin, lbaEnd) which IO has to start in */
+    uint64_t lbaBegin;
+    uint64_t lbaEnd;
+
+    /** Time window [timeBegin, timeEnd) in ns since the first event */
+    uint64_t timeBegin;
+    uint64_t timeEnd;
+
+    /** Fraction of sampling units kept, in parts per million */
+    uint32_t samplingRate;
+
+    /** Sampling unit in sectors */
+    uint64_t samplingUnit;
+
+    CompactionCriteria();
+
+    /**
+     * @return Description of criteria recorded in trace summary
+     */
+    std::vector<std::string> describe() const;
+};
+
+/**
+ * @brief Rewrites trace keeping only IOs matching criteria
+ *
+ * IOs are sampled spatially with consistent hashing: hash of device and
+ * sampling unit the IO starts in decides, so all IOs to a sampled unit are
+ * kept, which preserves reuse patterns for cache analyses.
+ *
+ * Completions and file system metadata of kept IOs are kept with them,
+ * found by IO id in a bounded table of kept IOs which are not completed
+ * yet. Device descriptions of matching devices and file names are always
+ * kept.
+ *
+ * Events are decoded and filtered on the calling thread, and encoded in
+ * blocks by worker threads, while blocks are written in order. Filtering
+ * is not split per queue, completion of an IO may be traced on another
+ * queue than the IO, so the table of kept IOs needs events in sid order.
+ */
+class TraceCompactor {
+public:
+    /**
+     * @param criteria Criteria of kept IOs
+     * @param threads Number of encoding threads, 0 - number of CPUs
+     * @param maxInFlight Capacity of the table of kept IOs
+     */
+    TraceCompactor(const CompactionCriteria &criteria,
+                   uint32_t threads,
+                   uint32_t maxInFlight);
+    virtual ~TraceCompactor() = default;
+
+    void compact(MappedTraceReader &reader, TraceWriter &writer);
+
+    uint64_t getEventCount() const;
+
+    uint64_t getIoCount() const;
+
+    uint64_t getKeptIoCount() const;
+
+    /**
+     * @return Kept IOs evicted from the table before their completion
+     */
+    uint64_t getEvictedCount() const;
+
+private:
+    /** Events in a block encoded by one worker */
+    static constexpr uint32_t BLOCK_SIZE = 4096;
+
+    bool keepIo(const proto::trace::Event &event);
+
+    bool isSampled(uint64_t deviceId, uint64_t lba) const;
+
+    bool isKept(const proto::trace::Event &event);
+
+    const CompactionCriteria m_criteria;
+    const uint32_t m_threads;
+    const uint32_t m_maxInFlight;
+
+    /** Kept IOs by IO id, with ids and sids in arrival order */
+    std::unordered_map<uint64_t, uint64_t> m_inFlight;
+    std::deque<std::pair<uint64_t, uint64_t>> m_inFlightOrder;
+
+    uint64_t m_firstTimestamp;
+    uint64_t m_eventCount;
+    uint64_t m_ioCount;
+    uint64_t m_keptIoCount;
+    uint64_t m_evictedCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACECOMPACTOR_H
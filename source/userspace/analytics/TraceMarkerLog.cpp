@@ -0,0 +1,94 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceMarkerLog.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+
+namespace octf {
+
+static constexpr char MARKERS_FILE_NAME[] = "octf.markers";
+
+TraceMarkerLog::TraceMarkerLog()
+        : m_mutex()
+        , m_markers() {}
+
+void TraceMarkerLog::add(uint64_t sid,
+                         uint64_t timestamp,
+                         const std::string &text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto marker = m_markers.add_marker();
+    marker->set_sid(sid);
+    marker->set_timestamp(timestamp);
+    marker->set_text(text);
+}
+
+uint64_t TraceMarkerLog::getCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_markers.marker_size();
+}
+
+void TraceMarkerLog::getMarkers(proto::TraceMarkers &markers) const {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        markers = m_markers;
+    }
+
+    // Queues are consumed independently, markers come in any order
+    std::sort(markers.mutable_marker()->begin(),
+              markers.mutable_marker()->end(),
+              [](const proto::TraceMarker &a, const proto::TraceMarker &b) {
+                  return a.sid() < b.sid();
+              });
+}
+
+std::string TraceMarkerLog::getFilePath(const std::string &tracePath) {
+    return getFrameworkConfiguration().getTraceRepositoryPath() + "/" +
+           tracePath + "/" + MARKERS_FILE_NAME;
+}
+
+void TraceMarkerLog::write(const std::string &tracePath,
+                           const proto::TraceMarkers &markers) {
+    std::string path = getFilePath(tracePath);
+
+    // Write to temporary file and rename, readers never see partial markers
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios_base::out |
+                                            std::ios_base::binary |
+                                            std::ios_base::trunc);
+        if (!file.good() || !markers.SerializeToOstream(&file)) {
+            file.close();
+            std::remove(tmpPath.c_str());
+            throw Exception("Cannot write trace markers " + path);
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str())) {
+        std::remove(tmpPath.c_str());
+        throw Exception("Cannot write trace markers " + path);
+    }
+}
+
+void TraceMarkerLog::read(const std::string &tracePath,
+                          proto::TraceMarkers &markers) {
+    markers.Clear();
+
+    std::string path = getFilePath(tracePath);
+    std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file.good()) {
+        return;
+    }
+
+    if (!markers.ParseFromIstream(&file)) {
+        throw Exception("Cannot read trace markers " + path);
+    }
+}
+
+}  // namespace octf
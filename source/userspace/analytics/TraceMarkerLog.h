@@ -0,0 +1,65 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEMARKERLOG_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEMARKERLOG_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "InterfaceTraceAnalytics.pb.h"
+
+namespace octf {
+
+/**
+ * @brief User markers captured in a trace
+ *
+ * Trace events have no type for markers, so converters keep a marker in the
+ * trace as an event with header only and add its text to the log shared by
+ * all trace queues. Once capture stops, the log is stored next to the trace.
+ */
+class TraceMarkerLog {
+public:
+    TraceMarkerLog();
+
+    /**
+     * @note Thread safe
+     */
+    void add(uint64_t sid, uint64_t timestamp, const std::string &text);
+
+    uint64_t getCount() const;
+
+    /**
+     * @param[out] markers Markers in order of sid
+     */
+    void getMarkers(proto::TraceMarkers &markers) const;
+
+    /**
+     * @return Path of the markers file in the directory of given trace
+     */
+    static std::string getFilePath(const std::string &tracePath);
+
+    /**
+     * @throw Exception when the file cannot be written
+     */
+    static void write(const std::string &tracePath,
+                      const proto::TraceMarkers &markers);
+
+    /**
+     * @note Trace without markers file has no markers
+     *
+     * @throw Exception when the file cannot be read
+     */
+    static void read(const std::string &tracePath,
+                     proto::TraceMarkers &markers);
+
+private:
+    mutable std::mutex m_mutex;
+    proto::TraceMarkers m_markers;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEMARKERLOG_H
@@ -0,0 +1,200 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceMerger.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <octf/utils/Exception.h>
+#include <octf/utils/Log.h>
+
+namespace octf {
+
+/** Device numbers fit in 32 bits, trace index goes above them */
+static constexpr uint32_t TRACE_INDEX_SHIFT = 32;
+
+/** Odd constant, IO ids of each trace are XORed with its multiple */
+static constexpr uint64_t IO_ID_SALT = 0x9E3779B97F4A7C15ULL;
+
+TraceMerger::TraceMerger(const std::vector<std::string> &tracePaths)
+        : m_tracePaths(tracePaths)
+        , m_offsets(tracePaths.size(), 0)
+        , m_eventCounts(tracePaths.size(), 0)
+        , m_sid(0) {
+    if (tracePaths.size() < 2) {
+        throw Exception("At least two traces are needed for merging");
+    }
+}
+
+void TraceMerger::setOffsets(const std::vector<int64_t> &offsets) {
+    if (offsets.size() != m_tracePaths.size()) {
+        throw Exception("Number of clock offsets differs from number of "
+                        "traces");
+    }
+
+    m_offsets = offsets;
+}
+
+void TraceMerger::estimateOffsets() {
+    // First description timestamp of each device name, per trace
+    std::vector<std::map<std::string, uint64_t>> descriptions;
+    std::vector<uint64_t> firstDescriptions;
+
+    for (const auto &path : m_tracePaths) {
+        MappedTraceReader reader(path);
+        std::shared_ptr<proto::trace::Event> event;
+        std::map<std::string, uint64_t> names;
+        uint64_t first = 0;
+
+        // Descriptions are at the beginning of the trace
+        while (reader.read(event) && event->has_devicedescription()) {
+            uint64_t timestamp = event->header().timestamp();
+            names.emplace(event->devicedescription().name(), timestamp);
+            if (names.size() == 1) {
+                first = timestamp;
+            }
+        }
+
+        if (names.empty()) {
+            throw Exception("No device descriptions to align clock of trace " +
+                            path + ", specify offsets");
+        }
+
+        descriptions.push_back(names);
+        firstDescriptions.push_back(first);
+    }
+
+    const auto &reference = descriptions.front();
+    m_offsets[0] = 0;
+
+    for (uint32_t i = 1; i < descriptions.size(); i++) {
+        int64_t offset = static_cast<int64_t>(firstDescriptions[0] -
+                                              firstDescriptions[i]);
+
+        // Prefer a shared device, it is described by all hosts
+        for (const auto &device : descriptions[i]) {
+            auto iter = reference.find(device.first);
+            if (iter != reference.end()) {
+                offset = static_cast<int64_t>(iter->second - device.second);
+                break;
+            }
+        }
+
+        m_offsets[i] = offset;
+        log::verbose << "Clock offset of trace " << m_tracePaths[i] << " is "
+                     << offset << " ns" << std::endl;
+    }
+}
+
+void TraceMerger::merge(TraceWriter &writer) {
+    std::vector<std::unique_ptr<MappedTraceReader>> readers;
+    std::vector<std::shared_ptr<proto::trace::Event>> heads(
+            m_tracePaths.size());
+    for (const auto &path : m_tracePaths) {
+        readers.emplace_back(new MappedTraceReader(path));
+    }
+
+    // Shift all timestamps so that none of them becomes negative
+    int64_t minOffset = *std::min_element(m_offsets.begin(), m_offsets.end());
+    std::vector<uint64_t> shifts;
+    for (auto offset : m_offsets) {
+        shifts.push_back(static_cast<uint64_t>(offset - minOffset));
+    }
+
+    /** Aligned timestamp, trace index */
+    typedef std::tuple<uint64_t, uint32_t> HeadKey;
+    std::priority_queue<HeadKey, std::vector<HeadKey>, std::greater<HeadKey>>
+            queue;
+
+    for (uint32_t i = 0; i < readers.size(); i++) {
+        if (readers[i]->read(heads[i])) {
+            queue.emplace(heads[i]->header().timestamp() + shifts[i], i);
+        }
+    }
+
+    while (!queue.empty()) {
+        uint32_t index = std::get<1>(queue.top());
+        queue.pop();
+
+        remap(*heads[index], index, shifts[index]);
+        writer.write(*heads[index]);
+        m_eventCounts[index]++;
+
+        if (readers[index]->read(heads[index])) {
+            queue.emplace(heads[index]->header().timestamp() + shifts[index],
+                          index);
+        }
+    }
+}
+
+const std::vector<int64_t> &TraceMerger::getOffsets() const {
+    return m_offsets;
+}
+
+const std::vector<uint64_t> &TraceMerger::getEventCounts() const {
+    return m_eventCounts;
+}
+
+uint64_t TraceMerger::getDeviceId(uint64_t id, uint32_t trace) {
+    return id | (static_cast<uint64_t>(trace) << TRACE_INDEX_SHIFT);
+}
+
+void TraceMerger::remap(proto::trace::Event &event,
+                        uint32_t trace,
+                        uint64_t shift) {
+    auto header = event.mutable_header();
+    header->set_sid(++m_sid);
+    header->set_timestamp(header->timestamp() + shift);
+
+    if (!trace) {
+        return;
+    }
+
+    uint64_t salt = IO_ID_SALT * trace;
+
+    switch (event.EventType_case()) {
+    case proto::trace::Event::kDeviceDescription: {
+        auto description = event.mutable_devicedescription();
+        description->set_id(getDeviceId(description->id(), trace));
+    } break;
+
+    case proto::trace::Event::kIo: {
+        auto io = event.mutable_io();
+        io->set_deviceid(getDeviceId(io->deviceid(), trace));
+        io->set_id(io->id() ^ salt);
+    } break;
+
+    case proto::trace::Event::kIoCompletion: {
+        auto completion = event.mutable_iocompletion();
+        completion->set_deviceid(getDeviceId(completion->deviceid(), trace));
+        completion->set_refid(completion->refid() ^ salt);
+    } break;
+
+    case proto::trace::Event::kFilesystemMeta: {
+        // Metadata refers to the IO by its id
+        auto meta = event.mutable_filesystemmeta();
+        meta->set_partitionid(getDeviceId(meta->partitionid(), trace));
+        meta->set_refsid(meta->refsid() ^ salt);
+    } break;
+
+    case proto::trace::Event::kFilesystemFileName: {
+        auto name = event.mutable_filesystemfilename();
+        name->set_partitionid(getDeviceId(name->partitionid(), trace));
+    } break;
+
+    case proto::trace::Event::kFilesystemFileEvent: {
+        auto fileEvent = event.mutable_filesystemfileevent();
+        fileEvent->set_partitionid(
+                getDeviceId(fileEvent->partitionid(), trace));
+    } break;
+
+    default:
+        break;
+    }
+}
+
+}  // namespace octf
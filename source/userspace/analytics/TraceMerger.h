@@ -0,0 +1,79 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEMERGER_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEMERGER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedTraceReader.h"
+#include "TraceWriter.h"
+
+namespace octf {
+
+/**
+ * @brief Merges traces captured on different hosts into one trace
+ *
+ * Clocks of hosts are aligned by offsets added to timestamps of each trace.
+ * Offsets are either given, or estimated from device description events,
+ * which each trace starts with: the first description of a device also
+ * seen by the reference (first) trace, or the first description at all,
+ * is assumed to be taken at the same time as in the reference trace.
+ *
+ * Events are merged with a k-way merge of trace readers, so only the head
+ * event of each trace is held in memory. Sequence ids are renumbered, and
+ * device, partition and IO ids of all but the reference trace are made
+ * unique per trace, as hosts number their devices and IOs independently.
+ */
+class TraceMerger {
+public:
+    /**
+     * @param tracePaths Paths of traces in trace repository, the first one
+     * is the reference
+     */
+    explicit TraceMerger(const std::vector<std::string> &tracePaths);
+    virtual ~TraceMerger() = default;
+
+    /**
+     * @brief Sets clock offsets in ns added to timestamps of each trace
+     */
+    void setOffsets(const std::vector<int64_t> &offsets);
+
+    /**
+     * @brief Estimates clock offsets from device descriptions
+     */
+    void estimateOffsets();
+
+    /**
+     * @brief Merges traces into writer
+     */
+    void merge(TraceWriter &writer);
+
+    const std::vector<int64_t> &getOffsets() const;
+
+    /**
+     * @return Number of events read from each trace
+     */
+    const std::vector<uint64_t> &getEventCounts() const;
+
+    /**
+     * @return Id of device of given trace in the merged trace
+     */
+    static uint64_t getDeviceId(uint64_t id, uint32_t trace);
+
+private:
+    void remap(proto::trace::Event &event, uint32_t trace, uint64_t shift);
+
+    const std::vector<std::string> m_tracePaths;
+    std::vector<int64_t> m_offsets;
+    std::vector<uint64_t> m_eventCounts;
+    uint64_t m_sid;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEMERGER_H
@@ -0,0 +1,113 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceProfile.h"
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+static constexpr size_t METRIC_COUNT =
+        static_cast<size_t>(ProfileMetric::Count);
+
+static constexpr size_t OPERATION_COUNT =
+        static_cast<size_t>(LatencyOperation::Count);
+
+const char *getProfileMetricName(ProfileMetric metric) {
+    switch (metric) {
+    case ProfileMetric::Latency:
+        return "latency";
+    case ProfileMetric::Size:
+        return "size";
+    case ProfileMetric::QueueDepth:
+        return "queueDepth";
+    default:
+        return "unknown";
+    }
+}
+
+static std::string getFileKey(const proto::trace::ParsedEvent &io) {
+    if (!io.file().path().empty()) {
+        return io.file().path();
+    }
+
+    return std::to_string(io.device().partition()) + ":" +
+           std::to_string(io.file().id());
+}
+
+TraceProfile::TraceProfile(uint32_t precision)
+        : m_precision(precision)
+        , m_histograms(METRIC_COUNT * OPERATION_COUNT,
+                       LatencyHistogram(precision))
+        , m_files()
+        , m_ioCount(0) {}
+
+void TraceProfile::record(const proto::trace::ParsedEvent &io) {
+    LatencyOperation operation;
+    if (!getLatencyOperation(io, operation)) {
+        return;
+    }
+
+    uint64_t bytes = io.io().len() * SECTOR_SIZE;
+
+    m_histograms[getIndex(ProfileMetric::Latency, operation)].record(
+            io.io().latency());
+    m_histograms[getIndex(ProfileMetric::Size, operation)].record(bytes);
+    m_histograms[getIndex(ProfileMetric::QueueDepth, operation)].record(
+            io.io().qd());
+    m_ioCount++;
+
+    if (io.has_file() && io.file().id()) {
+        FileHotness &file = m_files[getFileKey(io)];
+        file.ios++;
+        file.bytes += bytes;
+    }
+}
+
+void TraceProfile::merge(const TraceProfile &other) {
+    if (other.m_precision != m_precision) {
+        throw Exception("Cannot merge trace profiles of different precision");
+    }
+
+    for (size_t i = 0; i < m_histograms.size(); i++) {
+        m_histograms[i].merge(other.m_histograms[i]);
+    }
+
+    for (const auto &file : other.m_files) {
+        FileHotness &hotness = m_files[file.first];
+        hotness.ios += file.second.ios;
+        hotness.bytes += file.second.bytes;
+    }
+
+    m_ioCount += other.m_ioCount;
+}
+
+const LatencyHistogram &TraceProfile::getHistogram(
+        ProfileMetric metric,
+        LatencyOperation operation) const {
+    return m_histograms.at(getIndex(metric, operation));
+}
+
+const std::unordered_map<std::string, FileHotness> &TraceProfile::getFiles()
+        const {
+    return m_files;
+}
+
+uint64_t TraceProfile::getIoCount() const {
+    return m_ioCount;
+}
+
+uint32_t TraceProfile::getPrecision() const {
+    return m_precision;
+}
+
+size_t TraceProfile::getIndex(ProfileMetric metric,
+                              LatencyOperation operation) {
+    return static_cast<size_t>(metric) * OPERATION_COUNT +
+           static_cast<size_t>(operation);
+}
+
+}  // namespace octf
@@ -0,0 +1,88 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEPROFILE_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEPROFILE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <octf/proto/parsedTrace.pb.h>
+#include "LatencyHistogram.h"
+#include "LatencyStatisticsHandler.h"
+
+namespace octf {
+
+enum class ProfileMetric {
+    Latency = 0,
+    Size,
+    QueueDepth,
+    Count,
+};
+
+const char *getProfileMetricName(ProfileMetric metric);
+
+/**
+ * @brief IO counters of single file
+ */
+struct FileHotness {
+    uint64_t ios;
+    uint64_t bytes;
+};
+
+/**
+ * @brief Distributions of latency, size and queue depth per operation and
+ * IO counters per file, collected in one pass over a trace
+ *
+ * Profiles of the same precision merge exactly, so segments of a trace can
+ * be profiled by independent workers.
+ */
+class TraceProfile {
+public:
+    /**
+     * @param precision Number of significant decimal digits of histograms
+     */
+    explicit TraceProfile(uint32_t precision);
+
+    /**
+     * @brief Records parsed IO, failed IOs and IOs of unknown operation
+     * are skipped
+     */
+    void record(const proto::trace::ParsedEvent &io);
+
+    /**
+     * @throw Exception when precisions differ
+     */
+    void merge(const TraceProfile &other);
+
+    const LatencyHistogram &getHistogram(ProfileMetric metric,
+                                         LatencyOperation operation) const;
+
+    /**
+     * @return IO counters by file path, or by "<partition>:<inode>" when
+     * the path is not known
+     */
+    const std::unordered_map<std::string, FileHotness> &getFiles() const;
+
+    /**
+     * @return Number of recorded IOs
+     */
+    uint64_t getIoCount() const;
+
+    uint32_t getPrecision() const;
+
+private:
+    static size_t getIndex(ProfileMetric metric, LatencyOperation operation);
+
+    const uint32_t m_precision;
+    std::vector<LatencyHistogram> m_histograms;
+    std::unordered_map<std::string, FileHotness> m_files;
+    uint64_t m_ioCount;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEPROFILE_H
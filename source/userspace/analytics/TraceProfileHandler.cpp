@@ -0,0 +1,19 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceProfileHandler.h"
+
+namespace octf {
+
+TraceProfileHandler::TraceProfileHandler(const std::string &tracePath,
+                                         TraceProfile &profile)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_profile(profile) {}
+
+void TraceProfileHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    m_profile.record(io);
+}
+
+}  // namespace octf
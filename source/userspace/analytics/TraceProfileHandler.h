@@ -0,0 +1,35 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEPROFILEHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEPROFILEHANDLER_H
+
+#include <string>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "TraceProfile.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler recording IOs of a trace into its profile
+ */
+class TraceProfileHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace to be profiled
+     * @param profile Profile to record IOs into
+     */
+    TraceProfileHandler(const std::string &tracePath, TraceProfile &profile);
+    virtual ~TraceProfileHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+private:
+    TraceProfile &m_profile;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEPROFILEHANDLER_H
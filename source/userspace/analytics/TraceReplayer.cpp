@@ -0,0 +1,541 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceReplayer.h"
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <octf/utils/Exception.h>
+#include "InFlightIoMatcher.h"
+#include "IoUring.h"
+#include "MappedTraceReader.h"
+#include "WorkerPool.h"
+
+namespace octf {
+
+static constexpr uint32_t REPLAY_PRECISION = 3;
+
+/** Number of IOs in a single batch of all replay threads */
+static constexpr uint64_t BATCH_SIZE = 4096;
+
+/** Number of batches which can be queued for the slowest replay thread */
+static constexpr uint32_t QUEUE_LIMIT = 16;
+
+/** Replay thread takes next batch when it has fewer IOs pending */
+static constexpr size_t REFILL_THRESHOLD = 1024;
+
+/** Largest replayed IO in bytes */
+static constexpr uint64_t MAX_IO_SIZE = 16 * 1024 * 1024;
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+static constexpr uint64_t BUFFER_ALIGNMENT = 4096;
+
+static constexpr uint32_t MAX_IN_FLIGHT = 1 << 20;
+
+static constexpr uint64_t IN_FLIGHT_TIMEOUT = 30ULL * 1000000000ULL;
+
+/**
+ * Maximum time a replay thread waits without looking for new batches,
+ * in ns
+ */
+static constexpr uint64_t POLL_INTERVAL = 1000000;
+
+/** User data of the timeout entry, other entries carry slot index */
+static constexpr uint64_t TIMEOUT_TAG = ~0ULL;
+
+static std::vector<LatencyHistogram> createHistograms() {
+    return std::vector<LatencyHistogram>(
+            static_cast<size_t>(LatencyOperation::Count),
+            LatencyHistogram(REPLAY_PRECISION));
+}
+
+static void mergeHistograms(std::vector<LatencyHistogram> &histograms,
+                            const std::vector<LatencyHistogram> &other) {
+    for (size_t i = 0; i < histograms.size(); i++) {
+        histograms[i].merge(other[i]);
+    }
+}
+
+TraceReplayer::WorkerResult::WorkerResult()
+        : latencies(createHistograms())
+        , delays(REPLAY_PRECISION)
+        , replayed(0)
+        , errors(0) {}
+
+TraceReplayer::TraceReplayer(const ReplayOptions &options)
+        : m_options(options)
+        , m_fd(-1)
+        , m_capacity(0)
+        , m_blockSize(0)
+        , m_threadCount(WorkerPool::resolveThreadCount(options.threadCount))
+        , m_broadcaster()
+        , m_threads()
+        , m_errors()
+        , m_results()
+        , m_batch()
+        , m_dispatchedCount(0)
+        , m_start(0)
+        , m_firstTimestamp(0)
+        , m_lastTimestamp(0)
+        , m_ioCount(0)
+        , m_skippedCount(0)
+        , m_replayedCount(0)
+        , m_errorCount(0)
+        , m_replayDuration(0)
+        , m_recorded(createHistograms())
+        , m_achieved(createHistograms())
+        , m_delays(REPLAY_PRECISION) {
+    if (!options.queueDepth) {
+        throw Exception("Invalid replay queue depth");
+    }
+
+    int flags = (options.writes ? O_RDWR : O_RDONLY) | O_DIRECT;
+    m_fd = open(options.targetPath.c_str(), flags);
+    if (m_fd < 0) {
+        throw Exception("Cannot open replay target " + options.targetPath +
+                        ": " + strerror(errno));
+    }
+
+    struct stat st;
+    int blockSize = 0;
+    bool valid = !fstat(m_fd, &st);
+
+    if (valid && S_ISBLK(st.st_mode)) {
+        valid = !ioctl(m_fd, BLKGETSIZE64, &m_capacity) &&
+                !ioctl(m_fd, BLKSSZGET, &blockSize);
+    } else if (valid && S_ISREG(st.st_mode)) {
+        m_capacity = st.st_size;
+        blockSize = st.st_blksize;
+    } else {
+        valid = false;
+    }
+
+    m_blockSize = std::max<uint32_t>(blockSize, SECTOR_SIZE);
+    if (!valid || m_capacity < m_blockSize) {
+        close(m_fd);
+        throw Exception("Invalid replay target " + options.targetPath +
+                        ", block device or file expected");
+    }
+}
+
+TraceReplayer::~TraceReplayer() {
+    if (m_broadcaster) {
+        m_broadcaster->close();
+    }
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+
+    close(m_fd);
+}
+
+void TraceReplayer::replay(const std::string &tracePath) {
+    if (m_broadcaster) {
+        throw Exception("Trace already replayed");
+    }
+
+    MappedTraceReader reader(tracePath);
+    InFlightIoMatcher matcher(MAX_IN_FLIGHT, IN_FLIGHT_TIMEOUT);
+    std::shared_ptr<proto::trace::Event> event;
+
+    start();
+
+    while (reader.read(event)) {
+        uint64_t timestamp = event->header().timestamp();
+
+        if (event->has_io()) {
+            const auto &io = event->io();
+            if (m_options.deviceId && io.deviceid() != m_options.deviceId) {
+                continue;
+            }
+
+            if (!m_ioCount) {
+                m_firstTimestamp = timestamp;
+            }
+            m_lastTimestamp = timestamp;
+            m_ioCount++;
+
+            ReplayIo replayIo;
+            if (!getReplayIo(io, timestamp, replayIo)) {
+                m_skippedCount++;
+                continue;
+            }
+
+            InFlightIo inFlight = {};
+            inFlight.id = io.id();
+            inFlight.timestamp = timestamp;
+            inFlight.deviceId = io.deviceid();
+            inFlight.operation = static_cast<uint32_t>(replayIo.operation);
+            matcher.queue(inFlight);
+
+            if (!m_batch) {
+                m_batch = std::make_shared<Batch>(m_threadCount);
+            }
+            (*m_batch)[m_dispatchedCount % m_threadCount].push_back(replayIo);
+            m_dispatchedCount++;
+
+            if (m_dispatchedCount % BATCH_SIZE == 0) {
+                publish();
+            }
+        } else if (event->has_iocompletion()) {
+            const auto &completion = event->iocompletion();
+            InFlightIo io;
+
+            if (matcher.complete(completion.refid(), completion.deviceid(),
+                                 timestamp, io) &&
+                !completion.error()) {
+                m_recorded[io.operation].record(
+                        timestamp > io.timestamp ? timestamp - io.timestamp
+                                                 : 0);
+            }
+        }
+    }
+
+    finish();
+}
+
+void TraceReplayer::start() {
+    m_errors.resize(m_threadCount);
+    m_results.resize(m_threadCount);
+    m_broadcaster.reset(
+            new BatchBroadcaster<Batch>(m_threadCount, QUEUE_LIMIT));
+    for (uint32_t i = 0; i < m_threadCount; i++) {
+        m_threads.emplace_back(&TraceReplayer::run, this, i);
+    }
+}
+
+void TraceReplayer::finish() {
+    if (m_batch) {
+        publish();
+    }
+
+    m_broadcaster->close();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    m_replayDuration = m_start ? getTime() : 0;
+
+    for (const auto &error : m_errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (const auto &result : m_results) {
+        mergeHistograms(m_achieved, result.latencies);
+        m_delays.merge(result.delays);
+        m_replayedCount += result.replayed;
+        m_errorCount += result.errors;
+    }
+}
+
+void TraceReplayer::publish() {
+    std::shared_ptr<const Batch> batch(std::move(m_batch));
+    m_batch.reset();
+
+    if (!m_start) {
+        // Clock starts with the first batch, not with reading of the trace
+        m_start = getTime();
+    }
+    m_broadcaster->publish(batch);
+}
+
+bool TraceReplayer::getReplayIo(const proto::trace::EventIo &io,
+                                uint64_t timestamp,
+                                ReplayIo &replayIo) {
+    if (io.flush() && !io.len()) {
+        replayIo.operation = LatencyOperation::Flush;
+    } else if (io.operation() == proto::trace::IoType::Read) {
+        replayIo.operation = LatencyOperation::Read;
+    } else if (io.operation() == proto::trace::IoType::Write &&
+               m_options.writes) {
+        replayIo.operation = LatencyOperation::Write;
+    } else {
+        // Discards would drop data of the target
+        return false;
+    }
+
+    uint64_t size = io.len() * SECTOR_SIZE;
+    size = (size + m_blockSize - 1) / m_blockSize * m_blockSize;
+    if (size > MAX_IO_SIZE || size > m_capacity ||
+        (!size && replayIo.operation != LatencyOperation::Flush)) {
+        return false;
+    }
+
+    uint64_t offset = (io.lba() + m_options.lbaOffset) * SECTOR_SIZE;
+    if (offset + size > m_capacity) {
+        offset %= m_capacity - size + 1;
+    }
+
+    replayIo.offset = offset - offset % m_blockSize;
+    replayIo.size = size;
+    replayIo.due = m_options.speed
+                           ? (timestamp - m_firstTimestamp) * 100 /
+                                     m_options.speed
+                           : 0;
+    return true;
+}
+
+uint64_t TraceReplayer::getTime() const {
+    uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+    return now - m_start;
+}
+
+/**
+ * @brief IO in flight with its buffer, aligned for direct IO
+ */
+struct ReplaySlot {
+    void *buffer;
+    uint64_t capacity;
+    struct iovec iov;
+    uint64_t submitted;
+    LatencyOperation operation;
+
+    ReplaySlot()
+            : buffer(nullptr)
+            , capacity(0)
+            , iov()
+            , submitted(0)
+            , operation(LatencyOperation::Count) {}
+
+    ReplaySlot(const ReplaySlot &) = delete;
+    ReplaySlot &operator=(const ReplaySlot &) = delete;
+
+    ~ReplaySlot() {
+        free(buffer);
+    }
+
+    void reserve(uint64_t size) {
+        if (size <= capacity) {
+            return;
+        }
+
+        free(buffer);
+        buffer = nullptr;
+        capacity = 0;
+
+        if (posix_memalign(&buffer, BUFFER_ALIGNMENT, size)) {
+            buffer = nullptr;
+            throw Exception("Cannot allocate replay buffer");
+        }
+
+        // Never write uninitialized memory to the target
+        memset(buffer, 0, size);
+        capacity = size;
+    }
+};
+
+/**
+ * @brief Waits for completion of all entries submitted to the ring
+ *
+ * Closing a ring does not wait for IOs in flight, which could still write
+ * into their buffers. When the ring fails, buffers of IOs in flight are
+ * left allocated instead.
+ */
+static void reapAll(IoUring &ring,
+                    std::vector<ReplaySlot> &slots,
+                    const std::vector<uint32_t> &freeSlots,
+                    bool timeoutPending) {
+    std::vector<bool> busy(slots.size(), true);
+    for (auto index : freeSlots) {
+        busy[index] = false;
+    }
+
+    uint64_t outstanding = slots.size() - freeSlots.size() + timeoutPending;
+
+    try {
+        while (outstanding) {
+            ring.submit(1);
+
+            uint64_t userData;
+            int32_t status;
+            while (ring.reap(userData, status)) {
+                if (userData != TIMEOUT_TAG) {
+                    busy[userData] = false;
+                }
+                outstanding--;
+            }
+        }
+    } catch (Exception &) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (busy[i]) {
+                slots[i].buffer = nullptr;
+                slots[i].capacity = 0;
+            }
+        }
+    }
+}
+
+void TraceReplayer::run(uint32_t worker) {
+    auto &result = m_results[worker];
+    std::shared_ptr<const Batch> batch;
+    std::vector<ReplaySlot> slots(m_options.queueDepth);
+    std::unique_ptr<IoUring> ring;
+    std::vector<uint32_t> freeSlots;
+    bool timeoutPending = false;
+
+    try {
+        ring.reset(new IoUring(m_options.queueDepth + 1));
+        std::deque<ReplayIo> pending;
+        bool closed = false;
+
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            freeSlots.push_back(i);
+        }
+
+        while (!closed || !pending.empty() || timeoutPending ||
+               freeSlots.size() < slots.size()) {
+            if (!closed && pending.size() < REFILL_THRESHOLD) {
+                bool received;
+
+                if (pending.empty() && !timeoutPending &&
+                    freeSlots.size() == slots.size()) {
+                    // Nothing to do until next batch
+                    received = m_broadcaster->next(worker, batch);
+                    closed = !received;
+                } else {
+                    received = m_broadcaster->tryNext(worker, batch, closed);
+                }
+
+                if (received) {
+                    const auto &ios = (*batch)[worker];
+                    pending.insert(pending.end(), ios.begin(), ios.end());
+                }
+            }
+
+            uint64_t now = getTime();
+            uint32_t submitted = 0;
+
+            while (!pending.empty() && !freeSlots.empty() &&
+                   pending.front().due <= now) {
+                const auto &io = pending.front();
+                uint32_t index = freeSlots.back();
+                auto &slot = slots[index];
+
+                slot.reserve(io.size);
+                slot.iov.iov_base = slot.buffer;
+                slot.iov.iov_len = io.size;
+                slot.operation = io.operation;
+
+                switch (io.operation) {
+                case LatencyOperation::Flush:
+                    ring->prepareFsync(m_fd, index);
+                    break;
+                case LatencyOperation::Write:
+                    ring->prepareWrite(m_fd, &slot.iov, io.offset, index);
+                    break;
+                default:
+                    ring->prepareRead(m_fd, &slot.iov, io.offset, index);
+                    break;
+                }
+
+                slot.submitted = now;
+                result.delays.record(now - io.due);
+                freeSlots.pop_back();
+                pending.pop_front();
+                submitted++;
+            }
+
+            if (!timeoutPending && !freeSlots.empty() &&
+                (!pending.empty() || !closed)) {
+                // Sleep until the next IO is due, or a completion arrives
+                uint64_t timeout = pending.empty()
+                                           ? POLL_INTERVAL
+                                           : pending.front().due - now;
+                timeoutPending = ring->prepareTimeout(timeout, TIMEOUT_TAG);
+            }
+
+            bool inFlight = freeSlots.size() < slots.size();
+            ring->submit(!submitted && (inFlight || timeoutPending) ? 1 : 0);
+
+            uint64_t userData;
+            int32_t status;
+            now = getTime();
+
+            while (ring->reap(userData, status)) {
+                if (userData == TIMEOUT_TAG) {
+                    timeoutPending = false;
+                    continue;
+                }
+
+                auto &slot = slots[userData];
+                auto operation = static_cast<size_t>(slot.operation);
+
+                result.latencies[operation].record(now - slot.submitted);
+                result.replayed++;
+                if (status < 0 ||
+                    (slot.operation != LatencyOperation::Flush &&
+                     static_cast<uint64_t>(status) != slot.iov.iov_len)) {
+                    result.errors++;
+                }
+
+                freeSlots.push_back(userData);
+            }
+        }
+    } catch (...) {
+        m_errors[worker] = std::current_exception();
+
+        if (ring) {
+            reapAll(*ring, slots, freeSlots, timeoutPending);
+        }
+
+        // Keep consuming, so the producer is never blocked by this worker
+        while (m_broadcaster->next(worker, batch)) {
+        }
+    }
+}
+
+uint64_t TraceReplayer::getIoCount() const {
+    return m_ioCount;
+}
+
+uint64_t TraceReplayer::getReplayedCount() const {
+    return m_replayedCount;
+}
+
+uint64_t TraceReplayer::getSkippedCount() const {
+    return m_skippedCount;
+}
+
+uint64_t TraceReplayer::getErrorCount() const {
+    return m_errorCount;
+}
+
+uint64_t TraceReplayer::getRecordedDuration() const {
+    return m_lastTimestamp - m_firstTimestamp;
+}
+
+uint64_t TraceReplayer::getReplayDuration() const {
+    return m_replayDuration;
+}
+
+const std::vector<LatencyHistogram> &TraceReplayer::getRecordedLatencies()
+        const {
+    return m_recorded;
+}
+
+const std::vector<LatencyHistogram> &TraceReplayer::getAchievedLatencies()
+        const {
+    return m_achieved;
+}
+
+const LatencyHistogram &TraceReplayer::getSubmissionDelays() const {
+    return m_delays;
+}
+
+}  // namespace octf
@@ -0,0 +1,183 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEREPLAYER_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEREPLAYER_H
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BatchBroadcaster.h"
+#include "LatencyHistogram.h"
+#include "LatencyStatisticsHandler.h"
+
+namespace octf {
+
+struct ReplayOptions {
+    /** Block device or file IOs are replayed on */
+    std::string targetPath;
+
+    /** Replay speed in percent of the original, 0 - as fast as possible */
+    uint32_t speed;
+
+    /** Added to LBA of every IO, in sectors */
+    uint64_t lbaOffset;
+
+    /** Id of replayed device, 0 - all devices */
+    uint64_t deviceId;
+
+    /** Number of submitting threads, 0 means number of CPUs */
+    uint32_t threadCount;
+
+    /** Maximum number of IOs in flight per thread */
+    uint32_t queueDepth;
+
+    /** Replay writes, they overwrite the target with zeroes */
+    bool writes;
+};
+
+/**
+ * @brief Replays IOs of a trace on a block device or file with io_uring
+ *
+ * IOs are read in timestamp order and handed to submitting threads round
+ * robin in batches. Every thread owns an io_uring and submits its IOs at
+ * their original time relative to the beginning of the trace, scaled by
+ * the replay speed. Latencies achieved by the target are reported next to
+ * the latencies recorded in the trace, together with the delay of every
+ * submission against its due time.
+ *
+ * Addresses are shifted by the LBA offset and wrapped around to fit the
+ * target, sizes are rounded up to its block size as required by direct IO.
+ */
+class TraceReplayer {
+public:
+    /**
+     * @throw Exception when the target cannot be opened
+     */
+    explicit TraceReplayer(const ReplayOptions &options);
+    virtual ~TraceReplayer();
+
+    /**
+     * @brief Replays the trace and waits for all IOs to complete
+     *
+     * @param tracePath Path of the trace in trace repository
+     *
+     * @throw Exception when the trace cannot be read or replay failed
+     */
+    void replay(const std::string &tracePath);
+
+    /**
+     * @return Number of IOs of replayed device in the trace
+     */
+    uint64_t getIoCount() const;
+
+    uint64_t getReplayedCount() const;
+
+    /**
+     * @return Number of IOs not replayed, discards, writes unless enabled,
+     * and IOs larger than supported
+     */
+    uint64_t getSkippedCount() const;
+
+    /**
+     * @return Number of replayed IOs failed or transferred partially
+     */
+    uint64_t getErrorCount() const;
+
+    /**
+     * @return Time between the first and the last IO of the trace in ns
+     */
+    uint64_t getRecordedDuration() const;
+
+    /**
+     * @return Time between the start of replay and the last completion in ns
+     */
+    uint64_t getReplayDuration() const;
+
+    /**
+     * @return Latencies recorded in the trace, indexed by LatencyOperation
+     */
+    const std::vector<LatencyHistogram> &getRecordedLatencies() const;
+
+    /**
+     * @return Latencies achieved by the target, indexed by LatencyOperation
+     */
+    const std::vector<LatencyHistogram> &getAchievedLatencies() const;
+
+    /**
+     * @return Delays of submissions against their due time
+     */
+    const LatencyHistogram &getSubmissionDelays() const;
+
+private:
+    /**
+     * @brief IO to be submitted by a replay thread
+     */
+    struct ReplayIo {
+        /** Due time since the start of replay in ns */
+        uint64_t due;
+        /** In bytes */
+        uint64_t offset;
+        /** In bytes */
+        uint32_t size;
+        LatencyOperation operation;
+    };
+
+    /** IOs of every replay thread */
+    typedef std::vector<std::vector<ReplayIo>> Batch;
+
+    struct WorkerResult {
+        std::vector<LatencyHistogram> latencies;
+        LatencyHistogram delays;
+        uint64_t replayed;
+        uint64_t errors;
+
+        WorkerResult();
+    };
+
+    void start();
+
+    void finish();
+
+    void publish();
+
+    void run(uint32_t worker);
+
+    bool getReplayIo(const proto::trace::EventIo &io,
+                     uint64_t timestamp,
+                     ReplayIo &replayIo);
+
+    uint64_t getTime() const;
+
+    ReplayOptions m_options;
+    int m_fd;
+    uint64_t m_capacity;
+    uint32_t m_blockSize;
+    uint32_t m_threadCount;
+    std::unique_ptr<BatchBroadcaster<Batch>> m_broadcaster;
+    std::vector<std::thread> m_threads;
+    std::vector<std::exception_ptr> m_errors;
+    std::vector<WorkerResult> m_results;
+    std::shared_ptr<Batch> m_batch;
+    uint64_t m_dispatchedCount;
+    uint64_t m_start;
+    uint64_t m_firstTimestamp;
+    uint64_t m_lastTimestamp;
+    uint64_t m_ioCount;
+    uint64_t m_skippedCount;
+    uint64_t m_replayedCount;
+    uint64_t m_errorCount;
+    uint64_t m_replayDuration;
+    std::vector<LatencyHistogram> m_recorded;
+    std::vector<LatencyHistogram> m_achieved;
+    LatencyHistogram m_delays;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEREPLAYER_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceSegmentHandler.h"
+#include <algorithm>
+#include <octf/utils/Log.h>
+#include "MappedTraceReader.h"
+
+namespace octf {
+
+/**
+ * @return Timestamp of the first event of the trace, parsed timestamps are
+ * relative to it
+ */
+static uint64_t getTraceStart(const std::string &tracePath) {
+    MappedTraceReader reader(tracePath);
+    std::shared_ptr<proto::trace::Event> event;
+
+    return reader.read(event) ? event->header().timestamp() : 0;
+}
+
+TraceSegmentHandler::TraceSegmentHandler(const std::string &tracePath,
+                                         ParsedIoTraceEventHandler &target,
+                                         uint64_t timeOffset)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_target(target)
+        , m_timeOffset(timeOffset)
+        , m_endTimestamp(timeOffset)
+        , m_shifted() {}
+
+void TraceSegmentHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    uint64_t timestamp = io.header().timestamp() + m_timeOffset;
+    m_endTimestamp = std::max(m_endTimestamp, timestamp);
+
+    if (!m_timeOffset) {
+        m_target.handleIO(io);
+        return;
+    }
+
+    // Reuse single message to avoid allocations per event
+    m_shifted.CopyFrom(io);
+    m_shifted.mutable_header()->set_timestamp(timestamp);
+    m_target.handleIO(m_shifted);
+}
+
+uint64_t TraceSegmentHandler::getEndTimestamp() const {
+    return m_endTimestamp;
+}
+
+TraceSegmentTimeline::TraceSegmentTimeline(const std::string &tracePath)
+        : m_start(getTraceStart(tracePath))
+        , m_end(0) {}
+
+uint64_t TraceSegmentTimeline::getOffset(
+        const std::string &segmentPath) const {
+    uint64_t segmentStart = getTraceStart(segmentPath);
+    uint64_t timeOffset = segmentStart - std::min(segmentStart, m_start);
+
+    if (timeOffset < m_end) {
+        log::verbose << "Trace segment " << segmentPath
+                     << " starts before the end of the previous one"
+                     << std::endl;
+        timeOffset = m_end;
+    }
+
+    return timeOffset;
+}
+
+void TraceSegmentTimeline::setEnd(uint64_t end) {
+    m_end = end;
+}
+
+void processTraceSegments(ParsedIoTraceEventHandler &handler,
+                          const std::string &tracePath,
+                          const std::vector<std::string> &segments) {
+    if (segments.empty()) {
+        handler.processEvents();
+        return;
+    }
+
+    std::vector<std::string> paths;
+    paths.reserve(segments.size() + 1);
+    paths.push_back(tracePath);
+    paths.insert(paths.end(), segments.begin(), segments.end());
+
+    TraceSegmentTimeline timeline(tracePath);
+
+    for (const auto &path : paths) {
+        TraceSegmentHandler segment(path, handler, timeline.getOffset(path));
+        segment.processEvents();
+        timeline.setEnd(segment.getEndTimestamp());
+    }
+}
+
+}  // namespace octf
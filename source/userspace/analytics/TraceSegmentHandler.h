@@ -0,0 +1,97 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACESEGMENTHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACESEGMENTHANDLER_H
+
+#include <string>
+#include <vector>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+
+namespace octf {
+
+/**
+ * @brief Forwards parsed IOs of a single trace segment to another handler
+ *
+ * Timestamps of the segment start from zero, so they are shifted by the
+ * given offset to keep one time base for the whole range of segments.
+ */
+class TraceSegmentHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace segment
+     * @param target Handler receiving IOs of the segment
+     * @param timeOffset Offset added to timestamps of the segment in ns
+     */
+    TraceSegmentHandler(const std::string &tracePath,
+                        ParsedIoTraceEventHandler &target,
+                        uint64_t timeOffset);
+    virtual ~TraceSegmentHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @return The latest shifted timestamp seen in the segment
+     */
+    uint64_t getEndTimestamp() const;
+
+private:
+    ParsedIoTraceEventHandler &m_target;
+    const uint64_t m_timeOffset;
+    uint64_t m_endTimestamp;
+    proto::trace::ParsedEvent m_shifted;
+};
+
+/**
+ * @brief Places consecutive trace segments on one time base
+ *
+ * Each segment is placed at its start time, the timestamp of its first
+ * event, relative to the start of the first trace, so gaps between segments
+ * are kept. A segment starting before the end of the previous one, e.g.
+ * captured after a reboot, continues right after it.
+ */
+class TraceSegmentTimeline {
+public:
+    /**
+     * @param tracePath Path of the first trace of the range
+     */
+    explicit TraceSegmentTimeline(const std::string &tracePath);
+
+    /**
+     * @param segmentPath Path of the next segment in order of capture
+     *
+     * @return Offset of timestamps of the segment in ns
+     */
+    uint64_t getOffset(const std::string &segmentPath) const;
+
+    /**
+     * @brief Records the end of the segment processed last
+     *
+     * @param end The latest shifted timestamp of the segment
+     */
+    void setEnd(uint64_t end);
+
+private:
+    const uint64_t m_start;
+    uint64_t m_end;
+};
+
+/**
+ * @brief Processes the trace of the handler followed by the given segments
+ *
+ * Segments have to be given in order of capture and are placed on the time
+ * base of the trace by TraceSegmentTimeline.
+ *
+ * @param handler Handler analyzing the range of segments
+ * @param tracePath Path of the trace the handler was created for
+ * @param segments Paths of segments following the trace
+ */
+void processTraceSegments(ParsedIoTraceEventHandler &handler,
+                          const std::string &tracePath,
+                          const std::vector<std::string> &segments);
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACESEGMENTHANDLER_H
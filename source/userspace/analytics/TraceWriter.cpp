@@ -0,0 +1,162 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TraceWriter.h"
+#include <errno.h>
+#include <sys/stat.h>
+#include <sstream>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/util/json_util.h>
+#include <octf/utils/Exception.h>
+#include <octf/utils/FrameworkConfiguration.h>
+
+namespace octf {
+
+static constexpr auto TRACE_FILE_NAME = "octf.trace.0";
+static constexpr auto SUMMARY_FILE_NAME = "octf.summary";
+static constexpr uint32_t MAX_VARINT32_SIZE = 5;
+static constexpr uint64_t NS_PER_SECOND = 1000000000ULL;
+
+static std::string getTraceDir(const std::string &tracePath) {
+    return getFrameworkConfiguration().getTraceRepositoryPath() + "/" +
+           tracePath;
+}
+
+static void createTraceDir(const std::string &dir) {
+    // Create parents, the trace directory itself must not exist yet
+    for (auto pos = dir.find('/', 1); pos != std::string::npos;
+         pos = dir.find('/', pos + 1)) {
+        std::string parent = dir.substr(0, pos);
+        if (mkdir(parent.c_str(), 0755) && errno != EEXIST) {
+            throw Exception("Cannot create directory " + parent);
+        }
+    }
+
+    if (mkdir(dir.c_str(), 0755)) {
+        if (errno == EEXIST) {
+            throw Exception("Trace already exists, " + dir);
+        }
+        throw Exception("Cannot create trace directory " + dir);
+    }
+}
+
+TraceWriter::TraceWriter(const std::string &tracePath)
+        : m_tracePath(tracePath)
+        , m_traceDir(getTraceDir(tracePath))
+        , m_file()
+        , m_block()
+        , m_eventCount(0)
+        , m_size(0)
+        , m_firstTimestamp(0)
+        , m_lastTimestamp(0) {
+    createTraceDir(m_traceDir);
+
+    std::string path = m_traceDir + "/" + TRACE_FILE_NAME;
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.good()) {
+        throw Exception("Cannot create trace file " + path);
+    }
+}
+
+void TraceWriter::write(const proto::trace::Event &event) {
+    m_block.clear();
+    appendEvent(event, m_block);
+
+    uint64_t timestamp = event.header().timestamp();
+    writeBlock(m_block, 1, timestamp, timestamp);
+}
+
+void TraceWriter::writeBlock(const std::string &block,
+                             uint64_t eventCount,
+                             uint64_t firstTimestamp,
+                             uint64_t lastTimestamp) {
+    if (!eventCount) {
+        return;
+    }
+
+    m_file.write(block.data(), block.size());
+    m_size += block.size();
+
+    if (!m_eventCount) {
+        m_firstTimestamp = firstTimestamp;
+    }
+    if (lastTimestamp > m_lastTimestamp) {
+        m_lastTimestamp = lastTimestamp;
+    }
+    m_eventCount += eventCount;
+}
+
+void TraceWriter::appendEvent(const proto::trace::Event &event,
+                              std::string &block) {
+    uint8_t length[MAX_VARINT32_SIZE];
+    uint32_t size = event.ByteSizeLong();
+    uint8_t *end =
+            google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+                    size, length);
+
+    block.append(reinterpret_cast<const char *>(length), end - length);
+
+    // Serialize in place, behind the length
+    size_t offset = block.size();
+    block.resize(offset + size);
+    event.SerializeWithCachedSizesToArray(
+            reinterpret_cast<uint8_t *>(&block[offset]));
+}
+
+void TraceWriter::close(proto::TraceSummary &summary) {
+    m_file.close();
+    if (m_file.fail()) {
+        throw Exception("Cannot write trace file, trace path " + m_tracePath);
+    }
+
+    summary.set_tracepath(m_tracePath);
+    summary.set_state(proto::TracingState::COMPLETE);
+    // Duration is given in seconds, as by the tracer
+    summary.set_traceduration((m_lastTimestamp - m_firstTimestamp) /
+                              NS_PER_SECOND);
+    summary.set_tracesize(m_size);
+    summary.set_tracedevents(m_eventCount);
+    summary.set_queuecount(1);
+
+    std::string json;
+    google::protobuf::util::JsonPrintOptions options;
+    options.add_whitespace = true;
+    google::protobuf::util::MessageToJsonString(summary, &json, options);
+
+    std::string path = m_traceDir + "/" + SUMMARY_FILE_NAME;
+    std::ofstream file(path, std::ios::trunc);
+    file << json;
+    file.close();
+    if (file.fail()) {
+        throw Exception("Cannot write trace summary " + path);
+    }
+}
+
+uint64_t TraceWriter::getEventCount() const {
+    return m_eventCount;
+}
+
+uint64_t TraceWriter::getSize() const {
+    return m_size;
+}
+
+bool TraceWriter::readSummary(const std::string &tracePath,
+                              proto::TraceSummary &summary) {
+    std::ifstream file(getTraceDir(tracePath) + "/" + SUMMARY_FILE_NAME);
+    if (!file.good()) {
+        return false;
+    }
+
+    std::stringstream json;
+    json << file.rdbuf();
+
+    google::protobuf::util::JsonParseOptions options;
+    options.ignore_unknown_fields = true;
+    return google::protobuf::util::JsonStringToMessage(json.str(), &summary,
+                                                       options)
+            .ok();
+}
+
+}  // namespace octf
@@ -0,0 +1,87 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TRACEWRITER_H
+#define SOURCE_USERSPACE_ANALYTICS_TRACEWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <octf/proto/trace.pb.h>
+#include <octf/proto/traceDefinitions.pb.h>
+
+namespace octf {
+
+/**
+ * @brief Writes a new trace into the trace repository
+ *
+ * Events are written into a single queue file, in the same length delimited
+ * format the tracer uses, so the trace can be read by all trace commands.
+ * Events shall be written in timestamp order.
+ */
+class TraceWriter {
+public:
+    /**
+     * @param tracePath Path of the new trace in trace repository
+     *
+     * @throw Exception when the trace already exists or cannot be created
+     */
+    explicit TraceWriter(const std::string &tracePath);
+    virtual ~TraceWriter() = default;
+
+    void write(const proto::trace::Event &event);
+
+    /**
+     * @brief Writes block of events encoded by appendEvent()
+     */
+    void writeBlock(const std::string &block,
+                    uint64_t eventCount,
+                    uint64_t firstTimestamp,
+                    uint64_t lastTimestamp);
+
+    /**
+     * @brief Appends length delimited event to block of events
+     */
+    static void appendEvent(const proto::trace::Event &event,
+                            std::string &block);
+
+    /**
+     * @brief Flushes events and writes summary of the trace
+     *
+     * @param[in,out] summary Summary with the source node, start date, label,
+     * tags and dropped events of the trace. Path, state, duration, size and
+     * traced events are filled in.
+     */
+    void close(proto::TraceSummary &summary);
+
+    uint64_t getEventCount() const;
+
+    /**
+     * @return Number of bytes written into the queue file
+     */
+    uint64_t getSize() const;
+
+    /**
+     * @brief Reads summary of a trace in trace repository
+     *
+     * @retval false Summary is missing or invalid
+     */
+    static bool readSummary(const std::string &tracePath,
+                            proto::TraceSummary &summary);
+
+private:
+    const std::string m_tracePath;
+    const std::string m_traceDir;
+    std::ofstream m_file;
+    std::string m_block;
+    uint64_t m_eventCount;
+    uint64_t m_size;
+    uint64_t m_firstTimestamp;
+    uint64_t m_lastTimestamp;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TRACEWRITER_H
@@ -0,0 +1,128 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "TwoQueueCachePolicy.h"
+#include <algorithm>
+
+namespace octf {
+
+constexpr const char *TwoQueueCachePolicy::NAME;
+
+TwoQueueCachePolicy::TwoQueueCachePolicy(uint64_t capacity, CacheMode mode)
+        : CachePolicy(capacity, mode)
+        , m_kin(std::max<uint64_t>(capacity / 4, 1))
+        , m_kout(std::max<uint64_t>(capacity / 2, 1))
+        , m_table(capacity + m_kout + 1)
+        , m_pool(capacity + m_kout + 1)
+        , m_lists() {}
+
+bool TwoQueueCachePolicy::reference(uint64_t key, bool dirty) {
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        auto &node = m_pool[index];
+
+        switch (node.list) {
+        case AM:
+            m_pool.moveToFront(m_lists[AM], index);
+            node.dirty |= dirty;
+            return true;
+
+        case A1IN:
+            // FIFO queue, position is not updated on hit
+            node.dirty |= dirty;
+            return true;
+
+        default:
+            // Ghost hit - line has been recently evicted from A1in
+            m_pool.remove(m_lists[A1OUT], index);
+            reclaim();
+            node.dirty = dirty;
+            m_pool.pushFront(m_lists[AM], AM, index);
+            return false;
+        }
+    }
+
+    reclaim();
+
+    index = m_pool.allocate(key);
+    m_pool[index].dirty = dirty;
+    m_pool.pushFront(m_lists[A1IN], A1IN, index);
+    m_table.insert(key, index);
+
+    return false;
+}
+
+void TwoQueueCachePolicy::reclaim() {
+    if (m_lists[A1IN].size + m_lists[AM].size < m_capacity) {
+        return;
+    }
+
+    if (m_lists[A1IN].size > m_kin || !m_lists[AM].size) {
+        // Evict from A1in and remember the line in A1out
+        uint32_t victim = m_lists[A1IN].tail;
+        auto &node = m_pool[victim];
+
+        evicted(node.dirty);
+        node.dirty = false;
+        m_pool.remove(m_lists[A1IN], victim);
+        m_pool.pushFront(m_lists[A1OUT], A1OUT, victim);
+
+        if (m_lists[A1OUT].size > m_kout) {
+            drop(m_lists[A1OUT].tail);
+        }
+    } else {
+        uint32_t victim = m_lists[AM].tail;
+
+        evicted(m_pool[victim].dirty);
+        drop(victim);
+    }
+}
+
+void TwoQueueCachePolicy::drop(uint32_t index) {
+    auto &node = m_pool[index];
+
+    m_table.erase(node.key);
+    m_pool.remove(m_lists[node.list], index);
+    m_pool.release(index);
+}
+
+void TwoQueueCachePolicy::invalidate(uint64_t key) {
+    uint32_t index = m_table.find(key);
+
+    if (index != CacheLineTable::INVALID_VALUE) {
+        drop(index);
+    }
+}
+
+uint64_t TwoQueueCachePolicy::getTrackedCount() const {
+    return m_table.size();
+}
+
+void TwoQueueCachePolicy::invalidateTracked(uint64_t first, uint64_t last) {
+    for (auto &list : m_lists) {
+        uint32_t index = list.head;
+
+        while (index != CacheNodePool::NONE) {
+            uint32_t next = m_pool[index].next;
+            uint64_t key = m_pool[index].key;
+
+            if (key >= first && key <= last) {
+                drop(index);
+            }
+            index = next;
+        }
+    }
+}
+
+const char *TwoQueueCachePolicy::getName() const {
+    return NAME;
+}
+
+uint64_t TwoQueueCachePolicy::getMemoryUsage() const {
+    return m_table.getMemoryUsage() + m_pool.getMemoryUsage();
+}
+
+}  // namespace octf
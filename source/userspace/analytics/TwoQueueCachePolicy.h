@@ -0,0 +1,61 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_TWOQUEUECACHEPOLICY_H
+#define SOURCE_USERSPACE_ANALYTICS_TWOQUEUECACHEPOLICY_H
+
+#include "CachePolicy.h"
+
+namespace octf {
+
+/**
+ * @brief 2Q eviction policy (full version, by T. Johnson and D. Shasha)
+ *
+ * New lines enter FIFO queue A1in (25% of capacity). Lines evicted from A1in
+ * are remembered in ghost queue A1out (keys only, 50% of capacity). Lines
+ * referenced again while in A1out are promoted to LRU queue Am.
+ */
+class TwoQueueCachePolicy : public CachePolicy {
+public:
+    static constexpr const char *NAME = "2q";
+
+    TwoQueueCachePolicy(uint64_t capacity, CacheMode mode);
+    virtual ~TwoQueueCachePolicy() = default;
+
+    void invalidate(uint64_t key) override;
+
+    const char *getName() const override;
+
+    uint64_t getMemoryUsage() const override;
+
+protected:
+    bool reference(uint64_t key, bool dirty) override;
+
+    uint64_t getTrackedCount() const override;
+
+    void invalidateTracked(uint64_t first, uint64_t last) override;
+
+private:
+    enum ListId : uint8_t {
+        A1IN = 0,
+        AM,
+        A1OUT,
+        LIST_COUNT,
+    };
+
+    void reclaim();
+
+    void drop(uint32_t index);
+
+    const uint64_t m_kin;
+    const uint64_t m_kout;
+    CacheLineTable m_table;
+    CacheNodePool m_pool;
+    CacheNodePool::List m_lists[LIST_COUNT];
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_TWOQUEUECACHEPOLICY_H
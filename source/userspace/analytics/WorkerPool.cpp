@@ -0,0 +1,69 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "WorkerPool.h"
+
+namespace octf {
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+        : m_threads()
+        , m_tasks()
+        , m_mutex()
+        , m_cv()
+        , m_stopped(false) {
+    threadCount = resolveThreadCount(threadCount);
+
+    for (uint32_t i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_cv.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+uint32_t WorkerPool::getThreadCount() const {
+    return m_threads.size();
+}
+
+uint32_t WorkerPool::resolveThreadCount(uint32_t threadCount) {
+    if (threadCount) {
+        return threadCount;
+    }
+
+    threadCount = std::thread::hardware_concurrency();
+    return threadCount ? threadCount : 1;
+}
+
+void WorkerPool::run() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopped || !m_tasks.empty(); });
+
+            if (m_tasks.empty()) {
+                // Stopped and nothing left to do
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
+
+}  // namespace octf
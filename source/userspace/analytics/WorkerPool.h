@@ -0,0 +1,91 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_WORKERPOOL_H
+#define SOURCE_USERSPACE_ANALYTICS_WORKERPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace octf {
+
+/**
+ * @brief Fixed size pool of worker threads executing submitted tasks
+ *
+ * Tasks are executed in FIFO order, the result of each task is delivered by
+ * std::future returned from submit().
+ */
+class WorkerPool {
+public:
+    /**
+     * @param threadCount Number of worker threads, 0 means number of
+     * available CPUs
+     */
+    explicit WorkerPool(uint32_t threadCount);
+
+    /**
+     * @note Waits until all already submitted tasks are finished
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * @brief Submits task for execution
+     *
+     * @param task Callable object without arguments
+     *
+     * @return Future of the task's result
+     */
+    template <typename Task>
+    std::future<typename std::result_of<Task()>::type> submit(Task task) {
+        typedef typename std::result_of<Task()>::type Result;
+
+        auto packaged =
+                std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packaged->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push([packaged]() { (*packaged)(); });
+        }
+        m_cv.notify_one();
+
+        return result;
+    }
+
+    /**
+     * @return Number of worker threads in this pool
+     */
+    uint32_t getThreadCount() const;
+
+    /**
+     * @brief Resolves requested number of threads, 0 means number of
+     * available CPUs
+     */
+    static uint32_t resolveThreadCount(uint32_t threadCount);
+
+private:
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopped;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_WORKERPOOL_H
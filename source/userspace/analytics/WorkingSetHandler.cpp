@@ -0,0 +1,138 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "WorkingSetHandler.h"
+#include <octf/utils/Exception.h>
+#include "CacheLineTable.h"
+
+namespace octf {
+
+static constexpr uint64_t SECTOR_SIZE = 512;
+
+/** Lines of different devices are told apart by device index in high bits */
+static constexpr uint64_t DEVICE_INDEX_SHIFT = 48;
+
+WorkingSetHandler::WorkingSetHandler(const std::string &tracePath,
+                                     uint64_t cacheLineSize,
+                                     const std::vector<uint64_t> &windows,
+                                     uint32_t devicePrecision,
+                                     uint32_t filePrecision,
+                                     uint32_t fileCount)
+        : ParsedIoTraceEventHandler(tracePath)
+        , m_lineSectors(cacheLineSize / SECTOR_SIZE)
+        , m_devicePrecision(devicePrecision)
+        , m_windows()
+        , m_footprints()
+        , m_deviceIndexes()
+        , m_deviceNames()
+        , m_hashes()
+        , m_firstTimestamp(0)
+        , m_started(false) {
+    if (!m_lineSectors || cacheLineSize % SECTOR_SIZE) {
+        throw Exception("Invalid cache line size");
+    }
+
+    for (auto duration : windows) {
+        m_windows.emplace_back(duration, devicePrecision, filePrecision,
+                               fileCount);
+    }
+}
+
+void WorkingSetHandler::handleIO(const proto::trace::ParsedEvent &io) {
+    const auto &pbIo = io.io();
+    bool write;
+
+    if (pbIo.error() || !pbIo.len()) {
+        return;
+    }
+
+    switch (pbIo.operation()) {
+    case proto::trace::IoType::Read:
+        write = false;
+        break;
+    case proto::trace::IoType::Write:
+        write = true;
+        break;
+    default:
+        // Discards do not reference data
+        return;
+    }
+
+    uint64_t timestamp = io.header().timestamp();
+    if (!m_started) {
+        m_firstTimestamp = timestamp;
+        m_started = true;
+    }
+    // Events are ordered by queue time only roughly, clamp early ones
+    uint64_t time =
+            timestamp > m_firstTimestamp ? timestamp - m_firstTimestamp : 0;
+
+    uint64_t deviceId = io.device().id();
+    uint64_t deviceKey = getDeviceIndex(io) << DEVICE_INDEX_SHIFT;
+    uint64_t first = pbIo.lba() / m_lineSectors;
+    uint64_t last = (pbIo.lba() + pbIo.len() - 1) / m_lineSectors;
+
+    m_hashes.clear();
+    for (uint64_t line = first; line <= last; line++) {
+        uint64_t key = deviceKey | (line & ((1ULL << DEVICE_INDEX_SHIFT) - 1));
+        m_hashes.push_back(hashMix64(key));
+    }
+
+    auto &footprint = m_footprints[deviceId];
+    if (!footprint) {
+        footprint.reset(new WorkingSetSketch(m_devicePrecision));
+    }
+    for (auto hash : m_hashes) {
+        footprint->add(write, hash);
+    }
+
+    for (auto &window : m_windows) {
+        window.account(time, deviceId, io.file().id(), io.file().path(), write,
+                       m_hashes);
+    }
+}
+
+void WorkingSetHandler::finish() {
+    for (auto &window : m_windows) {
+        window.finish();
+    }
+}
+
+const std::vector<WorkingSetWindow> &WorkingSetHandler::getWindows() const {
+    return m_windows;
+}
+
+std::map<uint64_t, WorkingSetSize> WorkingSetHandler::getFootprints() const {
+    std::map<uint64_t, WorkingSetSize> footprints;
+
+    for (const auto &footprint : m_footprints) {
+        footprints[footprint.first] = footprint.second->estimate();
+    }
+
+    return footprints;
+}
+
+const std::map<uint64_t, std::string> &WorkingSetHandler::getDeviceNames()
+        const {
+    return m_deviceNames;
+}
+
+uint64_t WorkingSetHandler::getDeviceIndex(
+        const proto::trace::ParsedEvent &io) {
+    uint64_t deviceId = io.device().id();
+    auto index = m_deviceIndexes.find(deviceId);
+
+    if (index == m_deviceIndexes.end()) {
+        index = m_deviceIndexes
+                        .insert(std::make_pair(deviceId,
+                                               m_deviceIndexes.size()))
+                        .first;
+        m_deviceNames[deviceId] = io.device().name();
+    }
+
+    return index->second;
+}
+
+}  // namespace octf
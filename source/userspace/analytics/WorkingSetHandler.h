@@ -0,0 +1,74 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_WORKINGSETHANDLER_H
+#define SOURCE_USERSPACE_ANALYTICS_WORKINGSETHANDLER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <octf/trace/parser/ParsedIoTraceEventHandler.h>
+#include "WorkingSetWindow.h"
+
+namespace octf {
+
+/**
+ * @brief Parsed IO handler estimating working set sizes
+ *
+ * Besides windowed working sets, the unique footprint of the whole trace is
+ * estimated for every device.
+ */
+class WorkingSetHandler : public ParsedIoTraceEventHandler {
+public:
+    /**
+     * @param tracePath Path of the trace to be analyzed
+     * @param cacheLineSize Cache line size in bytes
+     * @param windows Window durations in nanoseconds
+     * @param devicePrecision Precision of device sketches
+     * @param filePrecision Precision of file sketches
+     * @param fileCount Maximum number of files tracked per window
+     */
+    WorkingSetHandler(const std::string &tracePath,
+                      uint64_t cacheLineSize,
+                      const std::vector<uint64_t> &windows,
+                      uint32_t devicePrecision,
+                      uint32_t filePrecision,
+                      uint32_t fileCount);
+    virtual ~WorkingSetHandler() = default;
+
+    void handleIO(const proto::trace::ParsedEvent &io) override;
+
+    /**
+     * @brief Closes last intervals of all windows, call after processing
+     */
+    void finish();
+
+    const std::vector<WorkingSetWindow> &getWindows() const;
+
+    /**
+     * @return Unique footprint of whole trace by device id
+     */
+    std::map<uint64_t, WorkingSetSize> getFootprints() const;
+
+    const std::map<uint64_t, std::string> &getDeviceNames() const;
+
+private:
+    uint64_t getDeviceIndex(const proto::trace::ParsedEvent &io);
+
+    const uint64_t m_lineSectors;
+    const uint32_t m_devicePrecision;
+    std::vector<WorkingSetWindow> m_windows;
+    std::map<uint64_t, std::unique_ptr<WorkingSetSketch>> m_footprints;
+    std::map<uint64_t, uint64_t> m_deviceIndexes;
+    std::map<uint64_t, std::string> m_deviceNames;
+    std::vector<uint64_t> m_hashes;
+    uint64_t m_firstTimestamp;
+    bool m_started;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_WORKINGSETHANDLER_H
@@ -0,0 +1,185 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "WorkingSetWindow.h"
+#include <algorithm>
+#include <octf/utils/Exception.h>
+
+namespace octf {
+
+void WorkingSetSize::updatePeak(const WorkingSetSize &other) {
+    read = std::max(read, other.read);
+    write = std::max(write, other.write);
+    total = std::max(total, other.total);
+}
+
+WorkingSetSketch::WorkingSetSketch(uint32_t precision)
+        : m_read(precision)
+        , m_write(precision) {}
+
+WorkingSetSize WorkingSetSketch::estimate() const {
+    WorkingSetSize size;
+    HyperLogLog all(m_read);
+
+    all.merge(m_write);
+
+    size.read = m_read.estimate();
+    size.write = m_write.estimate();
+    size.total = all.estimate();
+
+    return size;
+}
+
+void WorkingSetSketch::clear() {
+    m_read.clear();
+    m_write.clear();
+}
+
+uint64_t WorkingSetSketch::getMemoryUsage() const {
+    return m_read.getMemoryUsage() + m_write.getMemoryUsage();
+}
+
+WorkingSetWindow::WorkingSetWindow(uint64_t duration,
+                                   uint32_t devicePrecision,
+                                   uint32_t filePrecision,
+                                   uint32_t fileCount)
+        : m_duration(duration)
+        , m_devicePrecision(devicePrecision)
+        , m_filePrecision(filePrecision)
+        , m_fileCount(fileCount)
+        , m_start(0)
+        , m_active(false)
+        , m_deviceSketches()
+        , m_fileSketches()
+        , m_devices()
+        , m_files()
+        , m_order() {
+    if (!m_duration) {
+        throw Exception("Invalid working set window duration");
+    }
+}
+
+void WorkingSetWindow::account(uint64_t time,
+                               uint64_t deviceId,
+                               uint64_t fileId,
+                               const std::string &filePath,
+                               bool write,
+                               const std::vector<uint64_t> &hashes) {
+    if (m_active && time >= m_start + m_duration) {
+        closeInterval();
+    }
+
+    if (!m_active) {
+        // Skip idle intervals, windows are aligned to the trace beginning
+        m_start = time - time % m_duration;
+        m_active = true;
+    }
+
+    auto &device = m_deviceSketches[deviceId];
+    if (!device) {
+        device.reset(new WorkingSetSketch(m_devicePrecision));
+    }
+
+    for (auto hash : hashes) {
+        device->add(write, hash);
+    }
+
+    if (fileId && m_fileCount) {
+        auto &file = getFileSketch(FileKey(deviceId, fileId), filePath,
+                                   hashes.size());
+
+        for (auto hash : hashes) {
+            file.add(write, hash);
+        }
+    }
+}
+
+void WorkingSetWindow::finish() {
+    if (m_active) {
+        closeInterval();
+    }
+}
+
+uint64_t WorkingSetWindow::getDuration() const {
+    return m_duration;
+}
+
+const std::map<uint64_t, DeviceWorkingSet> &WorkingSetWindow::getDevices()
+        const {
+    return m_devices;
+}
+
+const std::map<WorkingSetWindow::FileKey, FileWorkingSet>
+        &WorkingSetWindow::getFiles() const {
+    return m_files;
+}
+
+void WorkingSetWindow::closeInterval() {
+    for (auto &sketch : m_deviceSketches) {
+        WorkingSetInterval interval;
+        interval.start = m_start;
+        interval.size = sketch.second->estimate();
+
+        // Device sketches are few, keep them for the next interval
+        sketch.second->clear();
+
+        if (!interval.size.total) {
+            continue;
+        }
+
+        auto &device = m_devices[sketch.first];
+        device.intervals.push_back(interval);
+        device.peak.updatePeak(interval.size);
+    }
+
+    for (const auto &sketch : m_fileSketches) {
+        auto &file = m_files.at(sketch.first);
+
+        file.peak.updatePeak(sketch.second->estimate());
+        file.activeIntervals++;
+    }
+    m_fileSketches.clear();
+
+    m_active = false;
+}
+
+WorkingSetSketch &WorkingSetWindow::getFileSketch(const FileKey &key,
+                                                  const std::string &path,
+                                                  uint64_t lines) {
+    uint64_t rank = 0;
+
+    auto iter = m_files.find(key);
+    if (iter == m_files.end()) {
+        if (m_files.size() >= m_fileCount) {
+            // Replace the least accessed file, inheriting its rank
+            auto victim = m_order.begin();
+            rank = victim->first;
+            m_files.erase(victim->second);
+            m_fileSketches.erase(victim->second);
+            m_order.erase(victim);
+        }
+
+        iter = m_files.emplace(key, FileWorkingSet()).first;
+        iter->second.rank = rank;
+    } else {
+        m_order.erase(std::make_pair(iter->second.rank, key));
+    }
+
+    auto &file = iter->second;
+    file.rank += lines;
+    if (file.path.empty()) {
+        file.path = path;
+    }
+    m_order.emplace(file.rank, key);
+
+    auto &sketch = m_fileSketches[key];
+    if (!sketch) {
+        sketch.reset(new WorkingSetSketch(m_filePrecision));
+    }
+
+    return *sketch;
+}
+
+}  // namespace octf
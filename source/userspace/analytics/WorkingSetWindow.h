@@ -0,0 +1,170 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_ANALYTICS_WORKINGSETWINDOW_H
+#define SOURCE_USERSPACE_ANALYTICS_WORKINGSETWINDOW_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "HyperLogLog.h"
+
+namespace octf {
+
+/**
+ * @brief Number of distinct cache lines read, written and accessed at all
+ */
+struct WorkingSetSize {
+    uint64_t read;
+    uint64_t write;
+    uint64_t total;
+
+    WorkingSetSize()
+            : read(0)
+            , write(0)
+            , total(0) {}
+
+    void updatePeak(const WorkingSetSize &other);
+};
+
+/**
+ * @brief Pair of read and write sketches
+ */
+class WorkingSetSketch {
+public:
+    explicit WorkingSetSketch(uint32_t precision);
+
+    void add(bool write, uint64_t hash) {
+        (write ? m_write : m_read).add(hash);
+    }
+
+    WorkingSetSize estimate() const;
+
+    void clear();
+
+    uint64_t getMemoryUsage() const;
+
+private:
+    HyperLogLog m_read;
+    HyperLogLog m_write;
+};
+
+struct WorkingSetInterval {
+    /** Interval start in nanoseconds since the beginning of the trace */
+    uint64_t start;
+    WorkingSetSize size;
+};
+
+struct DeviceWorkingSet {
+    std::vector<WorkingSetInterval> intervals;
+    WorkingSetSize peak;
+};
+
+struct FileWorkingSet {
+    std::string path;
+    WorkingSetSize peak;
+    uint64_t activeIntervals;
+
+    /** Space-saving estimate of the number of cache lines accessed */
+    uint64_t rank;
+
+    FileWorkingSet()
+            : path()
+            , peak()
+            , activeIntervals(0)
+            , rank(0) {}
+};
+
+/**
+ * @brief Working set estimation over tumbling time windows of fixed duration
+ *
+ * Distinct cache lines accessed within each window are counted with
+ * HyperLogLog sketches. Device working sets are reported per interval.
+ * Files are numerous, so only the peak working set and the number of
+ * intervals in which the file was accessed are kept for them, and only for
+ * a fixed number of files with the most accessed cache lines, selected with
+ * the space-saving algorithm. File which replaces the least accessed one
+ * inherits its rank, its statistics start from scratch. File sketches exist
+ * only while a tracked file is accessed in the current interval, hence
+ * memory usage is bounded by the number of tracked files.
+ */
+class WorkingSetWindow {
+public:
+    /** Device id and file id */
+    typedef std::pair<uint64_t, uint64_t> FileKey;
+
+    /**
+     * @param duration Window duration in nanoseconds
+     * @param devicePrecision Precision of device sketches
+     * @param filePrecision Precision of file sketches
+     * @param fileCount Maximum number of tracked files
+     */
+    WorkingSetWindow(uint64_t duration,
+                     uint32_t devicePrecision,
+                     uint32_t filePrecision,
+                     uint32_t fileCount);
+
+    /**
+     * @brief Accounts cache lines accessed by single IO
+     *
+     * @param time IO time in nanoseconds since the beginning of the trace
+     * @param deviceId Device id
+     * @param fileId File id, 0 if IO does not belong to any file
+     * @param filePath File path, may be empty
+     * @param write Write IO
+     * @param hashes Hashes of accessed cache lines
+     */
+    void account(uint64_t time,
+                 uint64_t deviceId,
+                 uint64_t fileId,
+                 const std::string &filePath,
+                 bool write,
+                 const std::vector<uint64_t> &hashes);
+
+    /**
+     * @brief Closes the last interval
+     */
+    void finish();
+
+    uint64_t getDuration() const;
+
+    const std::map<uint64_t, DeviceWorkingSet> &getDevices() const;
+
+    const std::map<FileKey, FileWorkingSet> &getFiles() const;
+
+private:
+    void closeInterval();
+
+    /**
+     * @return Sketch of the file in the current interval
+     */
+    WorkingSetSketch &getFileSketch(const FileKey &key,
+                                    const std::string &path,
+                                    uint64_t lines);
+
+    typedef std::unique_ptr<WorkingSetSketch> SketchPtr;
+
+    const uint64_t m_duration;
+    const uint32_t m_devicePrecision;
+    const uint32_t m_filePrecision;
+    const uint32_t m_fileCount;
+    uint64_t m_start;
+    bool m_active;
+    std::map<uint64_t, SketchPtr> m_deviceSketches;
+    std::map<FileKey, SketchPtr> m_fileSketches;
+    std::map<uint64_t, DeviceWorkingSet> m_devices;
+    std::map<FileKey, FileWorkingSet> m_files;
+
+    /** Tracked files ordered by (rank, key) */
+    std::set<std::pair<uint64_t, FileKey>> m_order;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_ANALYTICS_WORKINGSETWINDOW_H
@@ -0,0 +1,251 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "KernelTraceConsumer.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <chrono>
+#include "KernelTraceError.h"
+
+namespace octf {
+
+constexpr uint64_t KernelTraceConsumer::MIN_BATCH_SIZE;
+
+KernelTraceConsumer::Worker::Worker(uint32_t cpu)
+        : ring(new KernelTraceRing(cpu, 0))
+        , thread()
+        , error()
+        , events(0)
+        , batches(0)
+        , backpressure(0) {}
+
+KernelTraceConsumer::KernelTraceConsumer(KernelTraceHandler &handler,
+                                         uint64_t maxBatchSize,
+                                         uint32_t pollInterval)
+        : m_handler(handler)
+        , m_maxBatchSize(maxBatchSize)
+        , m_pollInterval(pollInterval)
+        , m_workers()
+        , m_ticker()
+        , m_mutex()
+        , m_cv()
+        , m_stopped(false)
+        , m_finished(false) {
+    if (maxBatchSize && maxBatchSize < MIN_BATCH_SIZE) {
+        throw KernelTraceError("Batch size has to be at least " +
+                               std::to_string(MIN_BATCH_SIZE) + " bytes");
+    }
+
+    if (!pollInterval) {
+        throw KernelTraceError("Invalid poll interval");
+    }
+}
+
+KernelTraceConsumer::~KernelTraceConsumer() {
+    join();
+}
+
+void KernelTraceConsumer::start() {
+    if (!m_workers.empty()) {
+        throw KernelTraceError("Trace consumer already started");
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    uint32_t cpuCount = std::thread::hardware_concurrency();
+    for (uint32_t cpu = 0; cpu < cpuCount; cpu++) {
+        workers.emplace_back(new Worker(cpu));
+    }
+
+    m_stopped = false;
+    m_finished = false;
+    m_workers = std::move(workers);
+
+    for (auto &worker : m_workers) {
+        worker->thread = std::thread(&KernelTraceConsumer::run, this,
+                                     std::ref(*worker));
+    }
+    m_ticker = std::thread(&KernelTraceConsumer::tick, this);
+}
+
+void KernelTraceConsumer::stop() {
+    join();
+
+    for (const auto &worker : m_workers) {
+        if (worker->error) {
+            std::rethrow_exception(worker->error);
+        }
+    }
+}
+
+void KernelTraceConsumer::join() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_cv.notify_all();
+
+    for (auto &worker : m_workers) {
+        worker->ring->interrupt();
+    }
+
+    // Ticker keeps interrupting waits started after the interrupt above
+    for (auto &worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished = true;
+    }
+    m_cv.notify_all();
+
+    if (m_ticker.joinable()) {
+        m_ticker.join();
+    }
+}
+
+void KernelTraceConsumer::tick() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_finished) {
+        m_cv.wait_for(lock, std::chrono::milliseconds(m_pollInterval),
+                      [this]() { return m_finished; });
+
+        for (auto &worker : m_workers) {
+            worker->ring->interrupt();
+        }
+    }
+}
+
+void KernelTraceConsumer::run(Worker &worker) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(worker.ring->getCpu(), &cpus);
+
+    // Best effort, the CPU may be offline
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+    try {
+        for (;;) {
+            // Read before consuming, so the last pass hands over all events
+            // committed before the stop
+            bool stopped = m_stopped;
+            bool backpressure;
+
+            if (consume(worker, backpressure)) {
+                continue;
+            }
+
+            if (stopped) {
+                break;
+            }
+
+            if (backpressure) {
+                // Ring may be almost full, waiting for kernel would not block
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_for(lock, std::chrono::milliseconds(m_pollInterval),
+                              [this]() { return m_stopped.load(); });
+            } else {
+                worker.ring->wait();
+            }
+        }
+    } catch (...) {
+        worker.error = std::current_exception();
+    }
+}
+
+bool KernelTraceConsumer::consume(Worker &worker, bool &backpressure) {
+    const char *span;
+    uint64_t size;
+    bool wrapped = worker.ring->getCommittedSpan(span, size);
+
+    backpressure = false;
+    if (!size) {
+        return false;
+    }
+
+    if (m_maxBatchSize && size > m_maxBatchSize) {
+        size = m_maxBatchSize;
+        wrapped = false;
+    }
+
+    KernelEventIterator iterator(span, size);
+    uint64_t eventCount = 0;
+    while (iterator.next()) {
+        eventCount++;
+    }
+
+    uint64_t whole = iterator.getOffset();
+    if (!whole) {
+        if (wrapped) {
+            // Only padding left at the end of ring
+            worker.ring->consume(size);
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t handled =
+            m_handler.handleEvents(worker.ring->getCpu(), span, whole);
+    if (handled > whole) {
+        throw KernelTraceError(
+                "Handler claims more events than handed over");
+    }
+
+    if (handled < whole) {
+        backpressure = true;
+        worker.backpressure++;
+
+        KernelEventIterator partial(span, handled);
+        eventCount = 0;
+        while (partial.next()) {
+            eventCount++;
+        }
+        handled = partial.getOffset();
+    } else if (wrapped) {
+        // Skip padding, next batch starts at the beginning of ring
+        handled = size;
+    }
+
+    if (handled) {
+        worker.ring->consume(handled);
+        worker.events += eventCount;
+        worker.batches++;
+    }
+
+    return !backpressure;
+}
+
+uint64_t KernelTraceConsumer::getEventCount() const {
+    uint64_t count = 0;
+    for (const auto &worker : m_workers) {
+        count += worker->events;
+    }
+
+    return count;
+}
+
+uint64_t KernelTraceConsumer::getBatchCount() const {
+    uint64_t count = 0;
+    for (const auto &worker : m_workers) {
+        count += worker->batches;
+    }
+
+    return count;
+}
+
+uint64_t KernelTraceConsumer::getBackpressureCount() const {
+    uint64_t count = 0;
+    for (const auto &worker : m_workers) {
+        count += worker->backpressure;
+    }
+
+    return count;
+}
+
+}  // namespace octf
@@ -0,0 +1,130 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_CONSUMER_KERNELTRACECONSUMER_H
+#define SOURCE_USERSPACE_CONSUMER_KERNELTRACECONSUMER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "KernelTraceHandler.h"
+#include "KernelTraceRing.h"
+
+namespace octf {
+
+/**
+ * @brief Consumes kernel trace rings of all CPUs in process, handing raw
+ * events over to a handler
+ *
+ * Every ring is consumed by its own thread pinned to the CPU of the ring.
+ * Committed events are passed to the handler in batches, in place and
+ * without conversion, so traced events can be fed into custom analytics
+ * without the trace file and without protobuf.
+ *
+ * Kernel wakes consumers only when a ring is almost full, so waits are also
+ * interrupted every poll interval, which bounds the time an event stays in
+ * the ring. The handler applies backpressure by handling only a part of a
+ * batch, the rest is handed over again after the poll interval.
+ *
+ * Devices are traced with the kernel module as usual, e.g. through its
+ * procfs files. Rings have to have a single consumer, so the consumer
+ * cannot run together with trace capture of iotrace.
+ */
+class KernelTraceConsumer {
+public:
+    /**
+     * @param handler Handler of consumed events, it has to outlive the
+     * consumer
+     * @param maxBatchSize Maximum size of a batch in bytes, 0 - unlimited
+     * @param pollInterval Poll interval in ms
+     */
+    KernelTraceConsumer(KernelTraceHandler &handler,
+                        uint64_t maxBatchSize,
+                        uint32_t pollInterval);
+
+    /**
+     * @note Stops consumption, errors of the handler are dropped
+     */
+    virtual ~KernelTraceConsumer();
+
+    KernelTraceConsumer(const KernelTraceConsumer &) = delete;
+    KernelTraceConsumer &operator=(const KernelTraceConsumer &) = delete;
+
+    /**
+     * @brief Maps the rings of all CPUs and starts consuming them
+     *
+     * @throw KernelTraceError when rings cannot be mapped, e.g. the kernel
+     * module is not loaded
+     */
+    void start();
+
+    /**
+     * @brief Hands over events remaining in rings and stops consuming
+     *
+     * @throw KernelTraceError or error of the handler, rethrown from the
+     * first failed consumer thread
+     */
+    void stop();
+
+    uint64_t getEventCount() const;
+
+    uint64_t getBatchCount() const;
+
+    /**
+     * @return Number of times the handler did not handle a whole batch
+     */
+    uint64_t getBackpressureCount() const;
+
+private:
+    struct Worker {
+        std::unique_ptr<KernelTraceRing> ring;
+        std::thread thread;
+        std::exception_ptr error;
+        std::atomic<uint64_t> events;
+        std::atomic<uint64_t> batches;
+        std::atomic<uint64_t> backpressure;
+
+        explicit Worker(uint32_t cpu);
+    };
+
+    void run(Worker &worker);
+
+    /**
+     * @brief Consumes one batch of committed events
+     *
+     * @param worker Worker of the ring
+     * @param[out] backpressure Handler did not handle the whole batch
+     *
+     * @retval true Batch handled entirely, more events may follow
+     * @retval false No events to be handled now
+     */
+    bool consume(Worker &worker, bool &backpressure);
+
+    void tick();
+
+    void join();
+
+    static constexpr uint64_t MIN_BATCH_SIZE = 4096;
+
+    KernelTraceHandler &m_handler;
+    const uint64_t m_maxBatchSize;
+    const uint32_t m_pollInterval;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::thread m_ticker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<bool> m_stopped;
+    /** Ticker stops after all workers, guarded by m_mutex */
+    bool m_finished;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_CONSUMER_KERNELTRACECONSUMER_H
@@ -0,0 +1,29 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_CONSUMER_KERNELTRACEERROR_H
+#define SOURCE_USERSPACE_CONSUMER_KERNELTRACEERROR_H
+
+#include <stdexcept>
+#include <string>
+
+namespace octf {
+
+/**
+ * @brief Error of kernel trace consumption
+ *
+ * The consumer library does not link the framework, so it reports errors
+ * with its own exception type.
+ */
+class KernelTraceError : public std::runtime_error {
+public:
+    explicit KernelTraceError(const std::string &message)
+            : std::runtime_error(message) {}
+    virtual ~KernelTraceError() = default;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_CONSUMER_KERNELTRACEERROR_H
@@ -0,0 +1,102 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_CONSUMER_KERNELTRACEHANDLER_H
+#define SOURCE_USERSPACE_CONSUMER_KERNELTRACEHANDLER_H
+
+#include <cstdint>
+#include <octf/trace/iotrace_event.h>
+
+namespace octf {
+
+/**
+ * @brief Receives raw events consumed from kernel trace rings
+ *
+ * Events are handed over in place, as a span of whole iotrace_event records
+ * in the ring buffer, with no copy and no conversion. The span is valid
+ * only until handleEvents() returns, handled events are then released to
+ * kernel.
+ */
+class KernelTraceHandler {
+public:
+    virtual ~KernelTraceHandler() = default;
+
+    /**
+     * @brief Handles a batch of events committed on a CPU
+     *
+     * Called on the thread consuming the ring of the CPU, batches of one
+     * CPU are handled in order and never concurrently.
+     *
+     * @param cpu CPU the events were traced on
+     * @param events First event of the batch
+     * @param size Size of the batch in bytes
+     *
+     * @return Number of handled bytes from the beginning of the batch, at an
+     * event boundary. Events not handled stay in the ring and are handed
+     * over again after the poll interval, meanwhile kernel drops new events
+     * of the CPU when its ring is full.
+     */
+    virtual uint64_t handleEvents(uint32_t cpu,
+                                  const char *events,
+                                  uint64_t size) = 0;
+};
+
+/**
+ * @brief Iterates over raw events of a batch
+ */
+class KernelEventIterator {
+public:
+    KernelEventIterator(const char *events, uint64_t size)
+            : m_events(events)
+            , m_size(size)
+            , m_offset(0) {}
+
+    /**
+     * @return Header of the next event, nullptr at the end of the batch
+     */
+    const struct iotrace_event_hdr *next() {
+        if (m_size - m_offset < sizeof(struct iotrace_event_hdr)) {
+            return nullptr;
+        }
+
+        const auto *hdr = reinterpret_cast<const struct iotrace_event_hdr *>(
+                m_events + m_offset);
+        if (hdr->size < sizeof(*hdr) || hdr->size > m_size - m_offset) {
+            // Padding at the end of ring, or event not in this batch
+            return nullptr;
+        }
+
+        m_offset += hdr->size;
+        return hdr;
+    }
+
+    /**
+     * @return Offset of the event following the last returned one
+     */
+    uint64_t getOffset() const {
+        return m_offset;
+    }
+
+    /**
+     * @return Event of given type, nullptr when the event is too short
+     */
+    template <typename T>
+    static const T *get(const struct iotrace_event_hdr *hdr) {
+        if (hdr->size < sizeof(T)) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const T *>(hdr);
+    }
+
+private:
+    const char *m_events;
+    uint64_t m_size;
+    uint64_t m_offset;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_CONSUMER_KERNELTRACEHANDLER_H
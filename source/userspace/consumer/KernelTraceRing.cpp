@@ -0,0 +1,138 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include "KernelTraceRing.h"
+
+#include <fcntl.h>
+#include <procfs_files.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "KernelTraceError.h"
+
+namespace octf {
+
+KernelTraceRing::MappedFile::MappedFile(std::string path,
+                                        int open_flags,
+                                        int map_prot,
+                                        uint64_t max_size) {
+    struct stat st;
+
+    // Open file
+    this->fd = open(path.c_str(), open_flags, 0);
+    if (this->fd == -1) {
+        throw KernelTraceError("Failed to open trace file: " + path);
+    }
+
+    // Verify size *after* openning - just to make sure noone changed it in the
+    // meantime.
+    if (fstat(this->fd, &st) != 0) {
+        close(this->fd);
+        throw KernelTraceError("Could not stat file: " + path);
+    }
+    if (st.st_size < 0 || static_cast<uint64_t>(st.st_size) > max_size) {
+        close(this->fd);
+        throw KernelTraceError("Unexpected kernel buffer size");
+    }
+    this->length = st.st_size;
+
+    // Map file
+    this->buffer = static_cast<char *>(
+            mmap(0, st.st_size, map_prot, MAP_SHARED, this->fd, 0));
+    if (this->buffer == MAP_FAILED || this->buffer == NULL) {
+        close(this->fd);
+        throw KernelTraceError("Failed to map trace file: " + path);
+    }
+}
+
+KernelTraceRing::MappedFile::~MappedFile() {
+    munmap(this->buffer, this->length);
+    close(this->fd);
+}
+
+KernelTraceRing::KernelTraceRing(uint32_t cpu, uint64_t memoryPoolSize)
+        : m_cpu(cpu)
+        , m_ring()
+        , m_consumerHdr() {
+    std::string ring_file_path = std::string{IOTRACE_PROCFS_DIR} + "/" +
+                                 IOTRACE_PROCFS_TRACE_FILE_PREFIX +
+                                 std::to_string(cpu);
+    std::string consumer_hdr_file_path =
+            std::string{IOTRACE_PROCFS_DIR} + "/" +
+            IOTRACE_PROCFS_CONSUMER_HDR_FILE_PREFIX + std::to_string(cpu);
+    uint64_t maxSize = memoryPoolSize
+                               ? memoryPoolSize
+                               : iotrace_procfs_max_buffer_size_mb << 20;
+
+    m_ring.reset(
+            new MappedFile(ring_file_path, O_RDONLY, PROT_READ, maxSize));
+    m_consumerHdr.reset(new MappedFile(consumer_hdr_file_path, O_RDWR,
+                                       PROT_READ | PROT_WRITE,
+                                       sizeof(octf_trace_hdr_t)));
+
+    if (memoryPoolSize &&
+        m_ring->length + m_consumerHdr->length != memoryPoolSize) {
+        throw KernelTraceError("Unexpected kernel circular buffer size");
+    }
+}
+
+KernelTraceRing::~KernelTraceRing() {}
+
+char *KernelTraceRing::getBuffer() {
+    return m_ring->buffer;
+}
+
+uint64_t KernelTraceRing::getSize() const {
+    return m_ring->length;
+}
+
+octf_trace_hdr_t *KernelTraceRing::getConsumerHeader() {
+    return reinterpret_cast<octf_trace_hdr_t *>(m_consumerHdr->buffer);
+}
+
+uint32_t KernelTraceRing::getCpu() const {
+    return m_cpu;
+}
+
+bool KernelTraceRing::wait() {
+    return ::ioctl(m_ring->fd, IOTRACE_IOCTL_WAIT_FOR_TRACES) == 0;
+}
+
+void KernelTraceRing::interrupt() {
+    ::ioctl(m_ring->fd, IOTRACE_IOCTL_INTERRUPT_WAIT_FOR_TRACES);
+}
+
+bool KernelTraceRing::getCommittedSpan(const char *&span, uint64_t &size) {
+    octf_trace_hdr_t *hdr = getConsumerHeader();
+
+    // Only consumer moves read pointer, kernel publishes write pointer
+    int64_t rdPtr = hdr->rd_ptr;
+    int64_t wrPtr = __atomic_load_n(&hdr->wr_ptr, __ATOMIC_ACQUIRE);
+
+    span = m_ring->buffer + rdPtr;
+    if (wrPtr >= rdPtr) {
+        size = wrPtr - rdPtr;
+        return false;
+    }
+
+    // Kernel wrapped around, hand over the tail of the ring first
+    size = m_ring->length - rdPtr;
+    return true;
+}
+
+void KernelTraceRing::consume(uint64_t size) {
+    octf_trace_hdr_t *hdr = getConsumerHeader();
+    int64_t rdPtr = hdr->rd_ptr + size;
+
+    if (rdPtr >= static_cast<int64_t>(m_ring->length)) {
+        rdPtr = 0;
+    }
+
+    // Events have to be read before kernel may overwrite them
+    __atomic_store_n(&hdr->rd_ptr, rdPtr, __ATOMIC_RELEASE);
+}
+
+}  // namespace octf
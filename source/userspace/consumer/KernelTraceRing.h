@@ -0,0 +1,104 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#ifndef SOURCE_USERSPACE_CONSUMER_KERNELTRACERING_H
+#define SOURCE_USERSPACE_CONSUMER_KERNELTRACERING_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <octf/trace/trace.h>
+
+namespace octf {
+
+/**
+ * @brief Trace ring of a single CPU, exported by the kernel module through
+ * procfs and mapped into the consumer
+ *
+ * Kernel commits events at the write pointer, the consumer reads them in
+ * place and releases ring space by advancing the read pointer of the
+ * consumer header. A ring has to have a single consumer.
+ */
+class KernelTraceRing {
+public:
+    /**
+     * @param cpu CPU of the ring
+     * @param memoryPoolSize Expected size of ring and consumer header in
+     * bytes, 0 - not checked
+     *
+     * @throw KernelTraceError when the ring cannot be mapped, e.g. the kernel
+     * module is not loaded
+     */
+    KernelTraceRing(uint32_t cpu, uint64_t memoryPoolSize);
+    ~KernelTraceRing();
+
+    KernelTraceRing(const KernelTraceRing &) = delete;
+    KernelTraceRing &operator=(const KernelTraceRing &) = delete;
+
+    char *getBuffer();
+
+    uint64_t getSize() const;
+
+    octf_trace_hdr_t *getConsumerHeader();
+
+    uint32_t getCpu() const;
+
+    /**
+     * @brief Waits until the ring is almost full, or the wait is interrupted
+     *
+     * @retval true Wait succeeded
+     * @retval false Wait failed, e.g. interrupted by a signal
+     */
+    bool wait();
+
+    /**
+     * @brief Interrupts ongoing wait
+     *
+     * @note A wait started after the interrupt is not affected
+     */
+    void interrupt();
+
+    /**
+     * @brief Gets contiguous span of events committed by kernel, which
+     * have not been consumed yet
+     *
+     * @param[out] span Beginning of the span in ring buffer
+     * @param[out] size Size of the span in bytes
+     *
+     * @retval true Span ends at the end of ring buffer while more events
+     * follow from its beginning, the end of span not holding a whole event
+     * is padding
+     * @retval false Span ends at the last committed event
+     */
+    bool getCommittedSpan(const char *&span, uint64_t &size);
+
+    /**
+     * @brief Advances consumer header, releasing ring space to kernel
+     *
+     * @param size Number of consumed bytes from the beginning of the span
+     */
+    void consume(uint64_t size);
+
+private:
+    struct MappedFile {
+        MappedFile(std::string path,
+                   int open_flags,
+                   int map_prot,
+                   uint64_t max_size);
+        ~MappedFile();
+
+        char *buffer;
+        int fd;
+        size_t length;
+    };
+
+    const uint32_t m_cpu;
+    std::unique_ptr<struct MappedFile> m_ring;
+    std::unique_ptr<struct MappedFile> m_consumerHdr;
+};
+
+}  // namespace octf
+
+#endif  // SOURCE_USERSPACE_CONSUMER_KERNELTRACERING_H
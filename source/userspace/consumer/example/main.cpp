@@ -0,0 +1,111 @@
+/*
+ * Copyright(c) 2020 Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include "consumer/KernelTraceConsumer.h"
+#include "consumer/KernelTraceHandler.h"
+
+using namespace octf;
+
+static constexpr uint64_t MAX_BATCH_SIZE = 1024 * 1024;
+
+/** Poll interval in ms */
+static constexpr uint32_t POLL_INTERVAL = 100;
+
+/**
+ * @brief Counts events consumed from kernel trace rings
+ *
+ * Batches of all CPUs are handled concurrently, hence atomic counters.
+ */
+class EventCounter : public KernelTraceHandler {
+public:
+    EventCounter()
+            : m_ios(0)
+            , m_completions(0)
+            , m_others(0)
+            , m_sectors(0) {}
+    virtual ~EventCounter() = default;
+
+    uint64_t handleEvents(uint32_t cpu,
+                          const char *events,
+                          uint64_t size) override {
+        (void) cpu;
+        KernelEventIterator iterator(events, size);
+
+        while (const auto *hdr = iterator.next()) {
+            switch (hdr->type) {
+            case iotrace_event_type_io: {
+                const auto *ev =
+                        KernelEventIterator::get<struct iotrace_event>(hdr);
+                if (ev) {
+                    m_sectors += ev->len;
+                }
+                m_ios++;
+            } break;
+            case iotrace_event_type_io_cmpl:
+                m_completions++;
+                break;
+            default:
+                m_others++;
+                break;
+            }
+        }
+
+        return iterator.getOffset();
+    }
+
+    void print(std::ostream &out) const {
+        out << "IOs: " << m_ios << std::endl;
+        out << "Completions: " << m_completions << std::endl;
+        out << "Other events: " << m_others << std::endl;
+        out << "Sectors: " << m_sectors << std::endl;
+    }
+
+private:
+    std::atomic<uint64_t> m_ios;
+    std::atomic<uint64_t> m_completions;
+    std::atomic<uint64_t> m_others;
+    std::atomic<uint64_t> m_sectors;
+};
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <duration in seconds>"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int duration = std::atoi(argv[1]);
+    if (duration <= 0) {
+        std::cerr << "Invalid duration: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    EventCounter counter;
+
+    try {
+        KernelTraceConsumer consumer(counter, MAX_BATCH_SIZE, POLL_INTERVAL);
+
+        consumer.start();
+        std::this_thread::sleep_for(std::chrono::seconds(duration));
+        consumer.stop();
+
+        counter.print(std::cout);
+        std::cout << "Batches: " << consumer.getBatchCount() << std::endl;
+        std::cout << "Backpressure: " << consumer.getBackpressureCount()
+                  << std::endl;
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,14 @@
+include(CMakeFindDependencyMacro)
+
+find_dependency(Threads)
+
+# Trace event structures come from OCTF headers, the framework library
+# itself is not linked
+find_dependency(octf CONFIG)
+
+include("${CMAKE_CURRENT_LIST_DIR}/iotrace-consumer-targets.cmake")
+
+get_target_property(IOTRACE_CONSUMER_OCTF_INCLUDES octf
+        INTERFACE_INCLUDE_DIRECTORIES)
+set_property(TARGET iotrace::iotrace-consumer APPEND PROPERTY
+        INTERFACE_INCLUDE_DIRECTORIES ${IOTRACE_CONSUMER_OCTF_INCLUDES})
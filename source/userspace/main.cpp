@@ -10,6 +10,7 @@
 #include <octf/interface/InterfaceTraceParsingImpl.h>
 #include <octf/utils/Exception.h>
 #include "InterfaceKernelTraceCreatingImpl.h"
+#include "InterfaceTraceAnalyticsImpl.h"
 #include "procfs_files.h"
 
 using namespace std;
@@ -41,13 +42,17 @@ int main(int argc, char *argv[]) {
         InterfaceShRef iTraceParsing =
                 std::make_shared<InterfaceTraceParsingImpl>();
 
+        // Trace Analytics Interface
+        InterfaceShRef iTraceAnalytics =
+                std::make_shared<InterfaceTraceAnalyticsImpl>();
+
         // Configuration Interface for setting trace repository path
         InterfaceShRef iConfiguration =
                 std::make_shared<InterfaceConfigurationImpl>();
 
         // Add interfaces to executor
         ex.addModules(iTraceManagement, iKernelTarcing, iTraceParsing,
-                      iConfiguration);
+                      iTraceAnalytics, iConfiguration);
 
         // Execute command
         return ex.execute(argc, argv);
@@ -0,0 +1,118 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+import struct
+
+COLUMNAR_MAGIC = b"IOTRCOL1"
+
+VARINT = 0
+DELTA = 1
+RUN_LENGTH = 2
+
+
+class ColumnarTrace:
+    """
+    Reader of columnar trace exports, see ColumnarTraceWriter.h for the layout
+    """
+    def __init__(self, data: bytes):
+        if data[:8] != COLUMNAR_MAGIC or data[-8:] != COLUMNAR_MAGIC:
+            raise Exception("Invalid columnar file magic")
+
+        footer_size, = struct.unpack_from("<Q", data, len(data) - 16)
+        reader = FooterReader(data, len(data) - 16 - footer_size)
+
+        self.version = reader.read("<I")
+        self.names = []
+        for _ in range(reader.read("<I")):
+            reader.read("<B")
+            self.names.append(reader.read_bytes(reader.read("<H")).decode())
+
+        self.row_groups = []
+        for _ in range(reader.read("<Q")):
+            group = RowGroup(reader.read("<Q"), reader.read("<Q"), reader.read("<Q"))
+            for name in self.names:
+                offset, size = reader.read("<Q"), reader.read("<Q")
+                group.encodings[name] = reader.read("<B")
+                group.chunks[name] = data[offset:offset + size]
+            self.row_groups.append(group)
+
+    def get_column(self, name: str) -> list:
+        values = []
+        for group in self.row_groups:
+            values += decode_column(group.chunks[name], group.encodings[name],
+                                    group.row_count)
+        return values
+
+    def get_rows(self) -> list:
+        return list(zip(*[self.get_column(name) for name in self.names]))
+
+
+class RowGroup:
+    def __init__(self, row_count, first_timestamp, last_timestamp):
+        self.row_count = row_count
+        self.first_timestamp = first_timestamp
+        self.last_timestamp = last_timestamp
+        self.chunks = {}
+        self.encodings = {}
+
+
+class FooterReader:
+    def __init__(self, data: bytes, offset: int):
+        self.data = data
+        self.offset = offset
+
+    def read(self, fmt: str) -> int:
+        value, = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += struct.calcsize(fmt)
+        return value
+
+    def read_bytes(self, size: int) -> bytes:
+        value = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return value
+
+
+def read_varints(chunk: bytes) -> list:
+    values = []
+    value, shift = 0, 0
+    for byte in chunk:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            values.append(value)
+            value, shift = 0, 0
+    if shift:
+        raise Exception("Malformed varint in column data")
+    return values
+
+
+def varint_size(value: int) -> int:
+    size = 1
+    while value >= 0x80:
+        value >>= 7
+        size += 1
+    return size
+
+
+def decode_column(chunk: bytes, encoding: int, count: int) -> list:
+    varints = read_varints(chunk)
+
+    if encoding == VARINT:
+        values = varints
+    elif encoding == DELTA:
+        values, previous = [], 0
+        for varint in varints:
+            previous = (previous + ((varint >> 1) ^ -(varint & 1))) & (2 ** 64 - 1)
+            values.append(previous)
+    elif encoding == RUN_LENGTH:
+        values = []
+        for value, run in zip(varints[::2], varints[1::2]):
+            values += [value] * run
+    else:
+        raise Exception(f"Unknown column encoding {encoding}")
+
+    if len(values) != count:
+        raise Exception(f"Column holds {len(values)} values, expected {count}")
+    return values
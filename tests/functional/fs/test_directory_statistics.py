@@ -0,0 +1,202 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+import time
+import pytest
+
+from core.test_run import TestRun
+from test_tools.disk_utils import Filesystem
+from test_tools.fs_utils import create_directory
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+@pytest.fixture(params=Filesystem)
+def fs(request):
+    file_system = request.param
+    mountpoint = "/mnt"
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step(f"Create file system {file_system}"):
+        disk.create_filesystem(file_system)
+
+    with TestRun.step("Mount device"):
+        disk.mount(mountpoint)
+
+    yield disk, mountpoint
+
+    with TestRun.step("Unmount device"):
+        disk.unmount()
+
+
+def test_directory_statistics(fs):
+    """
+        title: Test grouping of FS statistics by directory prefix
+        description: |
+          Create files on filesystem (relative to fs root):
+            * test_dir/sub_dir/A.x
+            * test_dir/B.y
+          write known amount of data to them while tracing and get directory
+          statistics for various prefix depths.
+        pass_criteria:
+          - Depth 0 accounts both files to partition root
+          - Depth 1 accounts both files to /test_dir
+          - Depth 2 accounts files to /test_dir/sub_dir and /test_dir
+          - Written bytes equal the workload
+    """
+
+    iotrace = TestRun.plugins["iotrace"]
+    disk, mountpoint = fs
+
+    with TestRun.step("Prepare directories and files"):
+        sub_dir = f"{mountpoint}/test_dir/sub_dir"
+        create_directory(sub_dir, parents=True)
+
+        Ax_size = Size(4, Unit.MebiByte)
+        By_size = Size(1, Unit.MebiByte)
+
+        fio_cfg = (
+            Fio()
+            .create_command()
+            .io_engine(IoEngine.libaio)
+            .sync(True)
+            .read_write(ReadWrite.write)
+        )
+        (
+            fio_cfg.add_job("A.x")
+            .target(f"{sub_dir}/A.x")
+            .file_size(Ax_size)
+            .block_size(Size(64, Unit.KibiByte))
+        )
+        (
+            fio_cfg.add_job("B.y")
+            .target(f"{mountpoint}/test_dir/B.y")
+            .file_size(By_size)
+            .block_size(Size(64, Unit.KibiByte))
+        )
+
+        fio_cfg.edit_global().create_only(True)
+        fio_cfg.run()
+
+    with TestRun.step("Trace workload"):
+        iotrace.start_tracing([disk.system_path], Size(1, Unit.GibiByte))
+        time.sleep(3)
+        fio_cfg.edit_global().create_only(False)
+        fio_cfg.run()
+        iotrace.stop_tracing()
+
+    with TestRun.step("Verify directory statistics"):
+        trace_path = IotracePlugin.get_latest_trace_path()
+
+        for depth, expected in [
+            (0, {"/": Ax_size + By_size}),
+            (1, {"/test_dir": Ax_size + By_size}),
+            (2, {"/test_dir/sub_dir": Ax_size, "/test_dir": By_size}),
+        ]:
+            summary = IotracePlugin.run_analytics(
+                'directory-statistics', path=trace_path, depth=depth)[0]
+            written = {
+                d['directory']: int(d['write']['bytes'])
+                for d in summary['directory'] if 'write' in d
+            }
+
+            for directory, size in expected.items():
+                expect_equal(f"depth {depth} {directory} written bytes",
+                             int(size.get_value()), written.get(directory, 0))
+
+
+def test_fs_rollups(fs):
+    """
+        title: Test rollups of FS statistics by subtree, extension and size class
+        description: |
+          Create files on filesystem (relative to fs root):
+            * test_dir/sub_dir/A.x
+            * test_dir/B.y
+          write known amount of data to them while tracing and roll file system
+          statistics up.
+        pass_criteria:
+          - /test_dir subtree is ranked first by bytes and by IOs
+          - /test_dir subtree accounts both files and all written bytes
+          - Extensions x and y account one file and its written bytes each
+          - Size classes account both files and all written bytes
+    """
+
+    iotrace = TestRun.plugins["iotrace"]
+    disk, mountpoint = fs
+
+    with TestRun.step("Prepare directories and files"):
+        sub_dir = f"{mountpoint}/test_dir/sub_dir"
+        create_directory(sub_dir, parents=True)
+
+        Ax_size = Size(4, Unit.MebiByte)
+        By_size = Size(1, Unit.MebiByte)
+
+        fio_cfg = (
+            Fio()
+            .create_command()
+            .io_engine(IoEngine.libaio)
+            .sync(True)
+            .read_write(ReadWrite.write)
+        )
+        (
+            fio_cfg.add_job("A.x")
+            .target(f"{sub_dir}/A.x")
+            .file_size(Ax_size)
+            .block_size(Size(64, Unit.KibiByte))
+        )
+        (
+            fio_cfg.add_job("B.y")
+            .target(f"{mountpoint}/test_dir/B.y")
+            .file_size(By_size)
+            .block_size(Size(64, Unit.KibiByte))
+        )
+
+        fio_cfg.edit_global().create_only(True)
+        fio_cfg.run()
+
+    with TestRun.step("Trace workload"):
+        iotrace.start_tracing([disk.system_path], Size(1, Unit.GibiByte))
+        time.sleep(3)
+        fio_cfg.edit_global().create_only(False)
+        fio_cfg.run()
+        iotrace.stop_tracing()
+
+    with TestRun.step("Verify rollups"):
+        trace_path = IotracePlugin.get_latest_trace_path()
+        summary = IotracePlugin.run_analytics('fs-rollups', path=trace_path,
+                                              top=5)[0]
+
+        for ranking in ['topByBytes', 'topByIos']:
+            top = summary[ranking][0]
+            if top['directory'] != "/test_dir":
+                TestRun.LOGGER.error(
+                    f"{ranking}: expected /test_dir first, got {top['directory']}")
+            expect_equal(f"{ranking} files", 2, int(top.get('files', 0)))
+            expect_equal(f"{ranking} written bytes",
+                         int((Ax_size + By_size).get_value()),
+                         int(top.get('write', {}).get('bytes', 0)))
+
+        extensions = {e.get('extension', ''): e for e in summary['extension']}
+        for extension, size in [("x", Ax_size), ("y", By_size)]:
+            stats = extensions.get(extension, {})
+            expect_equal(f"extension {extension} files", 1,
+                         int(stats.get('files', 0)))
+            expect_equal(f"extension {extension} written bytes",
+                         int(size.get_value()),
+                         int(stats.get('write', {}).get('bytes', 0)))
+
+        expect_equal("size classes files", 2,
+                     sum(int(c.get('files', 0)) for c in summary['sizeClass']))
+        expect_equal("size classes written bytes",
+                     int((Ax_size + By_size).get_value()),
+                     sum(int(c.get('write', {}).get('bytes', 0))
+                         for c in summary['sizeClass']))
+
+
+def expect_equal(what: str, expected: int, got: int):
+    if expected != got:
+        TestRun.LOGGER.error(f"Invalid {what} (expected {expected}, got {got})")
@@ -0,0 +1,74 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+working_set = Size(16, Unit.MebiByte)
+max_cache_size = 32
+steps = 4
+
+
+def test_cache_simulation():
+    """
+        title: Test cache simulation over trace
+        description: |
+          Read a 16 MiB range of the disk sequentially twice and simulate
+          caches of all policies and modes, smaller and bigger than the range.
+        pass_criteria:
+          - All policy, mode and size combinations are simulated
+          - Each 4 KiB read accesses a single cache line
+          - Caches smaller than the range never hit, as every line is evicted
+            before it is read again
+          - Caches fitting the range hit on every read of the second pass
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step("Read 16 MiB range twice"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(working_set)
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.read)
+         .loops(2)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Simulate caches"):
+        summary = iotrace.run_analytics('simulate-cache', path=trace_path,
+                                        max_cache_size=max_cache_size,
+                                        size_steps=steps, threads=2)[0]
+
+    with TestRun.step("Check simulation results"):
+        lines = int(working_set.get_value(Unit.Blocks4096))
+        if int(summary['accesses']) != 2 * lines:
+            TestRun.fail(f"{summary['accesses']} cache line accesses, expected {2 * lines}")
+
+        results = summary['result']
+        combinations = {(result['policy'], result['mode'], int(result['cacheSize']))
+                        for result in results}
+        expected = {(policy, mode, max_cache_size * step // steps)
+                    for policy in ['lru', '2q', 'arc'] for mode in ['wb', 'wt']
+                    for step in range(1, steps + 1)}
+        if combinations != expected or len(results) != len(expected):
+            TestRun.fail(f"Simulated caches {sorted(combinations)}, "
+                         f"expected {sorted(expected)}")
+
+        for result in results:
+            fits = int(result['cacheSize']) >= working_set.get_value(Unit.MebiByte)
+            expected_percent = 50 if fits else 0
+            if round(float(result.get('hitPercent', 0)), 2) != expected_percent:
+                TestRun.fail(f"{result['policy']} {result['mode']} cache of "
+                             f"{result['cacheSize']} MiB hits {result.get('hitPercent', 0)}%, "
+                             f"expected {expected_percent}%")
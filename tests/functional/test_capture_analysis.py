@@ -0,0 +1,90 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+io_size = Size(1, Unit.Blocks4096)
+workload_size = Size(100, Unit.MebiByte)
+# Hot LBA analyzer ranges of 1 MiB and number of reported ranges, in sectors
+hot_range_size = 2048
+hot_range_count = 16
+
+
+def test_capture_analysis():
+    """
+        title: Test analyzers run during capture
+        description: |
+          Capture a trace of a workload with IO size and hot LBA analyzers
+          and compare their results with the trace.
+        pass_criteria:
+          - Results of all analyzers are written to the trace directory
+          - IO size distributions account for exactly the IOs of the trace
+          - Hot ranges of the traced device cover the workload
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step("Trace workload with analyzers"):
+        iotrace.start_tracing([disk.system_path],
+                              analyzers=['io-size', 'hot-lba'])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(workload_size)
+         .block_size(io_size)
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+
+        operations = {}
+        for event in iotrace.get_trace_events(trace_path):
+            if 'io' in event:
+                name = event['io']['operation'].lower()
+                operations[name] = operations.get(name, 0) + 1
+
+    with TestRun.step("Check capture analysis"):
+        analysis = iotrace.run_analytics('capture-analysis', path=trace_path)[0]
+        results = {analyzer['name']: analyzer
+                   for analyzer in analysis.get('analyzer', [])}
+        if set(results) != {'io-size', 'hot-lba'}:
+            TestRun.fail(f"Missing analyzer results: {analysis}")
+
+    with TestRun.step("Check IO sizes"):
+        sizes = {distribution['name']: distribution
+                 for distribution in results['io-size'].get('distribution', [])}
+        counts = {name: int(distribution['count'])
+                  for name, distribution in sizes.items()}
+        if counts != operations:
+            TestRun.fail(f"IO sizes account for {counts} IOs, trace has {operations}")
+
+        for name, distribution in sizes.items():
+            if (int(distribution['min']), int(distribution['max'])) != \
+                    (int(io_size.get_value()), int(io_size.get_value())):
+                TestRun.fail(f"Unexpected {name} IO sizes: {distribution}")
+
+    with TestRun.step("Check hot ranges"):
+        ranges = results['hot-lba'].get('hotRange', [])
+        if len(ranges) != hot_range_count:
+            TestRun.fail(f"Expected {hot_range_count} hot ranges: {results['hot-lba']}")
+
+        # Workload accesses every block of its area once
+        workload_end = int(workload_size.get_value() / 512)
+        for hot_range in ranges:
+            lba, length = int(hot_range.get('lba', 0)), int(hot_range['len'])
+            if length != hot_range_size or lba % hot_range_size or \
+                    lba >= workload_end:
+                TestRun.fail(f"Hot range out of workload area: {hot_range}")
+            if int(hot_range['sectors']) < hot_range_size:
+                TestRun.fail(f"Hot range underestimates access: {hot_range}")
+
+        sectors = [int(hot_range['sectors']) for hot_range in ranges]
+        if sectors != sorted(sectors, reverse=True):
+            TestRun.fail(f"Hot ranges are not in descending order: {sectors}")
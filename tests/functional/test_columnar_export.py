@@ -0,0 +1,102 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+import base64
+
+from api.iotrace_columnar_parser import ColumnarTrace, DELTA, varint_size
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+row_group_size = 1024
+
+
+def test_columnar_export():
+    """
+        title: Test columnar export of parsed trace
+        description: |
+          Export a trace into columnar file, decode the file and compare it
+          with IO events printed by the trace parser.
+        pass_criteria:
+          - Decoded rows equal parsed IO events
+          - Row groups hold row group size rows and their time ranges
+          - Timestamps are delta encoded and smaller than their varints
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    output_path = "/tmp/iotrace_columnar_export.iotcol"
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(100, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Export trace with small row groups"):
+        summary = iotrace.run_analytics('export-columnar', path=trace_path,
+                                        output=output_path,
+                                        row_group_size=row_group_size, threads=4)[0]
+        data = base64.b64decode(
+            TestRun.executor.run_expect_success(f"base64 -w0 {output_path}").stdout)
+        TestRun.executor.run(f"rm -f {output_path}")
+        columnar = ColumnarTrace(data)
+
+    with TestRun.step("Compare decoded rows with parsed events"):
+        events = [event for event in iotrace.get_trace_events(trace_path) if 'io' in event]
+        rows = columnar.get_rows()
+
+        if int(summary['rowCount']) != len(events) or len(rows) != len(events):
+            TestRun.fail(f"Exported {summary['rowCount']} rows, decoded {len(rows)}, "
+                         f"trace contains {len(events)} IO events")
+
+        operations = {}
+        for row, event in zip(rows, events):
+            expected = (int(event['header'].get('timestamp', 0)),
+                        int(event['io'].get('lba', 0)),
+                        int(event['io'].get('len', 0)),
+                        int(event['device'].get('id', 0)),
+                        int(event['io'].get('latency', 0)),
+                        int(event.get('file', {}).get('id', 0)))
+            timestamp, lba, length, operation, device_id, latency, file_id = row
+            if (timestamp, lba, length, device_id, latency, file_id) != expected:
+                TestRun.fail(f"Decoded row {row} differs from parsed event {event}")
+            if operations.setdefault(event['io']['operation'], operation) != operation:
+                TestRun.fail(f"Operation {event['io']['operation']} exported with "
+                             f"different codes")
+
+    with TestRun.step("Check row groups"):
+        for number, group in enumerate(columnar.row_groups):
+            last = number == len(columnar.row_groups) - 1
+            if group.row_count != row_group_size and not last:
+                TestRun.fail(f"Row group {number} holds {group.row_count} rows")
+
+            timestamps = [row[0] for row in rows[number * row_group_size:
+                                                 number * row_group_size + group.row_count]]
+            if (group.first_timestamp, group.last_timestamp) != \
+                    (timestamps[0], timestamps[-1]):
+                TestRun.fail(f"Time range of row group {number} does not match its rows")
+
+    with TestRun.step("Check timestamp encoding"):
+        columns = {column['name']: column for column in summary['column']}
+        timestamp = columns['timestamp']
+
+        if set(timestamp['encodings']) != {'delta'} or \
+                any(group.encodings['timestamp'] != DELTA for group in columnar.row_groups):
+            TestRun.fail(f"Timestamps encoded as {timestamp['encodings']}")
+
+        varints = sum(varint_size(row[0]) for row in rows)
+        if int(timestamp['encodedSize']) >= varints:
+            TestRun.fail(f"Delta encoded timestamps take {timestamp['encodedSize']} bytes, "
+                         f"their varints {varints} bytes")
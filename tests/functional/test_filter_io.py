@@ -0,0 +1,78 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+def test_filter_io():
+    """
+        title: Test filtering IO events
+        description: |
+          Filter traced IO events by operation and LBA range, using all
+          filter implementations supported by the CPU.
+        pass_criteria:
+          - Filter without criteria matches IO and completion event of each IO
+          - Reads and writes match each IO issued by fio once, with its size
+          - Completions match each IO issued by fio once
+          - LBA ranges splitting the device sum up to all events
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    io_size = Size(100, Unit.MebiByte)
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(io_size)
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+    ios = int(io_size.get_value(Unit.Blocks4096))
+
+    with TestRun.step("Filter all events with all implementations"):
+        summary = iotrace.run_analytics('filter-io', path=trace_path, benchmark=True)[0]
+        TestRun.LOGGER.info(f"IO filter benchmark: {summary}")
+
+        events = int(summary.get('events', 0))
+        if events != 2 * ios or int(summary.get('matched', 0)) != events:
+            TestRun.fail(f"Filter without criteria does not match IO and completion "
+                         f"of {ios} IOs: {summary}")
+
+        implementations = [i['implementation'] for i in summary['implementation']]
+        if 'scalar' not in implementations:
+            TestRun.fail(f"Scalar implementation not evaluated: {summary}")
+
+    with TestRun.step("Filter by operation"):
+        data = iotrace.run_analytics('filter-io', path=trace_path,
+                                     operations=['read', 'write'])[0]
+        if int(data.get('matched', 0)) != ios or \
+                int(data.get('matchedBytes', 0)) != int(io_size.get_value(Unit.Byte)):
+            TestRun.fail(f"Reads and writes of {ios} IOs, {io_size} matched as {data}")
+
+        completions = iotrace.run_analytics('filter-io', path=trace_path,
+                                            operations=['completion'])[0]
+        if int(completions.get('matched', 0)) != ios:
+            TestRun.fail(f"Completions of {ios} IOs matched as {completions}")
+
+    with TestRun.step("Filter by LBA range"):
+        half = int(disk.size.get_value(Unit.Blocks512) // 2)
+        lower = iotrace.run_analytics('filter-io', path=trace_path, lba_end=half,
+                                      benchmark=True)[0]
+        upper = iotrace.run_analytics('filter-io', path=trace_path, lba_begin=half,
+                                      benchmark=True)[0]
+        matched = int(lower.get('matched', 0)) + int(upper.get('matched', 0))
+
+        if matched != events:
+            TestRun.fail(f"LBA ranges matched {matched} events, expected {events}")
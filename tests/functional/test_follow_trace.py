@@ -0,0 +1,122 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from datetime import timedelta
+from utils.iotrace import IotracePlugin
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+
+segment_list = "/tmp/iotrace_segments"
+
+
+def test_follow_trace():
+    """
+        title: Test following trace during capture
+        description: |
+            Trace random IO in segments and follow them while they are sealed.
+        pass_criteria:
+            - Rolling statistics are printed for each sealed segment
+            - Printed IO events equal the number of events in summary
+            - Rolling window does not exceed its length
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    TestRun.executor.run(f"rm -f {segment_list}")
+
+    with TestRun.step("Trace random IO in segments"):
+        iotrace.start_tracing([disk.system_path], segment_time=timedelta(seconds=3),
+                              segment_list=segment_list)
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(100, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .time_based()
+         .run_time(timedelta(seconds=10))
+         .run())
+        iotrace.stop_tracing()
+
+    with TestRun.step("Follow sealed segments"):
+        output = iotrace.run_analytics('follow', segment_list=segment_list, window=5,
+                                       events=True, idle_timeout=2)
+        summary = output[-1]
+        snapshots = [doc for doc in output[:-1] if 'segment' in doc]
+        events = [doc for doc in output[:-1] if 'header' in doc]
+
+    with TestRun.step("Check rolling statistics"):
+        segments = TestRun.executor.run(f"cat {segment_list}").stdout.split()
+        if len(snapshots) != len(segments) or int(summary['segments']) != len(segments):
+            TestRun.fail(f"{len(snapshots)} snapshots printed for {len(segments)} segments")
+
+        if len(events) != int(summary['events']):
+            TestRun.fail(f"{len(events)} events printed, summary reports {summary['events']}")
+
+        for snapshot in snapshots:
+            window = int(snapshot.get('windowEnd', 0)) - int(snapshot.get('windowStart', 0))
+            if window > timedelta(seconds=5).total_seconds() * 1e9:
+                TestRun.fail(f"Rolling window of {window} ns exceeds its length")
+
+
+def test_follow_trace_gaps():
+    """
+        title: Test following trace with gaps between segments
+        description: |
+            Trace two bursts of IO separated by idle time in segments, follow
+            the segments and analyze the same segments as a range.
+        pass_criteria:
+            - Followed events have the same timestamps as the segment range
+            - Idle time between bursts is kept in timestamps of both
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    output_path = "/tmp/iotrace_follow_gaps.iotcol"
+    idle_time = timedelta(seconds=8)
+    TestRun.executor.run(f"rm -f {segment_list}")
+
+    with TestRun.step("Trace two bursts of IO in segments"):
+        iotrace.start_tracing([disk.system_path], segment_time=timedelta(seconds=2),
+                              segment_list=segment_list)
+        fio = (Fio().create_command()
+               .io_engine(IoEngine.libaio)
+               .size(Size(100, Unit.MebiByte))
+               .block_size(Size(1, Unit.Blocks4096))
+               .read_write(ReadWrite.randread)
+               .target(disk.system_path)
+               .direct()
+               .time_based()
+               .run_time(timedelta(seconds=3)))
+        fio.run()
+        time.sleep(idle_time.total_seconds())
+        fio.run()
+        iotrace.stop_tracing()
+
+    with TestRun.step("Follow sealed segments"):
+        output = iotrace.run_analytics('follow', segment_list=segment_list, events=True,
+                                       idle_timeout=2)
+        followed = [int(doc['header'].get('timestamp', 0))
+                    for doc in output if 'header' in doc]
+
+    with TestRun.step("Export range of segments"):
+        segments = TestRun.executor.run(f"cat {segment_list}").stdout.split()
+        iotrace.run_analytics('export-columnar', path=segments[0], segments=segments[1:],
+                              output=output_path)
+        data = base64.b64decode(
+            TestRun.executor.run_expect_success(f"base64 -w0 {output_path}").stdout)
+        TestRun.executor.run(f"rm -f {output_path}")
+        exported = ColumnarTrace(data).get_column('timestamp')
+
+    with TestRun.step("Compare timestamps"):
+        if followed != exported:
+            TestRun.fail(f"{len(followed)} followed events differ from "
+                         f"{len(exported)} events of the segment range")
+
+        gap = max(b - a for a, b in zip(exported, exported[1:]))
+        if gap < (idle_time - timedelta(seconds=1)).total_seconds() * 1e9:
+            TestRun.fail(f"Longest gap between events is {gap} ns, "
+                         f"IO was idle for {idle_time}")
@@ -0,0 +1,75 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+def test_heatmap():
+    """
+        title: Test heatmap of hot LBA range
+        description: |
+          Trace random reads of a small range of the disk, build heatmap
+          and check the hot range and heatmap file.
+        pass_criteria:
+          - Heatmap file starts with magic
+          - Grid of the traced device does not exceed requested size
+          - The four hottest ranges are the 1 MiB ranges of the read range,
+            each of them read 16 times
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    output_path = "/tmp/iotrace_heatmap.iothm"
+    hot_range_kib = 1024
+    loops = 16
+
+    with TestRun.step("Trace random reads of first 4 MiB"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(4, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randread)
+         .loops(loops)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Build heatmap"):
+        summary = iotrace.run_analytics('heatmap', path=trace_path, output=output_path,
+                                        time_buckets=64, lba_buckets=128,
+                                        hot_range_size=hot_range_kib, top_ranges=4,
+                                        threads=2)[0]
+
+    with TestRun.step("Check heatmap"):
+        magic = TestRun.executor.run(f"head -c 8 {output_path}").stdout
+        if magic != "IOTRHMP1":
+            TestRun.fail("Heatmap file does not start with magic")
+
+        device = summary['device'][0]
+        if int(device['timeBuckets']) > 64 or int(device['lbaBuckets']) > 128:
+            TestRun.fail("Heatmap grid exceeds requested size")
+
+        # Random map of fio reads each block once per loop
+        range_sectors = hot_range_kib * 2
+        expected_lbas = [i * range_sectors for i in range(4)]
+        ranges = sorted(summary['hotRange'], key=lambda r: int(r.get('lba', 0)))
+        if [int(r.get('lba', 0)) for r in ranges] != expected_lbas or \
+                any(int(r['len']) != range_sectors for r in ranges):
+            TestRun.fail(f"Hottest ranges {ranges} are not the 1 MiB ranges of read range")
+
+        sectors = [int(r['sectors']) for r in ranges]
+        if min(sectors) < loops * range_sectors or \
+                sum(sectors) > 4 * loops * range_sectors * 1.01:
+            TestRun.fail(f"Hot ranges accessed {sectors} sectors, "
+                         f"read {loops * range_sectors} sectors each")
+
+    TestRun.executor.run(f"rm -f {output_path}")
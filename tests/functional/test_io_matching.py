@@ -0,0 +1,59 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+def test_io_matching():
+    """
+        title: Test bounded IO matching
+        description: |
+          Trace IO with high queue depth and match queue and completion events
+          with the smallest allowed in-flight table.
+        pass_criteria:
+          - Every IO issued by fio is queued and matched
+          - Peak number of IOs in flight does not exceed fio queue depth
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    capacity = 1024
+    io_depth = 64
+    io_size = Size(100, Unit.MebiByte)
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(io_size)
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .io_depth(io_depth)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Match IO"):
+        summary = iotrace.run_analytics('match-io', path=trace_path, capacity=capacity)[0]
+        stats = {key: int(value) for key, value in summary.items()}
+
+    with TestRun.step("Check matching summary"):
+        dropped = int(iotrace.get_trace_summary(trace_path).get('droppedEvents', 0))
+        if dropped:
+            TestRun.fail(f"{dropped} events dropped during capture")
+
+        ios = int(io_size.get_value(Unit.Blocks4096))
+        if stats['queued'] != ios or stats.get('matched', 0) != ios:
+            TestRun.fail(f"{ios} IOs issued, matching summary: {summary}")
+
+        if stats.get('peakInFlight', 0) > io_depth:
+            TestRun.fail(f"Peak in-flight IOs exceed queue depth {io_depth}: {summary}")
+
@@ -0,0 +1,92 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+working_set = Size(16, Unit.MebiByte)
+max_cache_size = 32
+points = 8
+
+
+def test_miss_ratio_curves():
+    """
+        title: Test miss ratio curve estimation
+        description: |
+          Read a 16 MiB range of the disk sequentially twice and estimate
+          miss ratio curves with all cache lines tracked and with sampling.
+        pass_criteria:
+          - Curve is estimated for the traced device and its IO classes
+          - Caches smaller than the range miss on every reference and caches
+            fitting it on the first pass only, exactly when nothing is sampled
+          - Sampled curve stays within 0.05 of the exact one away from the
+            range size
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step("Read 16 MiB range twice"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(working_set)
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.read)
+         .loops(2)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+    lines = int(working_set.get_value(Unit.Blocks4096))
+
+    with TestRun.step("Estimate curves tracking all cache lines"):
+        curves = iotrace.run_analytics('miss-ratio-curves', path=trace_path,
+                                       max_cache_size=max_cache_size, points=points,
+                                       sample_limit=2 * lines)[0]
+
+    with TestRun.step("Check exact curve"):
+        if len(curves['device']) != 1 or not curves.get('ioClass'):
+            TestRun.fail("Unexpected number of estimated curves")
+
+        curve = curves['device'][0]
+        class_accesses = sum(int(c['accesses']) for c in curves['ioClass'])
+        if int(curve['accesses']) != 2 * lines or class_accesses != 2 * lines:
+            TestRun.fail(f"Device curve counts {curve['accesses']} references, IO class "
+                         f"curves {class_accesses}, expected {2 * lines}")
+        if float(curve['samplingRate']) != 1:
+            TestRun.fail(f"References sampled at rate {curve['samplingRate']}")
+
+        for point in curve['point']:
+            size = float(point['cacheSize'])
+            expected = 0.5 if size >= working_set.get_value(Unit.MebiByte) else 1
+            if abs(float(point.get('missRatio', 0)) - expected) > 1e-6:
+                TestRun.fail(f"Miss ratio of {size} MiB cache is {point.get('missRatio', 0)}, "
+                             f"expected {expected}")
+
+    with TestRun.step("Estimate curves with sampling"):
+        curves = iotrace.run_analytics('miss-ratio-curves', path=trace_path,
+                                       max_cache_size=max_cache_size, points=points,
+                                       sample_limit=128)[0]
+
+    with TestRun.step("Check sampled curve"):
+        curve = curves['device'][0]
+        if float(curve['samplingRate']) >= 1:
+            TestRun.fail("References have not been sampled")
+
+        range_size = working_set.get_value(Unit.MebiByte)
+        for point in curve['point']:
+            size = float(point['cacheSize'])
+            if abs(size - range_size) <= max_cache_size / points:
+                continue
+            expected = 0.5 if size > range_size else 1
+            if abs(float(point.get('missRatio', 0)) - expected) > 0.05:
+                TestRun.fail(f"Sampled miss ratio of {size} MiB cache is "
+                             f"{point.get('missRatio', 0)}, expected {expected}")
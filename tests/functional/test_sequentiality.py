@@ -0,0 +1,95 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+io_size = Size(1, Unit.Blocks4096)
+job_size = Size(64, Unit.MebiByte)
+
+
+def trace_workload(read_write: ReadWrite, jobs: int) -> str:
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    iotrace.start_tracing([disk.system_path])
+    fio = (Fio().create_command()
+           .io_engine(IoEngine.libaio)
+           .size(job_size)
+           .block_size(io_size)
+           .read_write(read_write)
+           .direct())
+    for i in range(jobs):
+        (fio.add_job(f"job{i}")
+         .target(disk.system_path)
+         .offset(Size(128 * i, Unit.MebiByte)))
+    fio.run()
+    iotrace.stop_tracing()
+
+    return iotrace.get_latest_trace_path()
+
+
+def test_sequentiality():
+    """
+        title: Test detection of sequential streams
+        description: |
+          Trace concurrent sequential reads and random reads of a device and
+          compare their sequentiality.
+        pass_criteria:
+          - Each sequential job is a single stream, only its first IO is
+            not sequential
+          - Peak number of streams equals the number of sequential jobs
+          - Random workload is reported as mostly random
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    jobs = 4
+    job_ios = int(job_size.get_value() / io_size.get_value())
+
+    with TestRun.step("Trace concurrent sequential reads"):
+        trace_path = trace_workload(ReadWrite.read, jobs)
+
+    with TestRun.step("Verify sequential streams"):
+        summary = iotrace.run_analytics('sequentiality', path=trace_path)[0]
+        TestRun.LOGGER.info(f"Sequentiality: {summary}")
+
+        device = next(d for d in summary['device']
+                      if disk.system_path.endswith(d['name']))
+        read = device['read']
+        expected = {
+            'ios': jobs * job_ios,
+            'sequentialIos': jobs * (job_ios - 1),
+            'streams': jobs,
+            'peakStreams': jobs,
+        }
+        got = {
+            'ios': int(read['ios']),
+            'sequentialIos': int(read.get('sequentialIos', 0)),
+            'streams': int(read.get('streams', 0)),
+            'peakStreams': int(device.get('peakStreams', 0)),
+        }
+        if got != expected:
+            TestRun.fail(f"Expected {expected}, got {got}")
+
+        runs = {int(bucket.get('minIos', 0)): int(bucket['runs'])
+                for bucket in read['runLength']}
+        if runs != {job_ios: jobs}:
+            TestRun.fail(f"Expected {jobs} runs of {job_ios} IOs, got {runs}")
+
+    with TestRun.step("Trace random reads"):
+        trace_path = trace_workload(ReadWrite.randread, 1)
+
+    with TestRun.step("Verify random IO"):
+        summary = iotrace.run_analytics('sequentiality', path=trace_path,
+                                        table_size=8)[0]
+        device = next(d for d in summary['device']
+                      if disk.system_path.endswith(d['name']))
+        if int(device['read']['ios']) != job_ios:
+            TestRun.fail(f"Expected {job_ios} random reads: {device}")
+        if float(device['read'].get('sequentialPercent', 0)) > 1:
+            TestRun.fail(f"Random reads reported as sequential: {device}")
@@ -0,0 +1,79 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from datetime import timedelta
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+io_size = Size(1, Unit.Blocks4096)
+workload_size = Size(100, Unit.MebiByte)
+
+
+def test_time_series():
+    """
+        title: Test time series rolled up during capture
+        description: |
+          Capture a trace of a workload with time series rollups and compare
+          the time series with the trace.
+        pass_criteria:
+          - Time series is written to the trace directory
+          - Samples are one interval apart
+          - Time series accounts for all IOs of the workload and their bytes
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    interval = timedelta(seconds=1)
+    ios = int(workload_size.get_value() / io_size.get_value())
+
+    with TestRun.step("Trace workload with time series"):
+        iotrace.start_tracing([disk.system_path], rollup_interval=interval)
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(workload_size)
+         .block_size(io_size)
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Check time series"):
+        series = iotrace.run_analytics('time-series', path=trace_path)[0]
+        if not series.get('complete', False):
+            TestRun.fail(f"Time series is not complete: {series}")
+
+        interval_ns = int(interval.total_seconds() * 1000000000)
+        if int(series['interval']) != interval_ns:
+            TestRun.fail(f"Expected interval of {interval_ns} ns: {series}")
+
+        devices = series.get('device', [])
+        if len(devices) != 1 or not devices[0].get('sample'):
+            TestRun.fail(f"No samples of traced device: {series}")
+
+        starts = [int(sample['start']) for sample in devices[0]['sample']]
+        if any((b - a) % interval_ns for a, b in zip(starts, starts[1:])):
+            TestRun.fail(f"Samples are not aligned to interval: {starts}")
+
+        operations = [operation for sample in devices[0]['sample']
+                      for operation in sample.get('operation', [])]
+        rolled_up = sum(int(operation.get('count', 0)) for operation in operations)
+        rolled_up_bytes = sum(int(operation.get('bytes', 0)) for operation in operations)
+        late = int(series.get('lateCompletions', 0))
+
+    with TestRun.step("Compare with IOs of the workload"):
+        if rolled_up + late != ios or int(series.get('orphanCompletions', 0)):
+            TestRun.fail(f"Time series has {rolled_up} IOs and {late} late "
+                         f"completions, workload issued {ios}: {series}")
+        if rolled_up_bytes != rolled_up * io_size.get_value():
+            TestRun.fail(f"Time series has {rolled_up_bytes} bytes of {rolled_up} IOs")
+
+        matching = iotrace.run_analytics('match-io', path=trace_path)[0]
+        if int(matching.get('matched', 0)) != ios:
+            TestRun.fail(f"Expected {ios} matched IOs in trace: {matching}")
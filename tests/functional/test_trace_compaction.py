@@ -0,0 +1,119 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+io_size = Size(1, Unit.Blocks4096)
+workload_size = Size(100, Unit.MebiByte)
+sampling_scale = 1000000
+# Default sampling unit of 4 KiB in sectors
+sampling_unit = 8
+
+
+def test_trace_compaction():
+    """
+        title: Test compacting trace
+        description: |
+          Compact a trace of random workload with consistent hash sampling
+          and with an LBA filter.
+        pass_criteria:
+          - Exactly IOs of sampled units are kept
+          - Kept IOs are matched with their completions
+          - Compaction criteria are recorded in trace summary
+          - Exactly IOs in LBA range are kept
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    ios = int(workload_size.get_value() / io_size.get_value())
+
+    with TestRun.step("Trace random workload"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(workload_size)
+         .block_size(io_size)
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+        events = [event for event in iotrace.get_trace_events(trace_path)
+                  if 'io' in event]
+
+    with TestRun.step("Compact with sampling"):
+        output = "compacted/sampled"
+        rate = 100000
+        summary = iotrace.run_analytics('compact', path=trace_path,
+                                        output=output, sampling_rate=rate)[0]
+        TestRun.LOGGER.info(f"Compaction summary: {summary}")
+
+        expected = sorted(get_lba(event) for event in events
+                          if is_sampled(event, rate))
+        kept = int(summary.get('keptIos', 0))
+        if int(summary.get('ios', 0)) != ios or kept != len(expected):
+            TestRun.fail(f"Expected {len(expected)} of {ios} IOs kept: {summary}")
+        if get_lbas(output) != expected:
+            TestRun.fail("Compacted trace does not hold IOs of sampled units")
+
+    with TestRun.step("Analyze compacted trace"):
+        trace_summary = iotrace.get_trace_summary(output)
+        if trace_summary['state'] != "COMPLETE":
+            TestRun.fail(f"Compacted trace is not complete: {trace_summary}")
+        if f"sampling_ppm={rate}" not in trace_summary.get('tags', []):
+            TestRun.fail(f"Sampling rate is not in trace tags: {trace_summary}")
+
+        matching = iotrace.run_analytics('match-io', path=output)[0]
+        if int(matching.get('matched', 0)) != kept:
+            TestRun.fail(f"Expected {kept} matched IOs: {matching}")
+        if int(matching.get('orphanCompletions', 0)) != 0:
+            TestRun.fail(f"Compacted trace has orphan completions: {matching}")
+
+    with TestRun.step("Compact with LBA filter"):
+        output = "compacted/filtered"
+        lba_end = 1024
+        summary = iotrace.run_analytics('compact', path=trace_path,
+                                        output=output, lba_begin=0,
+                                        lba_end=lba_end)[0]
+        TestRun.LOGGER.info(f"Compaction summary: {summary}")
+
+        expected = sorted(get_lba(event) for event in events
+                          if get_lba(event) < lba_end)
+        if get_lbas(output) != expected:
+            TestRun.fail(f"Expected {len(expected)} IOs below LBA {lba_end} kept")
+
+
+def get_lba(event: dict) -> int:
+    return int(event['io'].get('lba', 0))
+
+
+def get_lbas(trace_path: str) -> list:
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    return sorted(get_lba(event) for event in iotrace.get_trace_events(trace_path)
+                  if 'io' in event)
+
+
+def hash_mix64(value: int) -> int:
+    mask = 2 ** 64 - 1
+    value ^= value >> 33
+    value = (value * 0xff51afd7ed558ccd) & mask
+    value ^= value >> 33
+    value = (value * 0xc4ceb9fe1a85ec53) & mask
+    value ^= value >> 33
+    return value
+
+
+def is_sampled(event: dict, rate: int) -> bool:
+    """
+    Sampling decision of the compactor, see TraceCompactor::isSampled
+    """
+    unit = get_lba(event) // sampling_unit
+    device_id = int(event['device'].get('id', 0))
+    return hash_mix64(hash_mix64(device_id) ^ unit) % sampling_scale < rate
@@ -0,0 +1,93 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+workload_size = Size(50, Unit.MebiByte)
+
+
+def trace_random_read(block_size: Size) -> str:
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    iotrace.start_tracing([disk.system_path])
+    (Fio().create_command()
+     .io_engine(IoEngine.libaio)
+     .size(workload_size)
+     .block_size(block_size)
+     .read_write(ReadWrite.randread)
+     .target(disk.system_path)
+     .direct()
+     .run())
+    iotrace.stop_tracing()
+
+    return iotrace.get_latest_trace_path()
+
+
+def find_distribution(comparison: dict, metric: str, operation: str) -> dict:
+    for distribution in comparison.get('distribution', []):
+        if distribution['metric'] == metric and \
+                distribution['operation'] == operation:
+            return distribution
+
+    TestRun.fail(f"No {operation} {metric} distribution in {comparison}")
+
+
+def test_trace_compare():
+    """
+        title: Test comparing traces
+        description: |
+          Compare traces of random reads of different block sizes and a trace
+          with itself.
+        pass_criteria:
+          - Trace compared with itself has no differences
+          - Difference of IO sizes is flagged as significant
+          - Counts and all percentiles of IO size equal those of workloads
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    before_size = Size(4, Unit.KibiByte)
+    after_size = Size(64, Unit.KibiByte)
+
+    with TestRun.step("Trace workloads of different block sizes"):
+        before = trace_random_read(before_size)
+        after = trace_random_read(after_size)
+
+    with TestRun.step("Compare trace with itself"):
+        comparison = iotrace.run_analytics('compare', before=before,
+                                           after=before)[0]
+        if int(comparison.get('significantDifferences', 0)) != 0:
+            TestRun.fail(f"Identical traces differ: {comparison}")
+
+        size = find_distribution(comparison, "size", "read")
+        if float(size.get('distance', 0)) != 0:
+            TestRun.fail(f"Identical IO sizes differ: {size}")
+
+    with TestRun.step("Compare traces of different block sizes"):
+        comparison = iotrace.run_analytics('compare', before=before,
+                                           after=after)[0]
+        TestRun.LOGGER.info(f"Trace comparison: {comparison}")
+
+        size = find_distribution(comparison, "size", "read")
+        if not size.get('significant', False):
+            TestRun.fail(f"Difference of IO sizes not flagged: {size}")
+
+        counts = (int(size['beforeCount']), int(size['afterCount']))
+        expected = (int(workload_size.get_value() / before_size.get_value()),
+                    int(workload_size.get_value() / after_size.get_value()))
+        if counts != expected:
+            TestRun.fail(f"Expected {expected} reads, got {counts}")
+
+        # Distributions of constant, different sizes do not overlap
+        if float(size['distance']) != 100:
+            TestRun.fail(f"Expected distance of 100%: {size}")
+
+        for percentile in size['percentile']:
+            if int(percentile['before']) != before_size.get_value() or \
+                    int(percentile['after']) != after_size.get_value():
+                TestRun.fail(f"Unexpected IO sizes at percentile: {percentile}")
@@ -0,0 +1,124 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.dd import Dd
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+from api.iotrace_stats_parser import DeviceTraceStatistics
+
+# iotrace uses 512B sector size, even if underlying disk has larger sectors
+iotrace_lba_len = 512
+
+
+def test_trace_markers():
+    """
+        title: Test statistics segmented by user markers
+        description: |
+          Capture a trace of a read phase and a write phase, each started
+          with a marker, and check statistics of the marker intervals.
+        pass_criteria:
+          - Every marker opens an interval, in order of writing
+          - Read phase has only reads and write phase only writes
+          - Intervals account for exactly the IOs of the workload
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    size = Size(100, Unit.MebiByte)
+    block_size = Size(1, Unit.Blocks4096)
+    ios = int(size.get_value() / block_size.get_value())
+    phases = [("phase=read", ReadWrite.randread, 'read'),
+              ("phase=write", ReadWrite.randwrite, 'write')]
+
+    with TestRun.step("Trace workload phases separated by markers"):
+        iotrace.start_tracing([disk.system_path])
+        for marker, read_write, _ in phases:
+            iotrace.add_marker(marker)
+            (Fio().create_command()
+             .io_engine(IoEngine.libaio)
+             .size(size)
+             .block_size(block_size)
+             .read_write(read_write)
+             .target(disk.system_path)
+             .direct()
+             .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Check marker intervals"):
+        statistics = iotrace.run_analytics('marker-statistics',
+                                           path=trace_path)[0]
+        intervals = [interval for interval in statistics.get('interval', [])
+                     if 'marker' in interval]
+        texts = [interval['marker'].get('text') for interval in intervals]
+        if texts != [marker for marker, _, _ in phases]:
+            TestRun.fail(f"Unexpected marker intervals: {texts}")
+
+    with TestRun.step("Check statistics of phases"):
+        for interval, (marker, _, operation) in zip(intervals, phases):
+            devices = interval.get('device', [])
+            if len(devices) != 1:
+                TestRun.fail(f"No IOs of traced device after {marker}")
+
+            device = devices[0]
+            operations = {latency['operation']: int(latency['count'])
+                          for latency in device.get('operation', [])}
+            if operations != {operation: ios}:
+                TestRun.fail(f"Expected {ios} {operation}s after {marker}: "
+                             f"{operations}")
+
+            key = 'readBytes' if operation == 'read' else 'writtenBytes'
+            if int(device.get(key, 0)) != int(size.get_value()):
+                TestRun.fail(f"Unexpected {key} after {marker}: {device}")
+
+
+def test_trace_markers_parsing():
+    """
+        title: Test parsing of a trace with user markers
+        description: |
+          Markers are kept in the trace as events with a header only.
+          Capture a trace of writes interleaved with markers and check the
+          trace parser commands are not affected by them.
+        pass_criteria:
+          - IO events of the trace can be parsed
+          - Every write of the workload is found in the parsed events
+          - Trace statistics account for exactly the writes of the workload
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    write_length = Size(8, disk.block_size)
+    markers = [f"write={i}" for i in range(8)]
+
+    with TestRun.step("Trace writes interleaved with markers"):
+        iotrace.start_tracing([disk.system_path])
+        for i, marker in enumerate(markers):
+            iotrace.add_marker(marker)
+            (Dd().input("/dev/urandom").output(disk.system_path).count(1)
+             .block_size(write_length).oflag('direct,sync').seek(i)
+             .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Check parsed IO events"):
+        events = iotrace.get_trace_events(trace_path)
+        writes = {int(event['io'].get('lba', 0))
+                  for event in events
+                  if 'io' in event
+                  and event['io'].get('operation') == 'Write'
+                  and int(event['io']['len']) ==
+                  int(write_length.get_value() / iotrace_lba_len)}
+        for i in range(len(markers)):
+            lba = int(i * write_length.get_value() / iotrace_lba_len)
+            if lba not in writes:
+                TestRun.fail(f"Could not find write at LBA {lba}")
+
+    with TestRun.step("Check trace statistics"):
+        statistics = DeviceTraceStatistics(
+            iotrace.get_trace_statistics(trace_path,
+                                         dev_path=disk.system_path))
+        if statistics.write.count != len(markers):
+            TestRun.fail(f"Unexpected write count: {statistics.write.count}")
@@ -0,0 +1,95 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+io_size = Size(1, Unit.Blocks4096)
+workload_size = Size(20, Unit.MebiByte)
+
+
+def trace_random_io(label: str) -> str:
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    iotrace.start_tracing([disk.system_path], label=label)
+    (Fio().create_command()
+     .io_engine(IoEngine.libaio)
+     .size(workload_size)
+     .block_size(io_size)
+     .read_write(ReadWrite.randrw)
+     .target(disk.system_path)
+     .direct()
+     .run())
+    iotrace.stop_tracing()
+
+    return iotrace.get_latest_trace_path()
+
+
+def test_trace_merge():
+    """
+        title: Test merging traces
+        description: |
+          Merge two traces, as if they were captured on different hosts,
+          with given and with estimated clock offsets.
+        pass_criteria:
+          - Merged trace contains all events of both traces
+          - Given clock offsets are applied to events of their traces
+          - Events of the merged trace are ordered by aligned timestamps
+          - All IOs of both traces are matched with their completions
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    ios = int(workload_size.get_value() / io_size.get_value())
+
+    with TestRun.step("Trace two workloads"):
+        paths = [trace_random_io(f"merge_{i}") for i in range(2)]
+        timestamps = [[int(event['header'].get('timestamp', 0))
+                       for event in iotrace.get_trace_events(path, raw=True)]
+                      for path in paths]
+
+    with TestRun.step("Merge with estimated clock offsets"):
+        output = "merged/estimated"
+        summary = iotrace.run_analytics('merge', paths=paths, output=output)[0]
+        TestRun.LOGGER.info(f"Merge summary: {summary}")
+
+        got = [int(t.get('events', 0)) for t in summary['trace']]
+        expected = [len(trace) for trace in timestamps]
+        if got != expected or int(summary['events']) != sum(expected):
+            TestRun.fail(f"Expected {expected} merged events: {summary}")
+
+    with TestRun.step("Merge with given clock offsets"):
+        output = "merged/given"
+        offsets = [0, -1000000]
+        summary = iotrace.run_analytics('merge', paths=paths, output=output,
+                                        offsets=offsets)[0]
+        got = [int(t.get('offset', 0)) for t in summary['trace']]
+        if got != offsets:
+            TestRun.fail(f"Clock offsets {got} differ from given {offsets}")
+
+    with TestRun.step("Check order of merged events"):
+        # Timestamps are shifted so that none of them becomes negative
+        shifts = [offset - min(offsets) for offset in offsets]
+        expected = sorted(timestamp + shift
+                          for trace, shift in zip(timestamps, shifts)
+                          for timestamp in trace)
+        merged = [int(event['header'].get('timestamp', 0))
+                  for event in iotrace.get_trace_events(output, raw=True)]
+        if merged != expected:
+            TestRun.fail("Merged events are not the shifted events of both "
+                         "traces in order of their timestamps")
+
+    with TestRun.step("Analyze merged trace"):
+        trace_summary = iotrace.get_trace_summary(output)
+        if trace_summary['state'] != "COMPLETE":
+            TestRun.fail(f"Merged trace is not complete: {trace_summary}")
+
+        matching = iotrace.run_analytics('match-io', path=output)[0]
+        if int(matching.get('matched', 0)) != 2 * ios:
+            TestRun.fail(f"Expected {2 * ios} matched IOs in merged trace: {matching}")
+        if int(matching.get('replaced', 0)) != 0:
+            TestRun.fail(f"IO ids of merged traces collide: {matching}")
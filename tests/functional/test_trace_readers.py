@@ -0,0 +1,74 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+def test_mapped_trace_reader():
+    """
+        title: Test memory mapped trace reader
+        description: |
+          Read the same trace with buffered and memory mapped readers and
+          compare their results and throughput.
+        pass_criteria:
+          - Both readers read an IO event for each IO issued by fio
+          - IO matching gives the same summary with both readers
+          - Throughput of both readers is reported
+          - Memory mapped reader does not allocate a message per event
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    io_size = Size(100, Unit.MebiByte)
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(io_size)
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Benchmark trace readers"):
+        summary = iotrace.run_analytics('benchmark-readers', path=trace_path,
+                                        iterations=2)[0]
+        readers = {reader['reader']: reader for reader in summary['reader']}
+        TestRun.LOGGER.info(f"Reader benchmark: {summary}")
+
+    with TestRun.step("Compare readers"):
+        if readers['buffered']['events'] != readers['mmap']['events']:
+            TestRun.fail(f"Readers read different number of events: {summary}")
+
+        ios = int(io_size.get_value(Unit.Blocks4096))
+        for reader in readers.values():
+            if int(reader.get('ioEvents', 0)) != ios:
+                TestRun.fail(f"{reader['reader']} reader read {reader.get('ioEvents', 0)} "
+                             f"IO events, fio issued {ios} IOs")
+
+        for reader in readers.values():
+            if float(reader.get('eventsPerSecond', 0)) <= 0:
+                TestRun.fail(f"Throughput of {reader['reader']} reader not reported")
+
+        if int(readers['mmap'].get('messageAllocations', 0)) * 100 > \
+                int(readers['mmap']['events']):
+            TestRun.fail(f"Memory mapped reader allocates messages per event: {summary}")
+
+    with TestRun.step("Match IO with both readers"):
+        buffered = iotrace.run_analytics('match-io', path=trace_path)[0]
+        mapped = iotrace.run_analytics('match-io', path=trace_path, mmap=True)[0]
+        buffered.pop('memoryUsage', None)
+        mapped.pop('memoryUsage', None)
+
+        if buffered != mapped:
+            TestRun.fail(f"IO matching differs, buffered {buffered}, mmap {mapped}")
@@ -0,0 +1,71 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+io_size = Size(1, Unit.Blocks4096)
+workload_size = Size(100, Unit.MebiByte)
+
+
+def test_trace_replay():
+    """
+        title: Test trace replay
+        description: |
+          Capture a trace of a mixed workload and replay it on the traced
+          disk, as fast as possible and with original timing.
+        pass_criteria:
+          - Exactly reads of the trace are replayed without errors, writes
+            are skipped
+          - Achieved latencies are reported for all replayed reads
+          - Replay with original timing takes as long as the trace
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    ios = int(workload_size.get_value() / io_size.get_value())
+
+    with TestRun.step("Trace workload"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(workload_size)
+         .block_size(io_size)
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+        trace_path = iotrace.get_latest_trace_path()
+        reads = sum(1 for event in iotrace.get_trace_events(trace_path)
+                    if 'io' in event and event['io']['operation'] == 'Read')
+
+    for speed in [0, 100]:
+        with TestRun.step(f"Replay trace at speed {speed}"):
+            summary = iotrace.run_analytics('replay', path=trace_path,
+                                            target=disk.system_path,
+                                            speed=speed, queue_depth=16)[0]
+            got = (int(summary.get('ios', 0)),
+                   int(summary.get('replayedIos', 0)),
+                   int(summary.get('skippedIos', 0)))
+            if got != (ios, reads, ios - reads):
+                TestRun.fail(f"Expected {reads} of {ios} IOs replayed: {summary}")
+            if int(summary.get('errors', 0)):
+                TestRun.fail(f"Replayed IOs failed: {summary}")
+
+            recorded = {latency['operation']: int(latency['count'])
+                        for latency in summary.get('recordedLatency', [])}
+            achieved = {latency['operation']: int(latency['count'])
+                        for latency in summary.get('achievedLatency', [])}
+            if recorded != {'read': reads} or achieved != {'read': reads}:
+                TestRun.fail(f"Expected latencies of {reads} reads: "
+                             f"{recorded} {achieved}")
+
+            if speed:
+                duration = int(summary.get('recordedDuration', 0))
+                if int(summary.get('replayDuration', 0)) < duration:
+                    TestRun.fail(f"Replay faster than original: {summary}")
@@ -0,0 +1,85 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+import math
+from datetime import timedelta
+
+from utils.iotrace import IotracePlugin
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+
+segment_time = timedelta(seconds=5)
+runtime = timedelta(seconds=17)
+
+
+def test_trace_segments():
+    """
+        title: Test trace segment rotation
+        description: |
+            Trace random IO with time based segment rotation and analyze
+            the range of sealed segments together.
+        pass_criteria:
+            - Each segment is a complete trace not longer than segment time
+            - Segments are labeled with consecutive numbers
+            - Latency samples of the segment range equal sum of all segments
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    label = "segments"
+
+    with TestRun.step("Trace random IO with segment rotation"):
+        iotrace.start_tracing([disk.system_path], label=label,
+                              segment_time=segment_time)
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(100, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .time_based()
+         .run_time(runtime)
+         .run())
+        iotrace.stop_tracing()
+
+    with TestRun.step("Check sealed segments"):
+        summaries = [iotrace.get_trace_summary(trace['tracePath'])
+                     for trace in iotrace.get_traces_list()]
+        segments = [s for s in summaries if s.get('label', '').startswith(label + '#')]
+        segments.sort(key=lambda s: int(s['label'].split('#')[1]))
+
+        expected_segments = math.ceil(runtime / segment_time)
+        if len(segments) < expected_segments:
+            TestRun.fail(f"Expected at least {expected_segments} segments, "
+                         f"found {len(segments)}")
+
+        for number, summary in enumerate(segments):
+            if summary['label'] != f"{label}#{number}":
+                TestRun.fail(f"Unexpected segment label {summary['label']}")
+            if summary['state'] != "COMPLETE":
+                TestRun.fail(f"Segment {summary['tracePath']} is not complete")
+            if int(summary['traceDuration']) > segment_time.total_seconds() + 1:
+                TestRun.fail(f"Segment {summary['tracePath']} exceeds segment time")
+
+    with TestRun.step("Analyze range of segments"):
+        paths = [s['tracePath'] for s in segments]
+        total = iotrace.run_analytics('latency-percentiles', path=paths[0],
+                                      segments=paths[1:])[0]
+
+        expected = 0
+        for path in paths:
+            stats = iotrace.run_analytics('latency-percentiles', path=path)[0]
+            for device in stats.get('device', []):
+                for op in device['operation']:
+                    if op['operation'] == 'total':
+                        expected += int(op.get('count', 0))
+
+        count = sum(int(op.get('count', 0))
+                    for device in total.get('device', [])
+                    for op in device['operation'] if op['operation'] == 'total')
+        if count != expected:
+            TestRun.fail(f"{count} samples in segment range, segments contain {expected}")
@@ -0,0 +1,65 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+from utils.iotrace import IotracePlugin
+
+
+def test_working_set():
+    """
+        title: Test working set estimation
+        description: |
+          Trace sequential writes of a known range of the disk and compare
+          estimated working set and footprint with the range size.
+        pass_criteria:
+          - Device footprint is within 5% of the written range
+          - Peak working set of the longest window equals the footprint
+          - Nothing is reported as read
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+    range_mib = 256
+
+    with TestRun.step("Trace sequential writes"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(range_mib, Unit.MebiByte))
+         .block_size(Size(64, Unit.KibiByte))
+         .read_write(ReadWrite.write)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Estimate working set"):
+        summary = iotrace.run_analytics('working-set', path=trace_path,
+                                        windows=['1s', '1h'])[0]
+
+    with TestRun.step("Check estimates"):
+        footprint = summary['footprint'][0]['size']
+        total = float(footprint['total'])
+        if abs(total - range_mib) > range_mib * 0.05:
+            TestRun.fail(f"Estimated footprint {total} MiB, written {range_mib} MiB")
+
+        if float(footprint.get('read', 0)) != 0:
+            TestRun.fail("Reads reported for write only workload")
+
+        if float(footprint.get('write', 0)) != total:
+            TestRun.fail(f"Written footprint {footprint.get('write', 0)} MiB "
+                         f"differs from total {total} MiB")
+
+        hour = summary['window'][1]
+        if hour['window'] != '1h':
+            TestRun.fail("Windows reported in unexpected order")
+
+        peak = float(hour['device'][0]['peak']['total'])
+        if abs(peak - total) > total * 0.01:
+            TestRun.fail(f"Peak hourly working set {peak} MiB differs from footprint")
@@ -0,0 +1,134 @@
+#
+# Copyright(c) 2020 Intel Corporation
+# SPDX-License-Identifier: BSD-3-Clause-Clear
+#
+
+import math
+
+from utils.iotrace import IotracePlugin
+from core.test_run import TestRun
+from test_tools.fio.fio import Fio
+from test_tools.fio.fio_param import ReadWrite, IoEngine
+from test_utils.size import Size, Unit
+
+precision = 3
+
+
+def test_latency_percentiles():
+    """
+        title: Test latency percentiles
+        description: |
+            Trace random reads and writes and check latency percentiles
+            reported by iotracer.
+        pass_criteria:
+            - Read and write samples count equals the number of parsed IOs
+            - Total samples count equals the sum of all operations
+            - Min and max equal the extremes of parsed latencies
+            - Percentiles are within histogram precision of the exact ones
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(100, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Get latency percentiles"):
+        stats = iotrace.run_analytics('latency-percentiles', path=trace_path,
+                                      precision=precision)[0]
+        device = stats['device'][0]
+        operations = {op['operation']: op for op in device['operation']}
+
+    with TestRun.step("Compare samples count with parsed events"):
+        events = iotrace.get_trace_events(trace_path)
+        ios = [event['io'] for event in events if 'io' in event and 'len' in event['io']]
+
+        for name in ['read', 'write']:
+            expected = len([io for io in ios if io.get('operation', 'Read') == name.capitalize()])
+            count = int(operations[name].get('count', 0))
+            if count != expected:
+                TestRun.fail(f"{count} {name} latency samples, trace contains {expected}")
+
+        total = sum(int(operations[name].get('count', 0))
+                    for name in ['read', 'write', 'discard', 'flush'])
+        if int(operations['total']['count']) != total:
+            TestRun.fail("Total samples count differs from sum of operations")
+
+    with TestRun.step("Compare percentiles with parsed latencies"):
+        for name in ['read', 'write']:
+            latencies = sorted(int(io.get('latency', 0)) for io in ios
+                               if io.get('operation', 'Read') == name.capitalize())
+            op = operations[name]
+
+            if int(op.get('min', 0)) != latencies[0] or int(op['max']) != latencies[-1]:
+                TestRun.fail(f"Latency of {name} ranges from {op.get('min', 0)} to "
+                             f"{op['max']}, parsed from {latencies[0]} to {latencies[-1]}")
+
+            for p in op['percentile']:
+                rank = max(math.ceil(float(p['percentile']) / 100 * len(latencies)), 1)
+                exact = latencies[rank - 1]
+                reported = int(p.get('latency', 0))
+                if not exact <= reported <= exact * (1 + 10 ** -precision) + 1:
+                    TestRun.fail(f"{p['percentile']} percentile of {name} is {reported}, "
+                                 f"exact one {exact}")
+
+
+def test_latency_percentiles_cache():
+    """
+        title: Test cached latency percentiles
+        description: |
+            Get latency percentiles of the same trace repeatedly and check
+            that statistics are answered from cache after the first pass.
+        pass_criteria:
+            - The first pass parses the trace and stores statistics next to it
+            - The second pass is answered from cache with identical results
+            - Cache is bypassed on request
+    """
+    iotrace: IotracePlugin = TestRun.plugins['iotrace']
+    disk = TestRun.dut.disks[0]
+
+    with TestRun.step("Trace random IO"):
+        iotrace.start_tracing([disk.system_path])
+        (Fio().create_command()
+         .io_engine(IoEngine.libaio)
+         .size(Size(100, Unit.MebiByte))
+         .block_size(Size(1, Unit.Blocks4096))
+         .read_write(ReadWrite.randrw)
+         .target(disk.system_path)
+         .direct()
+         .run())
+        iotrace.stop_tracing()
+
+    trace_path = iotrace.get_latest_trace_path()
+
+    with TestRun.step("Get latency percentiles twice"):
+        first = iotrace.run_analytics('latency-percentiles', path=trace_path,
+                                      precision=2)[0]
+        second = iotrace.run_analytics('latency-percentiles', path=trace_path,
+                                       precision=2)[0]
+        uncached = iotrace.run_analytics('latency-percentiles', path=trace_path,
+                                         precision=2, no_cache=True)[0]
+
+    with TestRun.step("Check cache usage"):
+        if int(first.get('cachedSegments', 0)) != 0:
+            TestRun.fail("Statistics of new trace answered from cache")
+        cache_path = (f"{iotrace.get_trace_repository_path()}/{trace_path}/"
+                      f"iotrace-statistics.cache")
+        if TestRun.executor.run(f"test -f {cache_path}").exit_code != 0:
+            TestRun.fail(f"Statistics cache {cache_path} not stored")
+        if int(second.get('cachedSegments', 0)) != 1:
+            TestRun.fail("Statistics not answered from cache")
+        if int(uncached.get('cachedSegments', 0)) != 0:
+            TestRun.fail("Cache not bypassed")
+        if first['device'] != second['device'] or first['device'] != uncached['device']:
+            TestRun.fail("Cached statistics differ from parsed ones")
@@ -93,6 +93,11 @@ class IotracePlugin:
                       trace_file_size: Size = None,
                       timeout: timedelta = None,
                       label: str = None,
+                      segment_time: timedelta = None,
+                      segment_size: Size = None,
+                      segment_list: str = None,
+                      rollup_interval: timedelta = None,
+                      analyzers: list = None,
                       shortcut: bool = False):
         """
         Start tracing given block devices. Trace all available if none given.
@@ -103,12 +108,22 @@ class IotracePlugin:
         :param trace_file_size: Max size of trace file in MiB
         :param timeout: Max trace duration time in seconds
         :param label: User defined custom label
+        :param segment_time: Rotate trace into a new segment after given time
+        :param segment_size: Rotate trace into a new segment after given size
+        :param segment_list: File to which paths of sealed segments are appended
+        :param rollup_interval: Interval of time series written next to trace
+        :param analyzers: Analyzers run during capture
         :param shortcut: Use shorter command
         :type bdevs: list of strings
         :type buffer: Size
         :type trace_file_size: Size
         :type timeout: timedelta
         :type label: str
+        :type segment_time: timedelta
+        :type segment_size: Size
+        :type segment_list: str
+        :type rollup_interval: timedelta
+        :type analyzers: list of strings
         :type shortcut: bool
         """
 
@@ -143,7 +158,29 @@ class IotracePlugin:
             command += f'{int(timeout.total_seconds())}'
 
         if label is not None:
-            command += ' -l ' if shortcut else ' --label ' + f'{label}'
+            command += (' -l ' if shortcut else ' --label ') + f'{label}'
+
+        if segment_time is not None:
+            if not int(segment_time.total_seconds()) in timeout_range:
+                raise CmdException(f"Given segment time is out of range {timeout_range}.")
+            command += ' -g ' if shortcut else ' --segment-time '
+            command += f'{int(segment_time.total_seconds())}'
+
+        if segment_size is not None:
+            if not int(segment_size.get_value(Unit.MebiByte)) in trace_file_size_range:
+                raise CmdException(f"Given segment size is out of range {trace_file_size_range}.")
+            command += ' -z ' if shortcut else ' --segment-size '
+            command += f'{int(segment_size.get_value(Unit.MebiByte))}'
+
+        if segment_list is not None:
+            command += (' -f ' if shortcut else ' --segment-list ') + f'{segment_list}'
+
+        if rollup_interval is not None:
+            command += ' -r ' if shortcut else ' --rollup-interval '
+            command += f'{int(rollup_interval.total_seconds() * 1000)}'
+
+        if analyzers:
+            command += (' -a ' if shortcut else ' --analyzers ') + ','.join(analyzers)
 
         self.pid = str(TestRun.executor.run_in_background(command))
         TestRun.LOGGER.info("Started tracing of: " + ','.join(bdevs))
@@ -474,6 +511,49 @@ class IotracePlugin:
         raise CmdException(f"No trace stats for device {dev_path}", output)
 
 
+    @staticmethod
+    def run_analytics(action: str, **params) -> list:
+        """
+        Run trace analytics command
+
+        :param action: long key of the command, e.g. 'export-columnar'
+        :param params: command parameters named by their long keys with dashes
+                       replaced by underscores; lists are passed comma-separated,
+                       True passes a switch, None and False are skipped
+        :type action: str
+        :return: JSON messages printed by the command
+        :raises Exception: if iotrace command fails
+        """
+        command = f'iotrace --trace-analytics --{action}'
+
+        for key, value in params.items():
+            if value is None or value is False:
+                continue
+            command += f" --{key.replace('_', '-')}"
+            if value is True:
+                continue
+            if isinstance(value, (list, tuple)):
+                value = ','.join(str(item) for item in value)
+            command += f' {value}'
+
+        output = TestRun.executor.run(command)
+        if output.exit_code != 0 or output.stdout == "":
+            raise CmdException(f"iotrace --{action} failed", output)
+
+        return parse_json(output.stdout)
+
+    @staticmethod
+    def add_marker(text: str):
+        """
+        Inject user marker into the running trace
+
+        :param text: marker text
+        :type text: str
+        :raises Exception: if marker cannot be written
+        """
+        TestRun.executor.run_expect_success(
+            f'echo "{text}" > /proc/iotrace/marker')
+
     @staticmethod
     def remove_traces(prefix: str, force: bool = False, shortcut: bool = False):
         """